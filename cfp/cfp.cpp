@@ -27,6 +27,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array1f_set_cache_size,
     cfp_array1f_clear_cache,
     cfp_array1f_flush_cache,
+    cfp_array1f_cache_stats,
+    cfp_array1f_reset_cache_stats,
     cfp_array1f_size_bytes,
     cfp_array1f_compressed_size,
     cfp_array1f_compressed_data,
@@ -130,6 +132,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array1d_set_cache_size,
     cfp_array1d_clear_cache,
     cfp_array1d_flush_cache,
+    cfp_array1d_cache_stats,
+    cfp_array1d_reset_cache_stats,
     cfp_array1d_size_bytes,
     cfp_array1d_compressed_size,
     cfp_array1d_compressed_data,
@@ -233,6 +237,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array2f_set_cache_size,
     cfp_array2f_clear_cache,
     cfp_array2f_flush_cache,
+    cfp_array2f_cache_stats,
+    cfp_array2f_reset_cache_stats,
     cfp_array2f_size_bytes,
     cfp_array2f_compressed_size,
     cfp_array2f_compressed_data,
@@ -339,6 +345,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array2d_set_cache_size,
     cfp_array2d_clear_cache,
     cfp_array2d_flush_cache,
+    cfp_array2d_cache_stats,
+    cfp_array2d_reset_cache_stats,
     cfp_array2d_size_bytes,
     cfp_array2d_compressed_size,
     cfp_array2d_compressed_data,
@@ -445,6 +453,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array3f_set_cache_size,
     cfp_array3f_clear_cache,
     cfp_array3f_flush_cache,
+    cfp_array3f_cache_stats,
+    cfp_array3f_reset_cache_stats,
     cfp_array3f_size_bytes,
     cfp_array3f_compressed_size,
     cfp_array3f_compressed_data,
@@ -553,6 +563,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array3d_set_cache_size,
     cfp_array3d_clear_cache,
     cfp_array3d_flush_cache,
+    cfp_array3d_cache_stats,
+    cfp_array3d_reset_cache_stats,
     cfp_array3d_size_bytes,
     cfp_array3d_compressed_size,
     cfp_array3d_compressed_data,
@@ -661,6 +673,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array4f_set_cache_size,
     cfp_array4f_clear_cache,
     cfp_array4f_flush_cache,
+    cfp_array4f_cache_stats,
+    cfp_array4f_reset_cache_stats,
     cfp_array4f_size_bytes,
     cfp_array4f_compressed_size,
     cfp_array4f_compressed_data,
@@ -771,6 +785,8 @@ const cfp_api CFP_NAMESPACE = {
     cfp_array4d_set_cache_size,
     cfp_array4d_clear_cache,
     cfp_array4d_flush_cache,
+    cfp_array4d_cache_stats,
+    cfp_array4d_reset_cache_stats,
     cfp_array4d_size_bytes,
     cfp_array4d_compressed_size,
     cfp_array4d_compressed_data,
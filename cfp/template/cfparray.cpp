@@ -97,6 +97,25 @@ _t1(CFP_ARRAY_TYPE, flush_cache)(CFP_ARRAY_TYPE self)
   static_cast<const ZFP_ARRAY_TYPE*>(self.object)->flush_cache();
 }
 
+static cfp_cache_stats
+_t1(CFP_ARRAY_TYPE, cache_stats)(CFP_ARRAY_TYPE self)
+{
+  zfp::cache_statistics s = static_cast<const ZFP_ARRAY_TYPE*>(self.object)->cache_stats();
+  cfp_cache_stats stats;
+  stats.hits = s.hits;
+  stats.misses = s.misses;
+  stats.writebacks = s.writebacks;
+  stats.decode_time = s.decode_time;
+  stats.encode_time = s.encode_time;
+  return stats;
+}
+
+static void
+_t1(CFP_ARRAY_TYPE, reset_cache_stats)(CFP_ARRAY_TYPE self)
+{
+  static_cast<const ZFP_ARRAY_TYPE*>(self.object)->reset_cache_stats();
+}
+
 static void
 _t1(CFP_ARRAY_TYPE, get_array)(CFP_ARRAY_TYPE self, ZFP_SCALAR_TYPE * p)
 {
@@ -0,0 +1,232 @@
+// measure the latency of cache hits and the miss rates of cache replacement
+// policies in zfp's compressed-array classes
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "zfp/array3.hpp"
+#include "zfp/constarray3.hpp"
+#include "zfp/internal/array/cache.hpp"
+
+// cache line holding one 3D block of doubles
+struct Line {
+  double a[4 * 4 * 4];
+};
+
+// block access in a trace
+struct Access {
+  Access(size_t block, bool write) : block(block), write(write) {}
+  size_t block;
+  bool write;
+};
+
+// time in nanoseconds per cache hit using cache line indices of given type
+template <typename Index>
+static double
+hit_time(uint lines, size_t accesses, double& sum)
+{
+  zfp::internal::Cache<Line, Index> cache(lines);
+  Line* ptr = 0;
+  // populate cache with lines 1, ..., lines, which map to distinct slots
+  for (uint i = 1; i <= lines; i++) {
+    cache.access(ptr, Index(i), true);
+    for (uint j = 0; j < 4 * 4 * 4; j++)
+      ptr->a[j] = i + j;
+  }
+  // access cached lines in sequence
+  clock_t c = clock();
+  for (size_t n = 0; n < accesses; n++) {
+    cache.access(ptr, Index(1 + (n & (lines - 1))), false);
+    sum += ptr->a[n & 63u];
+  }
+  double time = double(clock() - c) / CLOCKS_PER_SEC;
+  return 1e9 * time / accesses;
+}
+
+// time in nanoseconds per element of iterator scan over const array with
+// given number of blocks decoded ahead of each cache miss
+static double
+scan_time(const zfp::const_array3d& a, uint prefetch, double& sum)
+{
+  a.clear_cache();
+  const_cast<zfp::const_array3d&>(a).set_cache_prefetch(prefetch);
+  // measure wall time, as blocks may be decoded by multiple threads
+  double time = zfp::internal::CacheStats::now();
+  for (zfp::const_array3d::const_iterator p = a.begin(); p != a.end(); p++)
+    sum += *p;
+  time = zfp::internal::CacheStats::now() - time;
+  return 1e9 * time / a.size();
+}
+
+// replay block trace through cache with given policy and report misses
+template <class Policy>
+static void
+replay(const char* name, const char* policy, const std::vector<Access>& trace, uint lines, double& sum)
+{
+  zfp::internal::Cache<Line, size_t, Policy> cache(lines);
+  size_t misses = 0;
+  size_t writebacks = 0;
+  clock_t c = clock();
+  for (size_t n = 0; n < trace.size(); n++) {
+    Line* ptr = 0;
+    size_t x = trace[n].block + 1;
+    typename zfp::internal::Cache<Line, size_t, Policy>::Tag tag = cache.access(ptr, x, trace[n].write);
+    if (tag.index() != x) {
+      // emulate write-back and fetch
+      misses++;
+      if (tag.dirty())
+        writebacks++;
+      ptr->a[0] = double(x);
+    }
+    sum += ptr->a[0];
+  }
+  double time = double(clock() - c) / CLOCKS_PER_SEC;
+  printf("%s %-8s lines=%u misses=%lu (%.2f%%) write-backs=%lu %.3f ns\n", name, policy, lines, (unsigned long)misses, 100.0 * misses / trace.size(), (unsigned long)writebacks, 1e9 * time / trace.size());
+}
+
+// replay block trace using several replacement policies
+static void
+replay_all(const char* name, const std::vector<Access>& trace, uint lines, double& sum)
+{
+  replay<zfp::cache_policy::direct>(name, "direct", trace, lines, sum);
+  replay<zfp::cache_policy::lru<2> >(name, "lru<2>", trace, lines, sum);
+  replay<zfp::cache_policy::lru<4> >(name, "lru<4>", trace, lines, sum);
+  replay<zfp::cache_policy::lru<8> >(name, "lru<8>", trace, lines, sum);
+  replay<zfp::cache_policy::clock<4> >(name, "clock<4>", trace, lines, sum);
+  replay<zfp::cache_policy::clock<8> >(name, "clock<8>", trace, lines, sum);
+}
+
+// read trace of block indices, each optionally followed by 'w' for writes
+static bool
+read_trace(std::vector<Access>& trace, const char* path)
+{
+  FILE* file = fopen(path, "r");
+  if (!file)
+    return false;
+  unsigned long block;
+  char mode[2];
+  while (fscanf(file, "%lu", &block) == 1) {
+    bool write = (fscanf(file, " %1[rw]", mode) == 1 && mode[0] == 'w');
+    trace.push_back(Access(block, write));
+  }
+  fclose(file);
+  return true;
+}
+
+// generate trace of 7-point stencil sweep over nx * ny * nz blocks that
+// reads block neighbors and writes the center block
+static void
+stencil_trace(std::vector<Access>& trace, size_t nx, size_t ny, size_t nz)
+{
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++) {
+        size_t b = i + nx * (j + ny * k);
+        if (k > 0)      trace.push_back(Access(b - nx * ny, false));
+        if (j > 0)      trace.push_back(Access(b - nx, false));
+        if (i > 0)      trace.push_back(Access(b - 1, false));
+        if (i < nx - 1) trace.push_back(Access(b + 1, false));
+        if (j < ny - 1) trace.push_back(Access(b + nx, false));
+        if (k < nz - 1) trace.push_back(Access(b + nx * ny, false));
+        trace.push_back(Access(b, true));
+      }
+}
+
+// generate trace of element-wise sweep over nx * ny * nz blocks with the
+// slowest varying array dimension traversed fastest
+static void
+transpose_trace(std::vector<Access>& trace, size_t nx, size_t ny, size_t nz)
+{
+  for (size_t x = 0; x < 4 * nx; x++)
+    for (size_t y = 0; y < 4 * ny; y++)
+      for (size_t z = 0; z < 4 * nz; z++)
+        trace.push_back(Access(x / 4 + nx * (y / 4 + ny * (z / 4)), false));
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned long accesses = 0x10000000ul;
+  uint lines = 0x400;
+  const char* path = 0;
+  const size_t n = 64;
+  double sum = 0;
+
+  switch (argc) {
+    case 4:
+      path = argv[3];
+      fallthrough_
+    case 3:
+      sscanf(argv[2], "%u", &lines);
+      fallthrough_
+    case 2:
+      sscanf(argv[1], "%lu", &accesses);
+      break;
+  }
+
+  // round number of cache lines up to a power of two
+  uint m;
+  for (m = 1; m < lines; m *= 2);
+  lines = m;
+
+  // hits in cache with 32- and 64-bit line indices
+  printf("hit lines=%u index=32 bits %.3f ns\n", lines, hit_time<uint32>(lines, accesses, sum));
+  printf("hit lines=%u index=64 bits %.3f ns\n", lines, hit_time<uint64>(lines, accesses, sum));
+
+  // hits in compressed array whose cache holds all blocks
+  zfp::array3d a(n, n, n, 16.0, 0, n * n * n * sizeof(double));
+  for (size_t k = 0; k < n; k++)
+    for (size_t j = 0; j < n; j++)
+      for (size_t i = 0; i < n; i++)
+        a(i, j, k) = double(i + j + k);
+  size_t passes = accesses / (n * n * n) + 1;
+  clock_t c = clock();
+  for (size_t p = 0; p < passes; p++)
+    for (size_t k = 0; k < n; k++)
+      for (size_t j = 0; j < n; j++)
+        for (size_t i = 0; i < n; i++)
+          sum += a(i, j, k);
+  double time = double(clock() - c) / CLOCKS_PER_SEC;
+  printf("hit array3d %.3f ns\n", 1e9 * time / (passes * n * n * n));
+
+  // hits in same array accessed one tile at a time
+  c = clock();
+  for (size_t p = 0; p < passes; p++)
+    for (size_t b = 0; b < a.blocks(); b++) {
+      zfp::array3d::const_tile t(&a, b);
+      const double* q = t.data();
+      for (uint i = 0; i < 4 * 4 * 4; i++)
+        sum += q[i];
+    }
+  time = double(clock() - c) / CLOCKS_PER_SEC;
+  printf("hit array3d tile %.3f ns\n", 1e9 * time / (passes * n * n * n));
+
+  // streaming scans with and without decode-ahead
+  zfp::const_array3d b(n, n, n, zfp_config_accuracy(1e-6));
+  std::vector<double> data(n * n * n);
+  for (size_t i = 0; i < n * n * n; i++)
+    data[i] = double(i % n) * double(i / (n * n));
+  b.set(&data[0]);
+  for (uint prefetch = 0; prefetch <= 32; prefetch = prefetch ? 2 * prefetch : 1)
+    printf("scan const_array3d prefetch=%u %.3f ns\n", prefetch, scan_time(b, prefetch, sum));
+
+  // misses for recorded trace or synthetic traces
+  std::vector<Access> trace;
+  if (path) {
+    if (!read_trace(trace, path)) {
+      fprintf(stderr, "cannot read trace %s\n", path);
+      return EXIT_FAILURE;
+    }
+    replay_all("trace", trace, lines, sum);
+  }
+  else {
+    stencil_trace(trace, 20, 20, 20);
+    replay_all("stencil", trace, lines, sum);
+    trace.clear();
+    transpose_trace(trace, 16, 16, 16);
+    replay_all("transpose", trace, lines, sum);
+  }
+
+  // prevent optimizing away accesses
+  return sum == 0 ? 1 : 0;
+}
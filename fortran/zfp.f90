@@ -45,7 +45,8 @@ module zfp
   enum, bind(c)
     enumerator :: zFORp_exec_serial = 0, &
                   zFORp_exec_omp = 1, &
-                  zFORp_exec_cuda = 2
+                  zFORp_exec_cuda = 2, &
+                  zFORp_exec_threads = 3
   end enum
 
   ! constants are hardcoded
@@ -546,7 +547,8 @@ module zfp
 
   public :: zFORp_exec_serial, &
             zFORp_exec_omp, &
-            zFORp_exec_cuda
+            zFORp_exec_cuda, &
+            zFORp_exec_threads
 
   ! C macros -> constants
   public :: zFORp_version_major, &
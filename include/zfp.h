@@ -21,11 +21,12 @@
 #define ZFP_MIN_EXP  -1074 /* minimum floating-point base-2 exponent */
 
 /* header masks (enable via bitwise or; reader must use same mask) */
-#define ZFP_HEADER_NONE   0x0u /* no header */
-#define ZFP_HEADER_MAGIC  0x1u /* embed 64-bit magic */
-#define ZFP_HEADER_META   0x2u /* embed 52-bit field metadata */
-#define ZFP_HEADER_MODE   0x4u /* embed 12- or 64-bit compression mode */
-#define ZFP_HEADER_FULL   0x7u /* embed all of the above */
+#define ZFP_HEADER_NONE     0x0u /* no header */
+#define ZFP_HEADER_MAGIC    0x1u /* embed 64-bit magic */
+#define ZFP_HEADER_META     0x2u /* embed 52-bit field metadata */
+#define ZFP_HEADER_MODE     0x4u /* embed 12- or 64-bit compression mode */
+#define ZFP_HEADER_FULL     0x7u /* embed all of the above */
+#define ZFP_HEADER_EXTENDED 0x8u /* extend metadata to 64-bit sizes; add checksum */
 
 /* bit masks for specifying storage class */
 #define ZFP_DATA_UNUSED  0x01u /* allocated but unused storage */
@@ -42,11 +43,14 @@
 #define ZFP_META_NULL (UINT64C(-1))
 
 /* number of bits per header entry */
-#define ZFP_MAGIC_BITS       32 /* number of magic word bits */
-#define ZFP_META_BITS        52 /* number of field metadata bits */
-#define ZFP_MODE_SHORT_BITS  12 /* number of mode bits in short format */
-#define ZFP_MODE_LONG_BITS   64 /* number of mode bits in long format */
-#define ZFP_HEADER_MAX_BITS 148 /* max number of header bits */
+#define ZFP_MAGIC_BITS           32 /* number of magic word bits */
+#define ZFP_META_BITS            52 /* number of field metadata bits */
+#define ZFP_META_EXT_BITS         8 /* number of extended metadata bits (sans sizes) */
+#define ZFP_CHECKSUM_BITS        32 /* number of extended header checksum bits */
+#define ZFP_MODE_SHORT_BITS      12 /* number of mode bits in short format */
+#define ZFP_MODE_LONG_BITS       64 /* number of mode bits in long format */
+#define ZFP_HEADER_MAX_BITS     148 /* max number of short header bits */
+#define ZFP_HEADER_EXT_MAX_BITS 832 /* max number of extended header bits */
 #define ZFP_MODE_SHORT_MAX  ((1u << ZFP_MODE_SHORT_BITS) - 2)
 
 /* rounding mode for reducing bias; see build option ZFP_ROUNDING_MODE */
@@ -66,30 +70,69 @@ typedef int zfp_bool; /* Boolean type */
 
 /* execution policy */
 typedef enum {
-  zfp_exec_serial = 0, /* serial execution (default) */
-  zfp_exec_omp    = 1, /* OpenMP multi-threaded execution */
-  zfp_exec_cuda   = 2  /* CUDA parallel execution */
+  zfp_exec_serial  = 0, /* serial execution (default) */
+  zfp_exec_omp     = 1, /* OpenMP multi-threaded execution */
+  zfp_exec_cuda    = 2, /* CUDA parallel execution */
+  zfp_exec_threads = 3  /* multi-threaded execution via user task scheduler */
 } zfp_exec_policy;
 
 /* OpenMP execution parameters */
 typedef struct {
-  uint threads;    /* number of requested threads */
-  uint chunk_size; /* number of blocks per chunk (1D only) */
+  uint threads;        /* number of requested threads */
+  uint chunk_size;     /* number of blocks per chunk */
+  zfp_bool zero_copy;  /* compress directly into output stream in two passes */
+  zfp_bool dynamic;    /* schedule chunks dynamically */
+  double* timings;     /* per-chunk wall-clock seconds (NULL if not timed) */
+  size_t timing_count; /* number of timings entries */
 } zfp_exec_params_omp;
 
+/* task invoked by scheduler for each index in [0, count) */
+typedef void (*zfp_task)(void* data, size_t index);
+
+/* scheduler that calls task(data, i) once for each i in [0, count) */
+typedef void (*zfp_parallel_for)(void* context, size_t count, zfp_task task, void* data);
+
+/* thread pool execution parameters */
+typedef struct {
+  uint threads;                  /* number of requested threads */
+  uint chunk_size;               /* number of blocks per chunk */
+  zfp_parallel_for parallel_for; /* task scheduler (NULL for calling thread) */
+  void* context;                 /* opaque scheduler state */
+} zfp_exec_params_threads;
+
 typedef struct {
   zfp_exec_policy policy; /* execution policy (serial, omp, ...) */
   void* params;           /* execution parameters */
 } zfp_execution;
 
+/* block index encoding */
+typedef enum {
+  zfp_index_verbatim = 1, /* 64-bit offset per block */
+  zfp_index_hybrid4  = 2, /* 24 bits/block; offsets up to 2^44 bits */
+  zfp_index_hybrid8  = 3  /* 16 bits/block; offsets up to 2^(86 - 14 d) bits */
+} zfp_index_type;
+
+/* block index for random access to compressed stream (opaque) */
+typedef struct zfp_index zfp_index;
+
+/* optional information stored in extended headers */
+typedef struct {
+  ptrdiff_t sx, sy, sz, sw; /* stride hints for uncompressed layout (0 if none) */
+  uint64 index_offset;      /* byte offset of block index from header start */
+  uint64 index_size;        /* byte size of serialized block index (0 if none) */
+} zfp_header_ext;
+
 /* compressed stream; use accessors to get/set members */
 typedef struct {
-  uint minbits;       /* minimum number of bits to store per block */
-  uint maxbits;       /* maximum number of bits to store per block */
-  uint maxprec;       /* maximum number of bit planes to store */
-  int minexp;         /* minimum floating point bit plane number to store */
-  bitstream* stream;  /* compressed bit stream */
-  zfp_execution exec; /* execution policy and parameters */
+  uint minbits;         /* minimum number of bits to store per block */
+  uint maxbits;         /* maximum number of bits to store per block */
+  uint maxprec;         /* maximum number of bit planes to store */
+  int minexp;           /* minimum floating point bit plane number to store */
+  bitstream* stream;    /* compressed bit stream */
+  zfp_execution exec;   /* execution policy and parameters */
+  zfp_bool chunk_index; /* embed index of chunk sizes in compressed stream */
+  zfp_index* index;     /* block index to build during compression (or NULL) */
+  void* slab;           /* state of slab-by-slab compression (or NULL) */
 } zfp_stream;
 
 /* compression mode */
@@ -228,6 +271,14 @@ zfp_stream_maximum_size(
   const zfp_field* field    /* array to compress */
 );
 
+/* compressed size in bytes from (sampled) blocks encoded without output */
+size_t                      /* estimated number of bytes or zero upon failure */
+zfp_compressed_size_estimate(
+  const zfp_stream* stream, /* compressed stream */
+  const zfp_field* field,   /* array to compress */
+  double sample_fraction    /* fraction of blocks to encode in (0, 1] */
+);
+
 /* high-level API: initialization of compressed stream parameters ---------- */
 
 /* rewind bit stream to beginning for compression or decompression */
@@ -304,12 +355,36 @@ zfp_stream_omp_threads(
   const zfp_stream* stream /* compressed stream */
 );
 
-/* number of blocks per OpenMP chunk (1D only) */
+/* number of blocks per OpenMP chunk */
 uint                       /* number of blocks per chunk (0 for default) */
 zfp_stream_omp_chunk_size(
   const zfp_stream* stream /* compressed stream */
 );
 
+/* whether OpenMP compression avoids per-chunk temporary buffers */
+zfp_bool                   /* true if chunks are compressed in place */
+zfp_stream_omp_zero_copy(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* number of threads to partition work among (0 for default) */
+uint                       /* number of threads */
+zfp_stream_thread_count(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* number of blocks per chunk for thread pool execution (0 for default) */
+uint                       /* number of blocks per chunk */
+zfp_stream_thread_chunk_size(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* whether OpenMP chunks are scheduled dynamically */
+zfp_bool                   /* true if chunks are scheduled dynamically */
+zfp_stream_omp_dynamic(
+  const zfp_stream* stream /* compressed stream */
+);
+
 /* set execution policy */
 zfp_bool                 /* true upon success */
 zfp_stream_set_execution(
@@ -324,13 +399,118 @@ zfp_stream_set_omp_threads(
   uint threads        /* number of OpenMP threads to use (0 for default) */
 );
 
-/* set OpenMP execution policy and number of blocks per chunk (1D only) */
+/* set OpenMP execution policy and number of blocks per chunk */
 zfp_bool              /* true upon success */
 zfp_stream_set_omp_chunk_size(
   zfp_stream* stream, /* compressed stream */
   uint chunk_size     /* number of blocks per chunk (0 for default) */
 );
 
+/* set OpenMP execution policy and whether to compress chunks in place */
+zfp_bool              /* true upon success */
+zfp_stream_set_omp_zero_copy(
+  zfp_stream* stream, /* compressed stream */
+  zfp_bool zero_copy  /* avoid temporary buffers at the expense of two passes */
+);
+
+/* set OpenMP execution policy and whether to schedule chunks dynamically */
+zfp_bool              /* true upon success */
+zfp_stream_set_omp_dynamic(
+  zfp_stream* stream, /* compressed stream */
+  zfp_bool dynamic    /* assign chunks to threads as they become idle */
+);
+
+/* set OpenMP execution policy and array to record per-chunk timings in */
+zfp_bool              /* true upon success */
+zfp_stream_set_omp_timings(
+  zfp_stream* stream, /* compressed stream */
+  double* timings,    /* per-chunk wall-clock seconds (NULL to disable) */
+  size_t count        /* number of timings entries */
+);
+
+/* set thread pool execution policy and number of threads */
+zfp_bool              /* true upon success */
+zfp_stream_set_thread_count(
+  zfp_stream* stream, /* compressed stream */
+  uint threads        /* number of threads to partition work among */
+);
+
+/* set thread pool execution policy and number of blocks per chunk */
+zfp_bool              /* true upon success */
+zfp_stream_set_thread_chunk_size(
+  zfp_stream* stream, /* compressed stream */
+  uint chunk_size     /* number of blocks per chunk (0 for default) */
+);
+
+/* set thread pool execution policy and task scheduler */
+zfp_bool                         /* true upon success */
+zfp_stream_set_thread_scheduler(
+  zfp_stream* stream,            /* compressed stream */
+  zfp_parallel_for parallel_for, /* task scheduler (NULL for calling thread) */
+  void* context                  /* opaque state passed to scheduler */
+);
+
+/* whether compressed stream embeds index of chunk sizes */
+zfp_bool                   /* true if chunk index is enabled */
+zfp_stream_chunk_index(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* enable chunk index for parallel decompression (reader must use same setting) */
+void
+zfp_stream_set_chunk_index(
+  zfp_stream* stream, /* compressed stream */
+  zfp_bool enable     /* embed index of chunk sizes */
+);
+
+/* block index to build during compression */
+zfp_index*                 /* block index or NULL if not set */
+zfp_stream_index(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* set block index to build during compression (NULL to disable) */
+void
+zfp_stream_set_index(
+  zfp_stream* stream, /* compressed stream */
+  zfp_index* index    /* block index to populate on each zfp_compress() */
+);
+
+/* high-level API: block index --------------------------------------------- */
+
+/* allocate empty block index of given encoding */
+zfp_index*            /* allocated block index or NULL upon failure */
+zfp_index_create(
+  zfp_index_type type /* block offset encoding */
+);
+
+/* deallocate block index */
+void
+zfp_index_free(
+  zfp_index* index /* block index */
+);
+
+/* number of bytes needed to serialize block index */
+size_t                   /* byte size of serialized index or zero if not built */
+zfp_index_size(
+  const zfp_index* index /* block index */
+);
+
+/* serialize block index to buffer */
+size_t                    /* number of bytes written or zero upon failure */
+zfp_index_write(
+  const zfp_index* index, /* block index */
+  void* buffer,           /* buffer to write to */
+  size_t size             /* byte size of buffer */
+);
+
+/* deserialize block index from buffer */
+zfp_index*            /* allocated block index or NULL upon failure */
+zfp_index_read(
+  const void* buffer, /* buffer holding serialized index */
+  size_t size         /* byte size of buffer */
+);
+
 /* high-level API: compression mode and parameter settings ----------------- */
 
 /* unspecified configuration */
@@ -596,6 +776,79 @@ zfp_decompress(
   zfp_field* field    /* field metadata */
 );
 
+/* begin compressing field whose values are supplied one slab at a time */
+zfp_bool                 /* true upon success */
+zfp_stream_begin(
+  zfp_stream* stream,    /* compressed stream */
+  const zfp_field* field /* field metadata (data pointer is ignored) */
+);
+
+/* compress next slab of n units along slowest dimension (n % 4 = 0 unless last) */
+size_t                /* number of bits of compressed storage written */
+zfp_stream_append_slab(
+  zfp_stream* stream, /* compressed stream */
+  const void* data,   /* slab values laid out as in field */
+  size_t n            /* slab size along slowest varying dimension */
+);
+
+/* finish compressing field once all slabs have been appended */
+size_t               /* cumulative number of bytes of compressed storage */
+zfp_stream_end(
+  zfp_stream* stream /* compressed stream */
+);
+
+/* decompress subset of field with origin (x0, y0, z0, w0) using block index */
+size_t                    /* number of bits of compressed storage read */
+zfp_decompress_box(
+  zfp_stream* stream,     /* compressed stream positioned as for zfp_decompress */
+  const zfp_index* index, /* block index built by zfp_compress */
+  zfp_field* field,       /* box dimensions, type, and storage */
+  size_t x0,              /* box origin along x within indexed field */
+  size_t y0,              /* box origin along y (0 if unused) */
+  size_t z0,              /* box origin along z (0 if unused) */
+  size_t w0               /* box origin along w (0 if unused) */
+);
+
+/* compress count contiguous blocks stored back to back (0 upon failure) */
+size_t                /* number of bits of compressed storage written */
+zfp_compress_blocks(
+  zfp_stream* stream, /* compressed stream */
+  zfp_type type,      /* scalar type */
+  uint dims,          /* dimensionality of each block */
+  const void* blocks, /* first of count blocks of 4^dims values each */
+  size_t count        /* number of blocks */
+);
+
+/* compress count contiguous blocks stored at block[i] (0 upon failure) */
+size_t                      /* number of bits of compressed storage written */
+zfp_compress_blocks_indirect(
+  zfp_stream* stream,       /* compressed stream */
+  zfp_type type,            /* scalar type */
+  uint dims,                /* dimensionality of each block */
+  const void* const* block, /* addresses of count blocks of 4^dims values */
+  size_t count              /* number of blocks */
+);
+
+/* decompress count contiguous blocks stored back to back (0 upon failure) */
+size_t                /* number of bits of compressed storage read */
+zfp_decompress_blocks(
+  zfp_stream* stream, /* compressed stream */
+  zfp_type type,      /* scalar type */
+  uint dims,          /* dimensionality of each block */
+  void* blocks,       /* first of count blocks of 4^dims values each */
+  size_t count        /* number of blocks */
+);
+
+/* decompress count contiguous blocks stored at block[i] (0 upon failure) */
+size_t                /* number of bits of compressed storage read */
+zfp_decompress_blocks_indirect(
+  zfp_stream* stream, /* compressed stream */
+  zfp_type type,      /* scalar type */
+  uint dims,          /* dimensionality of each block */
+  void* const* block, /* addresses of count blocks of 4^dims values */
+  size_t count        /* number of blocks */
+);
+
 /* write compression parameters and field metadata (optional) */
 size_t                    /* number of bits written or zero upon failure */
 zfp_write_header(
@@ -612,6 +865,24 @@ zfp_read_header(
   uint mask           /* information to read */
 );
 
+/* write header including optional extended information */
+size_t                      /* number of bits written or zero upon failure */
+zfp_write_header_ext(
+  zfp_stream* stream,        /* compressed stream */
+  const zfp_field* field,    /* field metadata */
+  uint mask,                 /* information to write */
+  const zfp_header_ext* ext  /* stride hints and index location (or NULL) */
+);
+
+/* read header including optional extended information */
+size_t                /* number of bits read or zero upon failure */
+zfp_read_header_ext(
+  zfp_stream* stream, /* compressed stream */
+  zfp_field* field,   /* field metadata */
+  uint mask,          /* information to read */
+  zfp_header_ext* ext /* stride hints and index location (or NULL) */
+);
+
 /* low-level API: stream manipulation -------------------------------------- */
 
 /* flush bit stream--must be called after last encode call or between seeks */
@@ -635,7 +906,11 @@ array.  In the latter case, p points to the first scalar; (nx, ny, nz) specify
 the size of the block, with 1 <= nx, ny, nz <= 4; and (sx, sy, sz) specify the
 strides, i.e. the number of scalars to advance to get to the next scalar along
 each dimension.  The functions return the number of bits of compressed storage
-needed for the compressed block.
+needed for the compressed block.  The zfp_encode_blocks functions encode a
+sequence of count contiguous blocks stored either back to back or at the
+addresses block[0], ..., block[count - 1], and return the total number of bits
+written.  The output is identical to that of count calls to zfp_encode_block,
+but per-block overhead is amortized over the whole sequence.
 */
 
 /* encode 1D contiguous block of 4 values */
@@ -654,6 +929,16 @@ size_t zfp_encode_partial_block_strided_int64_1(zfp_stream* stream, const int64*
 size_t zfp_encode_partial_block_strided_float_1(zfp_stream* stream, const float* p, size_t nx, ptrdiff_t sx);
 size_t zfp_encode_partial_block_strided_double_1(zfp_stream* stream, const double* p, size_t nx, ptrdiff_t sx);
 
+/* encode 1D contiguous blocks stored back to back or at given addresses */
+size_t zfp_encode_blocks_int32_1(zfp_stream* stream, const int32* blocks, size_t count);
+size_t zfp_encode_blocks_int64_1(zfp_stream* stream, const int64* blocks, size_t count);
+size_t zfp_encode_blocks_float_1(zfp_stream* stream, const float* blocks, size_t count);
+size_t zfp_encode_blocks_double_1(zfp_stream* stream, const double* blocks, size_t count);
+size_t zfp_encode_blocks_indirect_int32_1(zfp_stream* stream, const int32* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_int64_1(zfp_stream* stream, const int64* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_float_1(zfp_stream* stream, const float* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_double_1(zfp_stream* stream, const double* const* block, size_t count);
+
 /* encode 2D contiguous block of 4x4 values */
 size_t zfp_encode_block_int32_2(zfp_stream* stream, const int32* block);
 size_t zfp_encode_block_int64_2(zfp_stream* stream, const int64* block);
@@ -670,6 +955,16 @@ size_t zfp_encode_block_strided_int64_2(zfp_stream* stream, const int64* p, ptrd
 size_t zfp_encode_block_strided_float_2(zfp_stream* stream, const float* p, ptrdiff_t sx, ptrdiff_t sy);
 size_t zfp_encode_block_strided_double_2(zfp_stream* stream, const double* p, ptrdiff_t sx, ptrdiff_t sy);
 
+/* encode 2D contiguous blocks stored back to back or at given addresses */
+size_t zfp_encode_blocks_int32_2(zfp_stream* stream, const int32* blocks, size_t count);
+size_t zfp_encode_blocks_int64_2(zfp_stream* stream, const int64* blocks, size_t count);
+size_t zfp_encode_blocks_float_2(zfp_stream* stream, const float* blocks, size_t count);
+size_t zfp_encode_blocks_double_2(zfp_stream* stream, const double* blocks, size_t count);
+size_t zfp_encode_blocks_indirect_int32_2(zfp_stream* stream, const int32* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_int64_2(zfp_stream* stream, const int64* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_float_2(zfp_stream* stream, const float* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_double_2(zfp_stream* stream, const double* const* block, size_t count);
+
 /* encode 3D contiguous block of 4x4x4 values */
 size_t zfp_encode_block_int32_3(zfp_stream* stream, const int32* block);
 size_t zfp_encode_block_int64_3(zfp_stream* stream, const int64* block);
@@ -686,6 +981,16 @@ size_t zfp_encode_partial_block_strided_int64_3(zfp_stream* stream, const int64*
 size_t zfp_encode_partial_block_strided_float_3(zfp_stream* stream, const float* p, size_t nx, size_t ny, size_t nz, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
 size_t zfp_encode_partial_block_strided_double_3(zfp_stream* stream, const double* p, size_t nx, size_t ny, size_t nz, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
 
+/* encode 3D contiguous blocks stored back to back or at given addresses */
+size_t zfp_encode_blocks_int32_3(zfp_stream* stream, const int32* blocks, size_t count);
+size_t zfp_encode_blocks_int64_3(zfp_stream* stream, const int64* blocks, size_t count);
+size_t zfp_encode_blocks_float_3(zfp_stream* stream, const float* blocks, size_t count);
+size_t zfp_encode_blocks_double_3(zfp_stream* stream, const double* blocks, size_t count);
+size_t zfp_encode_blocks_indirect_int32_3(zfp_stream* stream, const int32* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_int64_3(zfp_stream* stream, const int64* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_float_3(zfp_stream* stream, const float* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_double_3(zfp_stream* stream, const double* const* block, size_t count);
+
 /* encode 4D contiguous block of 4x4x4x4 values */
 size_t zfp_encode_block_int32_4(zfp_stream* stream, const int32* block);
 size_t zfp_encode_block_int64_4(zfp_stream* stream, const int64* block);
@@ -702,12 +1007,22 @@ size_t zfp_encode_partial_block_strided_int64_4(zfp_stream* stream, const int64*
 size_t zfp_encode_partial_block_strided_float_4(zfp_stream* stream, const float* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 size_t zfp_encode_partial_block_strided_double_4(zfp_stream* stream, const double* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 
+/* encode 4D contiguous blocks stored back to back or at given addresses */
+size_t zfp_encode_blocks_int32_4(zfp_stream* stream, const int32* blocks, size_t count);
+size_t zfp_encode_blocks_int64_4(zfp_stream* stream, const int64* blocks, size_t count);
+size_t zfp_encode_blocks_float_4(zfp_stream* stream, const float* blocks, size_t count);
+size_t zfp_encode_blocks_double_4(zfp_stream* stream, const double* blocks, size_t count);
+size_t zfp_encode_blocks_indirect_int32_4(zfp_stream* stream, const int32* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_int64_4(zfp_stream* stream, const int64* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_float_4(zfp_stream* stream, const float* const* block, size_t count);
+size_t zfp_encode_blocks_indirect_double_4(zfp_stream* stream, const double* const* block, size_t count);
+
 /* low-level API: decoder -------------------------------------------------- */
 
 /*
-Each function below decompresses a single block and returns the number of bits
-of compressed storage consumed.  See corresponding encoder functions above for
-further details.
+Each function below decompresses a single block (or, for zfp_decode_blocks, a
+sequence of blocks) and returns the number of bits of compressed storage
+consumed.  See corresponding encoder functions above for further details.
 */
 
 /* decode 1D contiguous block of 4 values */
@@ -726,6 +1041,16 @@ size_t zfp_decode_partial_block_strided_int64_1(zfp_stream* stream, int64* p, si
 size_t zfp_decode_partial_block_strided_float_1(zfp_stream* stream, float* p, size_t nx, ptrdiff_t sx);
 size_t zfp_decode_partial_block_strided_double_1(zfp_stream* stream, double* p, size_t nx, ptrdiff_t sx);
 
+/* decode 1D contiguous blocks stored back to back or at given addresses */
+size_t zfp_decode_blocks_int32_1(zfp_stream* stream, int32* blocks, size_t count);
+size_t zfp_decode_blocks_int64_1(zfp_stream* stream, int64* blocks, size_t count);
+size_t zfp_decode_blocks_float_1(zfp_stream* stream, float* blocks, size_t count);
+size_t zfp_decode_blocks_double_1(zfp_stream* stream, double* blocks, size_t count);
+size_t zfp_decode_blocks_indirect_int32_1(zfp_stream* stream, int32* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_int64_1(zfp_stream* stream, int64* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_float_1(zfp_stream* stream, float* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_double_1(zfp_stream* stream, double* const* block, size_t count);
+
 /* decode 2D contiguous block of 4x4 values */
 size_t zfp_decode_block_int32_2(zfp_stream* stream, int32* block);
 size_t zfp_decode_block_int64_2(zfp_stream* stream, int64* block);
@@ -742,6 +1067,16 @@ size_t zfp_decode_partial_block_strided_int64_2(zfp_stream* stream, int64* p, si
 size_t zfp_decode_partial_block_strided_float_2(zfp_stream* stream, float* p, size_t nx, size_t ny, ptrdiff_t sx, ptrdiff_t sy);
 size_t zfp_decode_partial_block_strided_double_2(zfp_stream* stream, double* p, size_t nx, size_t ny, ptrdiff_t sx, ptrdiff_t sy);
 
+/* decode 2D contiguous blocks stored back to back or at given addresses */
+size_t zfp_decode_blocks_int32_2(zfp_stream* stream, int32* blocks, size_t count);
+size_t zfp_decode_blocks_int64_2(zfp_stream* stream, int64* blocks, size_t count);
+size_t zfp_decode_blocks_float_2(zfp_stream* stream, float* blocks, size_t count);
+size_t zfp_decode_blocks_double_2(zfp_stream* stream, double* blocks, size_t count);
+size_t zfp_decode_blocks_indirect_int32_2(zfp_stream* stream, int32* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_int64_2(zfp_stream* stream, int64* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_float_2(zfp_stream* stream, float* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_double_2(zfp_stream* stream, double* const* block, size_t count);
+
 /* decode 3D contiguous block of 4x4x4 values */
 size_t zfp_decode_block_int32_3(zfp_stream* stream, int32* block);
 size_t zfp_decode_block_int64_3(zfp_stream* stream, int64* block);
@@ -758,6 +1093,16 @@ size_t zfp_decode_partial_block_strided_int64_3(zfp_stream* stream, int64* p, si
 size_t zfp_decode_partial_block_strided_float_3(zfp_stream* stream, float* p, size_t nx, size_t ny, size_t nz, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
 size_t zfp_decode_partial_block_strided_double_3(zfp_stream* stream, double* p, size_t nx, size_t ny, size_t nz, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
 
+/* decode 3D contiguous blocks stored back to back or at given addresses */
+size_t zfp_decode_blocks_int32_3(zfp_stream* stream, int32* blocks, size_t count);
+size_t zfp_decode_blocks_int64_3(zfp_stream* stream, int64* blocks, size_t count);
+size_t zfp_decode_blocks_float_3(zfp_stream* stream, float* blocks, size_t count);
+size_t zfp_decode_blocks_double_3(zfp_stream* stream, double* blocks, size_t count);
+size_t zfp_decode_blocks_indirect_int32_3(zfp_stream* stream, int32* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_int64_3(zfp_stream* stream, int64* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_float_3(zfp_stream* stream, float* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_double_3(zfp_stream* stream, double* const* block, size_t count);
+
 /* decode 4D contiguous block of 4x4x4x4 values */
 size_t zfp_decode_block_int32_4(zfp_stream* stream, int32* block);
 size_t zfp_decode_block_int64_4(zfp_stream* stream, int64* block);
@@ -774,6 +1119,16 @@ size_t zfp_decode_partial_block_strided_int64_4(zfp_stream* stream, int64* p, si
 size_t zfp_decode_partial_block_strided_float_4(zfp_stream* stream, float* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 size_t zfp_decode_partial_block_strided_double_4(zfp_stream* stream, double* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 
+/* decode 4D contiguous blocks stored back to back or at given addresses */
+size_t zfp_decode_blocks_int32_4(zfp_stream* stream, int32* blocks, size_t count);
+size_t zfp_decode_blocks_int64_4(zfp_stream* stream, int64* blocks, size_t count);
+size_t zfp_decode_blocks_float_4(zfp_stream* stream, float* blocks, size_t count);
+size_t zfp_decode_blocks_double_4(zfp_stream* stream, double* blocks, size_t count);
+size_t zfp_decode_blocks_indirect_int32_4(zfp_stream* stream, int32* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_int64_4(zfp_stream* stream, int64* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_float_4(zfp_stream* stream, float* const* block, size_t count);
+size_t zfp_decode_blocks_indirect_double_4(zfp_stream* stream, double* const* block, size_t count);
+
 /* low-level API: utility functions ---------------------------------------- */
 
 /* convert dims-dimensional contiguous block to 32-bit integer type */
@@ -48,6 +48,14 @@ template <typename Scalar>
 inline size_t
 encode_partial_block_strided(zfp_stream* zfp, const Scalar* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 
+template <typename Scalar, uint dims>
+inline size_t
+encode_blocks(zfp_stream* zfp, const Scalar* blocks, size_t count);
+
+template <typename Scalar, uint dims>
+inline size_t
+encode_blocks_indirect(zfp_stream* zfp, const Scalar* const* block, size_t count);
+
 // encoder specializations ----------------------------------------------------
 
 template<>
@@ -148,6 +156,70 @@ template <>
 inline size_t
 encode_partial_block_strided<double>(zfp_stream* zfp, const double* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw) { return zfp_encode_partial_block_strided_double_4(zfp, p, nx, ny, nz, nw, sx, sy, sz, sw); }
 
+template <>
+inline size_t
+encode_blocks<float, 1>(zfp_stream* zfp, const float* blocks, size_t count) { return zfp_encode_blocks_float_1(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<float, 2>(zfp_stream* zfp, const float* blocks, size_t count) { return zfp_encode_blocks_float_2(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<float, 3>(zfp_stream* zfp, const float* blocks, size_t count) { return zfp_encode_blocks_float_3(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<float, 4>(zfp_stream* zfp, const float* blocks, size_t count) { return zfp_encode_blocks_float_4(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<double, 1>(zfp_stream* zfp, const double* blocks, size_t count) { return zfp_encode_blocks_double_1(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<double, 2>(zfp_stream* zfp, const double* blocks, size_t count) { return zfp_encode_blocks_double_2(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<double, 3>(zfp_stream* zfp, const double* blocks, size_t count) { return zfp_encode_blocks_double_3(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks<double, 4>(zfp_stream* zfp, const double* blocks, size_t count) { return zfp_encode_blocks_double_4(zfp, blocks, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<float, 1>(zfp_stream* zfp, const float* const* block, size_t count) { return zfp_encode_blocks_indirect_float_1(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<float, 2>(zfp_stream* zfp, const float* const* block, size_t count) { return zfp_encode_blocks_indirect_float_2(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<float, 3>(zfp_stream* zfp, const float* const* block, size_t count) { return zfp_encode_blocks_indirect_float_3(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<float, 4>(zfp_stream* zfp, const float* const* block, size_t count) { return zfp_encode_blocks_indirect_float_4(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<double, 1>(zfp_stream* zfp, const double* const* block, size_t count) { return zfp_encode_blocks_indirect_double_1(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<double, 2>(zfp_stream* zfp, const double* const* block, size_t count) { return zfp_encode_blocks_indirect_double_2(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<double, 3>(zfp_stream* zfp, const double* const* block, size_t count) { return zfp_encode_blocks_indirect_double_3(zfp, block, count); }
+
+template <>
+inline size_t
+encode_blocks_indirect<double, 4>(zfp_stream* zfp, const double* const* block, size_t count) { return zfp_encode_blocks_indirect_double_4(zfp, block, count); }
+
 // decoder declarations -------------------------------------------------------
 
 template <typename Scalar, uint dims>
@@ -186,6 +258,14 @@ template <typename Scalar>
 inline size_t
 decode_partial_block_strided(zfp_stream* zfp, Scalar* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 
+template <typename Scalar, uint dims>
+inline size_t
+decode_blocks(zfp_stream* zfp, Scalar* blocks, size_t count);
+
+template <typename Scalar, uint dims>
+inline size_t
+decode_blocks_indirect(zfp_stream* zfp, Scalar* const* block, size_t count);
+
 // decoder specializations ----------------------------------------------------
 
 template<>
@@ -284,6 +364,70 @@ template <>
 inline size_t
 decode_partial_block_strided<double>(zfp_stream* zfp, double* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw) { return zfp_decode_partial_block_strided_double_4(zfp, p, nx, ny, nz, nw, sx, sy, sz, sw); }
 
+template <>
+inline size_t
+decode_blocks<float, 1>(zfp_stream* zfp, float* blocks, size_t count) { return zfp_decode_blocks_float_1(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<float, 2>(zfp_stream* zfp, float* blocks, size_t count) { return zfp_decode_blocks_float_2(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<float, 3>(zfp_stream* zfp, float* blocks, size_t count) { return zfp_decode_blocks_float_3(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<float, 4>(zfp_stream* zfp, float* blocks, size_t count) { return zfp_decode_blocks_float_4(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<double, 1>(zfp_stream* zfp, double* blocks, size_t count) { return zfp_decode_blocks_double_1(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<double, 2>(zfp_stream* zfp, double* blocks, size_t count) { return zfp_decode_blocks_double_2(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<double, 3>(zfp_stream* zfp, double* blocks, size_t count) { return zfp_decode_blocks_double_3(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks<double, 4>(zfp_stream* zfp, double* blocks, size_t count) { return zfp_decode_blocks_double_4(zfp, blocks, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<float, 1>(zfp_stream* zfp, float* const* block, size_t count) { return zfp_decode_blocks_indirect_float_1(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<float, 2>(zfp_stream* zfp, float* const* block, size_t count) { return zfp_decode_blocks_indirect_float_2(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<float, 3>(zfp_stream* zfp, float* const* block, size_t count) { return zfp_decode_blocks_indirect_float_3(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<float, 4>(zfp_stream* zfp, float* const* block, size_t count) { return zfp_decode_blocks_indirect_float_4(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<double, 1>(zfp_stream* zfp, double* const* block, size_t count) { return zfp_decode_blocks_indirect_double_1(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<double, 2>(zfp_stream* zfp, double* const* block, size_t count) { return zfp_decode_blocks_indirect_double_2(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<double, 3>(zfp_stream* zfp, double* const* block, size_t count) { return zfp_decode_blocks_indirect_double_3(zfp, block, count); }
+
+template <>
+inline size_t
+decode_blocks_indirect<double, 4>(zfp_stream* zfp, double* const* block, size_t count) { return zfp_decode_blocks_indirect_double_4(zfp, block, count); }
+
 }
 
 #endif
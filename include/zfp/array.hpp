@@ -9,6 +9,15 @@
 
 namespace zfp {
 
+// statistics on accesses to the cache of a compressed array
+struct cache_statistics {
+  uint64 hits;        // number of accesses to cached blocks
+  uint64 misses;      // number of accesses to uncached blocks
+  uint64 writebacks;  // number of modified blocks compressed
+  double decode_time; // seconds spent decompressing blocks
+  double encode_time; // seconds spent compressing blocks
+};
+
 // abstract base class for compressed array of scalars
 class array {
 public:
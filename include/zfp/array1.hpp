@@ -5,14 +5,18 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache1.hpp"
 #include "zfp/internal/array/handle1.hpp"
 #include "zfp/internal/array/iterator1.hpp"
 #include "zfp/internal/array/pointer1.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference1.hpp"
 #include "zfp/internal/array/store1.hpp"
+#include "zfp/internal/array/tile1.hpp"
+#include "zfp/internal/array/transform.hpp"
 #include "zfp/internal/array/view1.hpp"
 
 namespace zfp {
@@ -21,7 +25,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp1<Scalar>,
-  class Index = zfp::index::implicit
+  class Index = zfp::index::implicit,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class array1 : public array {
 public:
@@ -30,8 +35,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore1<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache1<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache1<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,11 +46,13 @@ public:
   typedef zfp::internal::dim1::const_iterator<array1> const_iterator;
   typedef zfp::internal::dim1::const_view<array1> const_view;
   typedef zfp::internal::dim1::private_const_view<array1> private_const_view;
+  typedef zfp::internal::dim1::const_tile<array1> const_tile;
   typedef zfp::internal::dim1::reference<array1> reference;
   typedef zfp::internal::dim1::pointer<array1> pointer;
   typedef zfp::internal::dim1::iterator<array1> iterator;
   typedef zfp::internal::dim1::view<array1> view;
   typedef zfp::internal::dim1::private_view<array1> private_view;
+  typedef zfp::internal::dim1::tile<array1> tile;
 
   // default constructor
   array1() :
@@ -64,6 +72,18 @@ public:
       set(p);
   }
 
+  // constructor of nx-element array using rate bits per value and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file), which is zero-initialized if clear is
+  // set and otherwise assumed to hold a previously compressed array
+  array1(size_t nx, double rate, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(1, Codec::type),
+    store(nx, zfp_config_rate(rate, true), buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+  }
+
   // constructor, from previously-serialized compressed array
   array1(const zfp::array::header& header, const void* buffer = 0, size_t buffer_size_bytes = 0) :
     array(1, Codec::type, header),
@@ -112,6 +132,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
 
@@ -170,14 +193,23 @@ public:
   // flush cache by compressing all modified cached blocks
   void flush_cache() const { cache.flush(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
     const ptrdiff_t sx = 1;
-    size_t block_index = 0;
-    for (size_t i = 0; i < bx; i++, p += 4)
-      cache.get_block(block_index++, p, sx);
+    cache.get_blocks(p, sx);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -188,8 +220,7 @@ public:
     if (p) {
       // compress data stored at p
       const ptrdiff_t sx = 1;
-      for (size_t i = 0; i < bx; i++, p += 4)
-        cache.put_block(block_index++, p, sx);
+      cache.put_blocks(p, sx);
     }
     else {
       // zero-initialize array
@@ -199,6 +230,91 @@ public:
     }
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a)
+  {
+    if (a.size_x() != nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) != static_cast<const void*>(this))
+      cache.put_blocks(a.cache);
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, nx); }
+
+  // sum of elements in range [x, x + nx)
+  double sum(size_t x, size_t nx) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, nx);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, nx); }
+
+  // smallest element in range [x, x + nx)
+  value_type minimum(size_t x, size_t nx) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, nx);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, nx); }
+
+  // largest element in range [x, x + nx)
+  value_type maximum(size_t x, size_t nx) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, nx);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const array1& a) const { return dot(a, 0, nx); }
+
+  // inner product with array a in range [x, x + nx)
+  double dot(const array1& a, size_t x, size_t nx) const
+  {
+    if (a.nx != this->nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, nx);
+    return r.value;
+  }
+
+  // scale all elements by a
+  void scale(value_type a) { cache.transform(zfp::internal::ScaleTransform<value_type>(a), 0); }
+
+  // add array x of the same dimensions
+  void add(const array1& x)
+  {
+    if (x.nx != nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AddTransform<value_type>(), &x.cache);
+  }
+
+  // add array x of the same dimensions scaled by a
+  void axpy(value_type a, const array1& x)
+  {
+    if (x.nx != nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AxpyTransform<value_type>(a), &x.cache);
+  }
+
+  // interpolate linearly between this array (t = 0) and array x (t = 1)
+  void lerp(const array1& x, value_type t)
+  {
+    if (x.nx != nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::LerpTransform<value_type>(t), &x.cache);
+  }
+
   // accessors
   const_reference operator()(size_t i) const { return const_reference(const_cast<container_type*>(this), i); }
   reference operator()(size_t i) { return reference(this, i); }
@@ -222,11 +338,15 @@ protected:
   friend class zfp::internal::dim1::const_iterator<array1>;
   friend class zfp::internal::dim1::const_view<array1>;
   friend class zfp::internal::dim1::private_const_view<array1>;
+  friend class zfp::internal::dim1::const_tile<array1>;
   friend class zfp::internal::dim1::reference<array1>;
   friend class zfp::internal::dim1::pointer<array1>;
   friend class zfp::internal::dim1::iterator<array1>;
   friend class zfp::internal::dim1::view<array1>;
   friend class zfp::internal::dim1::private_view<array1>;
+  friend class zfp::internal::dim1::tile<array1>;
+  template <typename, class, class, class> friend class array1;
+  template <typename, class, class, class> friend class const_array1;
 
   // perform a deep copy
   void deep_copy(const array1& a)
@@ -248,10 +368,10 @@ protected:
 
   // mutators (called from proxy reference)
   void set(size_t i, value_type val) { cache.set(i, val); }
-  void add(size_t i, value_type val) { cache.ref(i) += val; }
-  void sub(size_t i, value_type val) { cache.ref(i) -= val; }
-  void mul(size_t i, value_type val) { cache.ref(i) *= val; }
-  void div(size_t i, value_type val) { cache.ref(i) /= val; }
+  void add(size_t i, value_type val) { cache.add(i, val); }
+  void sub(size_t i, value_type val) { cache.sub(i, val); }
+  void mul(size_t i, value_type val) { cache.mul(i, val); }
+  void div(size_t i, value_type val) { cache.div(i, val); }
 
   store_type store; // persistent storage of compressed blocks
   cache_type cache; // cache of decompressed blocks
@@ -5,14 +5,18 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache2.hpp"
 #include "zfp/internal/array/handle2.hpp"
 #include "zfp/internal/array/iterator2.hpp"
 #include "zfp/internal/array/pointer2.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference2.hpp"
 #include "zfp/internal/array/store2.hpp"
+#include "zfp/internal/array/tile2.hpp"
+#include "zfp/internal/array/transform.hpp"
 #include "zfp/internal/array/view2.hpp"
 
 namespace zfp {
@@ -21,7 +25,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp2<Scalar>,
-  class Index = zfp::index::implicit
+  class Index = zfp::index::implicit,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class array2 : public array {
 public:
@@ -30,8 +35,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore2<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache2<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache2<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,6 +46,7 @@ public:
   typedef zfp::internal::dim2::const_iterator<array2> const_iterator;
   typedef zfp::internal::dim2::const_view<array2> const_view;
   typedef zfp::internal::dim2::private_const_view<array2> private_const_view;
+  typedef zfp::internal::dim2::const_tile<array2> const_tile;
   typedef zfp::internal::dim2::reference<array2> reference;
   typedef zfp::internal::dim2::pointer<array2> pointer;
   typedef zfp::internal::dim2::iterator<array2> iterator;
@@ -49,6 +56,7 @@ public:
   typedef zfp::internal::dim2::nested_view2<array2> nested_view2;
   typedef zfp::internal::dim2::nested_view2<array2> nested_view;
   typedef zfp::internal::dim2::private_view<array2> private_view;
+  typedef zfp::internal::dim2::tile<array2> tile;
 
   // default constructor
   array2() :
@@ -69,6 +77,19 @@ public:
       set(p);
   }
 
+  // constructor of nx * ny array using rate bits per value and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file), which is zero-initialized if clear is
+  // set and otherwise assumed to hold a previously compressed array
+  array2(size_t nx, size_t ny, double rate, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(2, Codec::type),
+    store(nx, ny, zfp_config_rate(rate, true), buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+    this->ny = ny;
+  }
+
   // constructor, from previously-serialized compressed array
   array2(const zfp::array::header& header, const void* buffer = 0, size_t buffer_size_bytes = 0) :
     array(2, Codec::type, header),
@@ -118,6 +139,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx * ny; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
   size_t size_y() const { return ny; }
@@ -178,17 +202,24 @@ public:
   // flush cache by compressing all modified cached blocks
   void flush_cache() const { cache.flush(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
     const ptrdiff_t sx = 1;
     const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
-    size_t block_index = 0;
-    for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-      for (size_t i = 0; i < bx; i++, p += 4)
-        cache.get_block(block_index++, p, sx, sy);
+    cache.get_blocks(p, sx, sy);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -201,9 +232,7 @@ public:
       // compress data stored at p
       const ptrdiff_t sx = 1;
       const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
-      for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-        for (size_t i = 0; i < bx; i++, p += 4)
-          cache.put_block(block_index++, p, sx, sy);
+      cache.put_blocks(p, sx, sy);
     }
     else {
       // zero-initialize array
@@ -213,6 +242,91 @@ public:
     }
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a)
+  {
+    if (a.size_x() != nx || a.size_y() != ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) != static_cast<const void*>(this))
+      cache.put_blocks(a.cache);
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, 0, nx, ny); }
+
+  // sum of elements in nx * ny box with origin (x, y)
+  double sum(size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, y, nx, ny);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, 0, nx, ny); }
+
+  // smallest element in nx * ny box with origin (x, y)
+  value_type minimum(size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, y, nx, ny);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, 0, nx, ny); }
+
+  // largest element in nx * ny box with origin (x, y)
+  value_type maximum(size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, y, nx, ny);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const array2& a) const { return dot(a, 0, 0, nx, ny); }
+
+  // inner product with array a in nx * ny box with origin (x, y)
+  double dot(const array2& a, size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    if (a.nx != this->nx || a.ny != this->ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, y, nx, ny);
+    return r.value;
+  }
+
+  // scale all elements by a
+  void scale(value_type a) { cache.transform(zfp::internal::ScaleTransform<value_type>(a), 0); }
+
+  // add array x of the same dimensions
+  void add(const array2& x)
+  {
+    if (x.nx != nx || x.ny != ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AddTransform<value_type>(), &x.cache);
+  }
+
+  // add array x of the same dimensions scaled by a
+  void axpy(value_type a, const array2& x)
+  {
+    if (x.nx != nx || x.ny != ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AxpyTransform<value_type>(a), &x.cache);
+  }
+
+  // interpolate linearly between this array (t = 0) and array x (t = 1)
+  void lerp(const array2& x, value_type t)
+  {
+    if (x.nx != nx || x.ny != ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::LerpTransform<value_type>(t), &x.cache);
+  }
+
   // (i, j) accessors
   const_reference operator()(size_t i, size_t j) const { return const_reference(const_cast<container_type*>(this), i, j); }
   reference operator()(size_t i, size_t j) { return reference(this, i, j); }
@@ -246,6 +360,7 @@ protected:
   friend class zfp::internal::dim2::const_iterator<array2>;
   friend class zfp::internal::dim2::const_view<array2>;
   friend class zfp::internal::dim2::private_const_view<array2>;
+  friend class zfp::internal::dim2::const_tile<array2>;
   friend class zfp::internal::dim2::reference<array2>;
   friend class zfp::internal::dim2::pointer<array2>;
   friend class zfp::internal::dim2::iterator<array2>;
@@ -254,6 +369,9 @@ protected:
   friend class zfp::internal::dim2::nested_view1<array2>;
   friend class zfp::internal::dim2::nested_view2<array2>;
   friend class zfp::internal::dim2::private_view<array2>;
+  friend class zfp::internal::dim2::tile<array2>;
+  template <typename, class, class, class> friend class array2;
+  template <typename, class, class, class> friend class const_array2;
 
   // perform a deep copy
   void deep_copy(const array2& a)
@@ -277,10 +395,10 @@ protected:
 
   // mutators (called from proxy reference)
   void set(size_t i, size_t j, value_type val) { cache.set(i, j, val); }
-  void add(size_t i, size_t j, value_type val) { cache.ref(i, j) += val; }
-  void sub(size_t i, size_t j, value_type val) { cache.ref(i, j) -= val; }
-  void mul(size_t i, size_t j, value_type val) { cache.ref(i, j) *= val; }
-  void div(size_t i, size_t j, value_type val) { cache.ref(i, j) /= val; }
+  void add(size_t i, size_t j, value_type val) { cache.add(i, j, val); }
+  void sub(size_t i, size_t j, value_type val) { cache.sub(i, j, val); }
+  void mul(size_t i, size_t j, value_type val) { cache.mul(i, j, val); }
+  void div(size_t i, size_t j, value_type val) { cache.div(i, j, val); }
 
   // convert flat index to (i, j)
   void ij(size_t& i, size_t& j, size_t index) const
@@ -5,14 +5,18 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache3.hpp"
 #include "zfp/internal/array/handle3.hpp"
 #include "zfp/internal/array/iterator3.hpp"
 #include "zfp/internal/array/pointer3.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference3.hpp"
 #include "zfp/internal/array/store3.hpp"
+#include "zfp/internal/array/tile3.hpp"
+#include "zfp/internal/array/transform.hpp"
 #include "zfp/internal/array/view3.hpp"
 
 namespace zfp {
@@ -21,7 +25,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp3<Scalar>,
-  class Index = zfp::index::implicit
+  class Index = zfp::index::implicit,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class array3 : public array {
 public:
@@ -30,8 +35,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore3<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache3<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache3<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,6 +46,7 @@ public:
   typedef zfp::internal::dim3::const_iterator<array3> const_iterator;
   typedef zfp::internal::dim3::const_view<array3> const_view;
   typedef zfp::internal::dim3::private_const_view<array3> private_const_view;
+  typedef zfp::internal::dim3::const_tile<array3> const_tile;
   typedef zfp::internal::dim3::reference<array3> reference;
   typedef zfp::internal::dim3::pointer<array3> pointer;
   typedef zfp::internal::dim3::iterator<array3> iterator;
@@ -50,6 +57,7 @@ public:
   typedef zfp::internal::dim3::nested_view2<array3> nested_view3;
   typedef zfp::internal::dim3::nested_view3<array3> nested_view;
   typedef zfp::internal::dim3::private_view<array3> private_view;
+  typedef zfp::internal::dim3::tile<array3> tile;
 
   // default constructor
   array3() :
@@ -71,6 +79,20 @@ public:
       set(p);
   }
 
+  // constructor of nx * ny * nz array using rate bits per value and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file), which is zero-initialized if clear is
+  // set and otherwise assumed to hold a previously compressed array
+  array3(size_t nx, size_t ny, size_t nz, double rate, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(3, Codec::type),
+    store(nx, ny, nz, zfp_config_rate(rate, true), buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+    this->ny = ny;
+    this->nz = nz;
+  }
+
   // constructor, from previously-serialized compressed array
   array3(const zfp::array::header& header, const void* buffer = 0, size_t buffer_size_bytes = 0) :
     array(3, Codec::type, header),
@@ -121,6 +143,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx * ny * nz; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
   size_t size_y() const { return ny; }
@@ -183,20 +208,25 @@ public:
   // flush cache by compressing all modified cached blocks
   void flush_cache() const { cache.flush(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
-    const size_t bz = store.block_size_z();
     const ptrdiff_t sx = 1;
     const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
     const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
-    size_t block_index = 0;
-    for (size_t k = 0; k < bz; k++, p += 4 * sy * ptrdiff_t(ny - by))
-      for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-        for (size_t i = 0; i < bx; i++, p += 4)
-          cache.get_block(block_index++, p, sx, sy, sz);
+    cache.get_blocks(p, sx, sy, sz);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -211,10 +241,7 @@ public:
       const ptrdiff_t sx = 1;
       const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
       const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
-      for (size_t k = 0; k < bz; k++, p += 4 * sy * ptrdiff_t(ny - by))
-        for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-          for (size_t i = 0; i < bx; i++, p += 4)
-            cache.put_block(block_index++, p, sx, sy, sz);
+      cache.put_blocks(p, sx, sy, sz);
     }
     else {
       // zero-initialize array
@@ -224,6 +251,91 @@ public:
     }
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a)
+  {
+    if (a.size_x() != nx || a.size_y() != ny || a.size_z() != nz)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) != static_cast<const void*>(this))
+      cache.put_blocks(a.cache);
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, 0, 0, nx, ny, nz); }
+
+  // sum of elements in nx * ny * nz box with origin (x, y, z)
+  double sum(size_t x, size_t y, size_t z, size_t nx, size_t ny, size_t nz) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, y, z, nx, ny, nz);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, 0, 0, nx, ny, nz); }
+
+  // smallest element in nx * ny * nz box with origin (x, y, z)
+  value_type minimum(size_t x, size_t y, size_t z, size_t nx, size_t ny, size_t nz) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, y, z, nx, ny, nz);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, 0, 0, nx, ny, nz); }
+
+  // largest element in nx * ny * nz box with origin (x, y, z)
+  value_type maximum(size_t x, size_t y, size_t z, size_t nx, size_t ny, size_t nz) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, y, z, nx, ny, nz);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const array3& a) const { return dot(a, 0, 0, 0, nx, ny, nz); }
+
+  // inner product with array a in nx * ny * nz box with origin (x, y, z)
+  double dot(const array3& a, size_t x, size_t y, size_t z, size_t nx, size_t ny, size_t nz) const
+  {
+    if (a.nx != this->nx || a.ny != this->ny || a.nz != this->nz)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, y, z, nx, ny, nz);
+    return r.value;
+  }
+
+  // scale all elements by a
+  void scale(value_type a) { cache.transform(zfp::internal::ScaleTransform<value_type>(a), 0); }
+
+  // add array x of the same dimensions
+  void add(const array3& x)
+  {
+    if (x.nx != nx || x.ny != ny || x.nz != nz)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AddTransform<value_type>(), &x.cache);
+  }
+
+  // add array x of the same dimensions scaled by a
+  void axpy(value_type a, const array3& x)
+  {
+    if (x.nx != nx || x.ny != ny || x.nz != nz)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AxpyTransform<value_type>(a), &x.cache);
+  }
+
+  // interpolate linearly between this array (t = 0) and array x (t = 1)
+  void lerp(const array3& x, value_type t)
+  {
+    if (x.nx != nx || x.ny != ny || x.nz != nz)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::LerpTransform<value_type>(t), &x.cache);
+  }
+
   // (i, j, k) accessors
   const_reference operator()(size_t i, size_t j, size_t k) const { return const_reference(const_cast<container_type*>(this), i, j, k); }
   reference operator()(size_t i, size_t j, size_t k) { return reference(this, i, j, k); }
@@ -257,6 +369,7 @@ protected:
   friend class zfp::internal::dim3::const_iterator<array3>;
   friend class zfp::internal::dim3::const_view<array3>;
   friend class zfp::internal::dim3::private_const_view<array3>;
+  friend class zfp::internal::dim3::const_tile<array3>;
   friend class zfp::internal::dim3::reference<array3>;
   friend class zfp::internal::dim3::pointer<array3>;
   friend class zfp::internal::dim3::iterator<array3>;
@@ -266,6 +379,9 @@ protected:
   friend class zfp::internal::dim3::nested_view2<array3>;
   friend class zfp::internal::dim3::nested_view3<array3>;
   friend class zfp::internal::dim3::private_view<array3>;
+  friend class zfp::internal::dim3::tile<array3>;
+  template <typename, class, class, class> friend class array3;
+  template <typename, class, class, class> friend class const_array3;
 
   // perform a deep copy
   void deep_copy(const array3& a)
@@ -291,10 +407,10 @@ protected:
 
   // mutators (called from proxy reference)
   void set(size_t i, size_t j, size_t k, value_type val) { cache.set(i, j, k, val); }
-  void add(size_t i, size_t j, size_t k, value_type val) { cache.ref(i, j, k) += val; }
-  void sub(size_t i, size_t j, size_t k, value_type val) { cache.ref(i, j, k) -= val; }
-  void mul(size_t i, size_t j, size_t k, value_type val) { cache.ref(i, j, k) *= val; }
-  void div(size_t i, size_t j, size_t k, value_type val) { cache.ref(i, j, k) /= val; }
+  void add(size_t i, size_t j, size_t k, value_type val) { cache.add(i, j, k, val); }
+  void sub(size_t i, size_t j, size_t k, value_type val) { cache.sub(i, j, k, val); }
+  void mul(size_t i, size_t j, size_t k, value_type val) { cache.mul(i, j, k, val); }
+  void div(size_t i, size_t j, size_t k, value_type val) { cache.div(i, j, k, val); }
 
   // convert flat index to (i, j, k)
   void ijk(size_t& i, size_t& j, size_t& k, size_t index) const
@@ -5,14 +5,18 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache4.hpp"
 #include "zfp/internal/array/handle4.hpp"
 #include "zfp/internal/array/iterator4.hpp"
 #include "zfp/internal/array/pointer4.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference4.hpp"
 #include "zfp/internal/array/store4.hpp"
+#include "zfp/internal/array/tile4.hpp"
+#include "zfp/internal/array/transform.hpp"
 #include "zfp/internal/array/view4.hpp"
 
 namespace zfp {
@@ -21,7 +25,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp4<Scalar>,
-  class Index = zfp::index::implicit
+  class Index = zfp::index::implicit,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class array4 : public array {
 public:
@@ -30,8 +35,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore4<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache4<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache4<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,6 +46,7 @@ public:
   typedef zfp::internal::dim4::const_iterator<array4> const_iterator;
   typedef zfp::internal::dim4::const_view<array4> const_view;
   typedef zfp::internal::dim4::private_const_view<array4> private_const_view;
+  typedef zfp::internal::dim4::const_tile<array4> const_tile;
   typedef zfp::internal::dim4::reference<array4> reference;
   typedef zfp::internal::dim4::pointer<array4> pointer;
   typedef zfp::internal::dim4::iterator<array4> iterator;
@@ -51,6 +58,7 @@ public:
   typedef zfp::internal::dim4::nested_view4<array4> nested_view4;
   typedef zfp::internal::dim4::nested_view4<array4> nested_view;
   typedef zfp::internal::dim4::private_view<array4> private_view;
+  typedef zfp::internal::dim4::tile<array4> tile;
 
   // default constructor
   array4() :
@@ -73,6 +81,21 @@ public:
       set(p);
   }
 
+  // constructor of nx * ny * nz * nw array using rate bits per value and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file), which is zero-initialized if clear is
+  // set and otherwise assumed to hold a previously compressed array
+  array4(size_t nx, size_t ny, size_t nz, size_t nw, double rate, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(4, Codec::type),
+    store(nx, ny, nz, nw, zfp_config_rate(rate, true), buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+    this->ny = ny;
+    this->nz = nz;
+    this->nw = nw;
+  }
+
   // constructor, from previously-serialized compressed array
   array4(const zfp::array::header& header, const void* buffer = 0, size_t buffer_size_bytes = 0) :
     array(4, Codec::type, header),
@@ -124,6 +147,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx * ny * nz * nw; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
   size_t size_y() const { return ny; }
@@ -188,23 +214,26 @@ public:
   // flush cache by compressing all modified cached blocks
   void flush_cache() const { cache.flush(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
-    const size_t bz = store.block_size_z();
-    const size_t bw = store.block_size_w();
     const ptrdiff_t sx = 1;
     const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
     const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
     const ptrdiff_t sw = static_cast<ptrdiff_t>(nx * ny * nz);
-    size_t block_index = 0;
-    for (size_t l = 0; l < bw; l++, p += 4 * sz * ptrdiff_t(nz - bz))
-      for (size_t k = 0; k < bz; k++, p += 4 * sy * ptrdiff_t(ny - by))
-        for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-          for (size_t i = 0; i < bx; i++, p += 4)
-            cache.get_block(block_index++, p, sx, sy, sz, sw);
+    cache.get_blocks(p, sx, sy, sz, sw);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -221,11 +250,7 @@ public:
       const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
       const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
       const ptrdiff_t sw = static_cast<ptrdiff_t>(nx * ny * nz);
-      for (size_t l = 0; l < bw; l++, p += 4 * sz * ptrdiff_t(nz - bz))
-        for (size_t k = 0; k < bz; k++, p += 4 * sy * ptrdiff_t(ny - by))
-          for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-            for (size_t i = 0; i < bx; i++, p += 4)
-              cache.put_block(block_index++, p, sx, sy, sz, sw);
+      cache.put_blocks(p, sx, sy, sz, sw);
     }
     else {
       // zero-initialize array
@@ -235,6 +260,92 @@ public:
     }
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a)
+  {
+    if (a.size_x() != nx || a.size_y() != ny || a.size_z() != nz || a.size_w() != nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) != static_cast<const void*>(this))
+      cache.put_blocks(a.cache);
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // sum of elements in nx * ny * nz * nw box with origin (x, y, z, w)
+  double sum(size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // smallest element in nx * ny * nz * nw box with origin (x, y, z, w)
+  value_type minimum(size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // largest element in nx * ny * nz * nw box with origin (x, y, z, w)
+  value_type maximum(size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const array4& a) const { return dot(a, 0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // inner product with array a in nx * ny * nz * nw box with origin
+  // (x, y, z, w)
+  double dot(const array4& a, size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    if (a.nx != this->nx || a.ny != this->ny || a.nz != this->nz || a.nw != this->nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // scale all elements by a
+  void scale(value_type a) { cache.transform(zfp::internal::ScaleTransform<value_type>(a), 0); }
+
+  // add array x of the same dimensions
+  void add(const array4& x)
+  {
+    if (x.nx != nx || x.ny != ny || x.nz != nz || x.nw != nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AddTransform<value_type>(), &x.cache);
+  }
+
+  // add array x of the same dimensions scaled by a
+  void axpy(value_type a, const array4& x)
+  {
+    if (x.nx != nx || x.ny != ny || x.nz != nz || x.nw != nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::AxpyTransform<value_type>(a), &x.cache);
+  }
+
+  // interpolate linearly between this array (t = 0) and array x (t = 1)
+  void lerp(const array4& x, value_type t)
+  {
+    if (x.nx != nx || x.ny != ny || x.nz != nz || x.nw != nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    cache.transform(zfp::internal::LerpTransform<value_type>(t), &x.cache);
+  }
+
   // (i, j, k) accessors
   const_reference operator()(size_t i, size_t j, size_t k, size_t l) const { return const_reference(const_cast<container_type*>(this), i, j, k, l); }
   reference operator()(size_t i, size_t j, size_t k, size_t l) { return reference(this, i, j, k, l); }
@@ -268,6 +379,7 @@ protected:
   friend class zfp::internal::dim4::const_iterator<array4>;
   friend class zfp::internal::dim4::const_view<array4>;
   friend class zfp::internal::dim4::private_const_view<array4>;
+  friend class zfp::internal::dim4::const_tile<array4>;
   friend class zfp::internal::dim4::reference<array4>;
   friend class zfp::internal::dim4::pointer<array4>;
   friend class zfp::internal::dim4::iterator<array4>;
@@ -278,6 +390,9 @@ protected:
   friend class zfp::internal::dim4::nested_view3<array4>;
   friend class zfp::internal::dim4::nested_view4<array4>;
   friend class zfp::internal::dim4::private_view<array4>;
+  friend class zfp::internal::dim4::tile<array4>;
+  template <typename, class, class, class> friend class array4;
+  template <typename, class, class, class> friend class const_array4;
 
   // perform a deep copy
   void deep_copy(const array4& a)
@@ -305,10 +420,10 @@ protected:
 
   // mutators (called from proxy reference)
   void set(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.set(i, j, k, l, val); }
-  void add(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.ref(i, j, k, l) += val; }
-  void sub(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.ref(i, j, k, l) -= val; }
-  void mul(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.ref(i, j, k, l) *= val; }
-  void div(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.ref(i, j, k, l) /= val; }
+  void add(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.add(i, j, k, l, val); }
+  void sub(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.sub(i, j, k, l, val); }
+  void mul(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.mul(i, j, k, l, val); }
+  void div(size_t i, size_t j, size_t k, size_t l, value_type val) { cache.div(i, j, k, l, val); }
 
   // convert flat index to (i, j, k)
   void ijkl(size_t& i, size_t& j, size_t& k, size_t& l, size_t index) const
@@ -0,0 +1,302 @@
+#ifndef ZFP_CACHE_POLICY_HPP
+#define ZFP_CACHE_POLICY_HPP
+
+#include "zfp/internal/array/memory.hpp"
+
+namespace zfp {
+namespace cache_policy {
+
+// A cache policy maps each cache line index to one or more candidate slots
+// (ways) and selects which slot to replace on a miss.  Policies are given
+// the number of cache slots, a power of two no smaller than ways(), and may
+// maintain per-slot recency state.  All state associated with a line index
+// lives in slots guarded by its first guards() candidate slots, which allows
+// a shared cache to lock only those slots.
+
+// direct-mapped or two-way skew-associative (ZFP_WITH_CACHE_TWOWAY) ----------
+class direct {
+public:
+  // constructor
+  direct() : mask(0) {}
+
+  // byte size of policy data structure components indicated by mask
+  size_t size_bytes(uint mask = ZFP_DATA_ALL) const
+  {
+    size_t size = 0;
+    if (mask & ZFP_DATA_META)
+      size += sizeof(*this);
+    return size;
+  }
+
+  // number of candidate slots per line
+#ifdef ZFP_WITH_CACHE_TWOWAY
+  uint ways() const { return 2; }
+#else
+  uint ways() const { return 1; }
+#endif
+
+  // number of leading candidate slots that guard a line
+  uint guards() const { return ways(); }
+
+  // set number of cache slots
+  void resize(uint slots) { mask = slots - 1; }
+
+  // candidate slot for line x
+  uint slot(uint64 x, uint way) const { return way ? secondary(x) : uint(x & mask); }
+
+  // record access to slot
+  void touch(uint) {}
+
+  // slot to replace when line x is not cached; prefer primary and clean slots
+  template <class Tag>
+  uint victim(const Tag* tag, uint64 x)
+  {
+    uint i = slot(x, 0);
+#ifdef ZFP_WITH_CACHE_TWOWAY
+    uint j = slot(x, 1);
+    i = tag[j].used() && (!tag[i].dirty() || tag[j].dirty()) ? i : j;
+#else
+    static_cast<void>(tag);
+#endif
+    return i;
+  }
+
+protected:
+  uint secondary(uint64 x) const
+  {
+    // fold index into 32 bits
+    uint h = uint(x ^ (x >> 32));
+#ifdef ZFP_WITH_CACHE_FAST_HASH
+    // max entropy hash for 26- to 16-bit mapping (not full avalanche)
+    h -= h <<  7;
+    h ^= h >> 16;
+    h -= h <<  3;
+#else
+    // Jenkins hash; see http://burtleburtle.net/bob/hash/integer.html
+    h -= h <<  6;
+    h ^= h >> 17;
+    h -= h <<  9;
+    h ^= h <<  4;
+    h -= h <<  3;
+    h ^= h << 10;
+    h ^= h >> 15;
+#endif
+    return uint(h & mask);
+  }
+
+  uint mask; // slot mask
+};
+
+// base class for N-way set-associative policies ------------------------------
+template <uint N>
+class set_associative {
+public:
+  // number of candidate slots per line
+  uint ways() const { return N; }
+
+  // the first slot in a set guards the whole set
+  uint guards() const { return 1; }
+
+  // candidate slot for line x; the set of x holds the direct-mapped slot of x,
+  // so that runs of consecutive lines as long as the cache never conflict
+  uint slot(uint64 x, uint way) const { return N * uint((x / N) & mask) + way; }
+
+protected:
+  // ensure number of ways is a power of two
+  typedef char ways_must_be_power_of_two[N && !(N & (N - 1)) ? 1 : -1];
+
+  set_associative() : mask(0) {}
+
+  // set number of cache slots and return number of sets
+  uint resize(uint slots)
+  {
+    mask = slots / N - 1;
+    return mask + 1;
+  }
+
+  // unused slot in set of line x, if any, else N * sets
+  template <class Tag>
+  uint unused(const Tag* tag, uint64 x) const
+  {
+    uint i = slot(x, 0);
+    for (uint k = 0; k < N; k++)
+      if (!tag[i + k].used())
+        return i + k;
+    return N * (mask + 1);
+  }
+
+  uint mask; // set mask
+};
+
+// N-way set-associative with least recently used replacement -----------------
+template <uint N = 4>
+class lru : public set_associative<N> {
+public:
+  // constructor
+  lru() : stamp(0), count(0) {}
+
+  // copy constructor--performs a deep copy
+  lru(const lru& p) : set_associative<N>(p), stamp(0), count(0) { deep_copy(p); }
+
+  // destructor
+  ~lru()
+  {
+    zfp::internal::deallocate(stamp);
+    zfp::internal::deallocate(count);
+  }
+
+  // assignment operator--performs a deep copy
+  lru& operator=(const lru& p)
+  {
+    if (this != &p)
+      deep_copy(p);
+    return *this;
+  }
+
+  // byte size of policy data structure components indicated by mask
+  size_t size_bytes(uint mask = ZFP_DATA_ALL) const
+  {
+    size_t size = 0;
+    if (mask & ZFP_DATA_CACHE)
+      size += sets() * ((N + 1) * sizeof(uint64));
+    if (mask & ZFP_DATA_META)
+      size += sizeof(*this);
+    return size;
+  }
+
+  // set number of cache slots
+  void resize(uint slots)
+  {
+    uint sets = set_associative<N>::resize(slots);
+    zfp::internal::reallocate(stamp, sets * N * sizeof(*stamp));
+    zfp::internal::reallocate(count, sets * sizeof(*count));
+    std::fill(stamp, stamp + sets * N, uint64(0));
+    std::fill(count, count + sets, uint64(0));
+  }
+
+  // record access to slot
+  void touch(uint i) { stamp[i] = ++count[i / N]; }
+
+  // slot to replace when line x is not cached: unused or least recently used
+  template <class Tag>
+  uint victim(const Tag* tag, uint64 x)
+  {
+    uint i = this->unused(tag, x);
+    if (i == N * sets()) {
+      uint s = this->slot(x, 0);
+      i = s;
+      for (uint k = s + 1; k < s + N; k++)
+        if (stamp[k] < stamp[i])
+          i = k;
+    }
+    return i;
+  }
+
+protected:
+  using set_associative<N>::mask;
+
+  // number of sets
+  uint sets() const { return mask + 1; }
+
+  // perform a deep copy
+  void deep_copy(const lru& p)
+  {
+    set_associative<N>::operator=(p);
+    zfp::internal::clone(stamp, p.stamp, sets() * N);
+    zfp::internal::clone(count, p.count, sets());
+  }
+
+  uint64* stamp; // per-slot time of last access
+  uint64* count; // per-set access counter
+};
+
+// N-way set-associative with CLOCK (second chance) replacement ---------------
+template <uint N = 4>
+class clock : public set_associative<N> {
+public:
+  // constructor
+  clock() : ref(0), hand(0) {}
+
+  // copy constructor--performs a deep copy
+  clock(const clock& p) : set_associative<N>(p), ref(0), hand(0) { deep_copy(p); }
+
+  // destructor
+  ~clock()
+  {
+    zfp::internal::deallocate(ref);
+    zfp::internal::deallocate(hand);
+  }
+
+  // assignment operator--performs a deep copy
+  clock& operator=(const clock& p)
+  {
+    if (this != &p)
+      deep_copy(p);
+    return *this;
+  }
+
+  // byte size of policy data structure components indicated by mask
+  size_t size_bytes(uint mask = ZFP_DATA_ALL) const
+  {
+    size_t size = 0;
+    if (mask & ZFP_DATA_CACHE)
+      size += sets() * (N * sizeof(*ref) + sizeof(*hand));
+    if (mask & ZFP_DATA_META)
+      size += sizeof(*this);
+    return size;
+  }
+
+  // set number of cache slots
+  void resize(uint slots)
+  {
+    uint sets = set_associative<N>::resize(slots);
+    zfp::internal::reallocate(ref, sets * N * sizeof(*ref));
+    zfp::internal::reallocate(hand, sets * sizeof(*hand));
+    std::fill(ref, ref + sets * N, uchar(0));
+    std::fill(hand, hand + sets, uint(0));
+  }
+
+  // record access to slot
+  void touch(uint i) { ref[i] = 1; }
+
+  // slot to replace when line x is not cached: unused or first slot at or
+  // after the clock hand not referenced since the hand last passed it
+  template <class Tag>
+  uint victim(const Tag* tag, uint64 x)
+  {
+    uint i = this->unused(tag, x);
+    if (i == N * sets()) {
+      uint s = this->slot(x, 0);
+      uint& h = hand[s / N];
+      while (ref[s + h]) {
+        ref[s + h] = 0;
+        h = (h + 1) % N;
+      }
+      i = s + h;
+      h = (h + 1) % N;
+    }
+    return i;
+  }
+
+protected:
+  using set_associative<N>::mask;
+
+  // number of sets
+  uint sets() const { return mask + 1; }
+
+  // perform a deep copy
+  void deep_copy(const clock& p)
+  {
+    set_associative<N>::operator=(p);
+    zfp::internal::clone(ref, p.ref, sets() * N);
+    zfp::internal::clone(hand, p.hand, sets());
+  }
+
+  uchar* ref;  // per-slot reference bit
+  uint* hand;  // per-set clock hand
+};
+
+} // cache_policy
+} // zfp
+
+#endif
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <climits>
 #include <cstring>
+#include <limits>
 #include "zfp.h"
 #include "zfp/internal/array/memory.hpp"
 #include "zfp/internal/array/traits.hpp"
@@ -122,6 +123,9 @@ public:
   // set thread safety mode (not required by this codec)
   void set_thread_safety(bool) {}
 
+  // upper bound on magnitude of values in block (none is known)
+  ExternalType block_bound(bitstream_offset) const { return std::numeric_limits<ExternalType>::infinity(); }
+
   // byte size of codec data structure components indicated by mask
   size_t size_bytes(uint mask = ZFP_DATA_ALL) const
   {
@@ -3,7 +3,9 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstring>
+#include <limits>
 #include "zfp.h"
 #include "zfp.hpp"
 #include "zfp/internal/array/memory.hpp"
@@ -104,6 +106,22 @@ public:
   void set_thread_safety(bool) {}
 #endif
 
+  // upper bound on magnitude of values decoded from block at given offset,
+  // inferred from its common exponent without decoding the block; infinity
+  // if no bound is known
+  Scalar block_bound(bitstream_offset offset) const
+  {
+    if (thread_safety) {
+      // make a thread-local copy of zfp stream and bit stream
+      zfp_stream zfp = clone_stream();
+      Scalar bound = block_bound(&zfp, offset);
+      stream_close(zfp.stream);
+      return bound;
+    }
+    else
+      return block_bound(stream, offset);
+  }
+
   // byte size of codec data structure components indicated by mask
   size_t size_bytes(uint mask = ZFP_DATA_ALL) const
   {
@@ -127,7 +145,7 @@ protected:
   // deep copy
   void deep_copy(const zfp_base& codec)
   {
-    stream = zfp_stream_open(0);
+    close();
     *stream = *codec.stream;
     stream->stream = 0;
 #ifdef _OPENMP
@@ -171,6 +189,27 @@ protected:
       return decode_block(stream, offset, block);
   }
 
+  // upper bound on magnitude of values in block at given offset
+  static Scalar block_bound(zfp_stream* zfp, bitstream_offset offset)
+  {
+    // number of exponent bits and exponent bias (e.g., 11 and 1023 for double)
+    const int ebias = std::numeric_limits<Scalar>::max_exponent - 1;
+    const uint ebits = ebias < 0x80 ? 8 : 11;
+    stream_rseek(zfp->stream, offset);
+    // leading zero bit indicates an all-zero block
+    if (!stream_read_bit(zfp->stream))
+      return 0;
+    if (zfp_stream_compression_mode(zfp) == zfp_mode_reversible) {
+      // reinterpreted values are not bounded
+      if (stream_read_bit(zfp->stream))
+        return std::numeric_limits<Scalar>::infinity();
+      // losslessly reconstructed values satisfy |x| < 2^emax
+      return std::ldexp(Scalar(1), int(stream_read_bits(zfp->stream, ebits)) - ebias);
+    }
+    // decoded values are p-bit integers scaled by 2^(emax + 2 - p)
+    return std::ldexp(Scalar(1), int(stream_read_bits(zfp->stream, ebits)) - ebias + 1);
+  }
+
   // encode full contiguous block
   static size_t encode_block(zfp_stream* zfp, bitstream_offset offset, const Scalar* block)
   {
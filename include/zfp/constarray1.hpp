@@ -5,14 +5,17 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache1.hpp"
 #include "zfp/internal/array/handle1.hpp"
 #include "zfp/internal/array/iterator1.hpp"
 #include "zfp/internal/array/pointer1.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference1.hpp"
 #include "zfp/internal/array/store1.hpp"
+#include "zfp/internal/array/tile1.hpp"
 #include "zfp/internal/array/view1.hpp"
 
 namespace zfp {
@@ -21,7 +24,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp1<Scalar>,
-  class Index = zfp::index::hybrid4
+  class Index = zfp::index::hybrid4,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class const_array1 : public array {
 public:
@@ -30,8 +34,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore1<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache1<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache1<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,6 +45,7 @@ public:
   typedef zfp::internal::dim1::const_iterator<const_array1> const_iterator;
   typedef zfp::internal::dim1::const_view<const_array1> const_view;
   typedef zfp::internal::dim1::private_const_view<const_array1> private_const_view;
+  typedef zfp::internal::dim1::const_tile<const_array1> const_tile;
 
   // default constructor
   const_array1() :
@@ -58,6 +64,22 @@ public:
     set(p);
   }
 
+  // constructor of nx-element array using given configuration and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file); the array is zero-initialized if clear
+  // is set and otherwise assumed to hold previously compressed fixed-rate data
+  const_array1(size_t nx, const zfp_config& config, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(1, Codec::type),
+    store(nx, config, buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+    if (clear)
+      set(0);
+    else if (config.mode != zfp_mode_fixed_rate)
+      throw zfp::exception("zfp array requires fixed-rate mode to reuse compressed data");
+  }
+
   // copy constructor--performs a deep copy
   const_array1(const const_array1& a) :
     cache(store)
@@ -79,6 +101,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
 
@@ -181,14 +206,23 @@ public:
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
     const ptrdiff_t sx = 1;
-    size_t block_index = 0;
-    for (size_t i = 0; i < bx; i++, p += 4)
-      cache.get_block(block_index++, p, sx);
+    cache.get_blocks(p, sx);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -201,8 +235,7 @@ public:
     if (p) {
       // compress data stored at p
       const ptrdiff_t sx = 1;
-      for (size_t i = 0; i < bx; i++, p += 4)
-        store.encode(block_index++, p, sx);
+      store.encode_all(p, sx);
     }
     else {
       // zero-initialize array
@@ -215,6 +248,69 @@ public:
       store.compact();
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a, bool compact = true)
+  {
+    if (a.size_x() != nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) == static_cast<const void*>(this))
+      return;
+    store.clear();
+    cache.put_blocks(a.cache);
+    store.flush();
+    if (compact)
+      store.compact();
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, nx); }
+
+  // sum of elements in range [x, x + nx)
+  double sum(size_t x, size_t nx) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, nx);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, nx); }
+
+  // smallest element in range [x, x + nx)
+  value_type minimum(size_t x, size_t nx) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, nx);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, nx); }
+
+  // largest element in range [x, x + nx)
+  value_type maximum(size_t x, size_t nx) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, nx);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const const_array1& a) const { return dot(a, 0, nx); }
+
+  // inner product with array a in range [x, x + nx)
+  double dot(const const_array1& a, size_t x, size_t nx) const
+  {
+    if (a.nx != this->nx)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, nx);
+    return r.value;
+  }
+
   // accessor
   const_reference operator()(size_t i) const { return const_reference(const_cast<container_type*>(this), i); }
 
@@ -234,6 +330,9 @@ protected:
   friend class zfp::internal::dim1::const_iterator<const_array1>;
   friend class zfp::internal::dim1::const_view<const_array1>;
   friend class zfp::internal::dim1::private_const_view<const_array1>;
+  friend class zfp::internal::dim1::const_tile<const_array1>;
+  template <typename, class, class, class> friend class array1;
+  template <typename, class, class, class> friend class const_array1;
 
   // perform a deep copy
   void deep_copy(const const_array1& a)
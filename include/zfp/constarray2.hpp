@@ -5,14 +5,17 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache2.hpp"
 #include "zfp/internal/array/handle2.hpp"
 #include "zfp/internal/array/iterator2.hpp"
 #include "zfp/internal/array/pointer2.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference2.hpp"
 #include "zfp/internal/array/store2.hpp"
+#include "zfp/internal/array/tile2.hpp"
 #include "zfp/internal/array/view2.hpp"
 
 namespace zfp {
@@ -21,7 +24,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp2<Scalar>,
-  class Index = zfp::index::hybrid4
+  class Index = zfp::index::hybrid4,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class const_array2 : public array {
 public:
@@ -30,8 +34,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore2<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache2<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache2<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,6 +45,7 @@ public:
   typedef zfp::internal::dim2::const_iterator<const_array2> const_iterator;
   typedef zfp::internal::dim2::const_view<const_array2> const_view;
   typedef zfp::internal::dim2::private_const_view<const_array2> private_const_view;
+  typedef zfp::internal::dim2::const_tile<const_array2> const_tile;
 
   // default constructor
   const_array2() :
@@ -59,6 +65,23 @@ public:
     set(p);
   }
 
+  // constructor of nx * ny array using given configuration and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file); the array is zero-initialized if clear
+  // is set and otherwise assumed to hold previously compressed fixed-rate data
+  const_array2(size_t nx, size_t ny, const zfp_config& config, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(2, Codec::type),
+    store(nx, ny, config, buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+    this->ny = ny;
+    if (clear)
+      set(0);
+    else if (config.mode != zfp_mode_fixed_rate)
+      throw zfp::exception("zfp array requires fixed-rate mode to reuse compressed data");
+  }
+
   // copy constructor--performs a deep copy
   const_array2(const const_array2& a) :
     cache(store)
@@ -80,6 +103,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx * ny; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
   size_t size_y() const { return ny; }
@@ -184,17 +210,24 @@ public:
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
     const ptrdiff_t sx = 1;
     const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
-    size_t block_index = 0;
-    for (size_t j = 0; j < by; j++, p += 4 * sx * (nx - bx))
-      for (size_t i = 0; i < bx; i++, p += 4)
-        cache.get_block(block_index++, p, sx, sy);
+    cache.get_blocks(p, sx, sy);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -209,9 +242,7 @@ public:
       // compress data stored at p
       const ptrdiff_t sx = 1;
       const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
-      for (size_t j = 0; j < by; j++, p += 4 * sx * (nx - bx))
-        for (size_t i = 0; i < bx; i++, p += 4)
-          store.encode(block_index++, p, sx, sy);
+      store.encode_all(p, sx, sy);
     }
     else {
       // zero-initialize array
@@ -224,6 +255,69 @@ public:
       store.compact();
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a, bool compact = true)
+  {
+    if (a.size_x() != nx || a.size_y() != ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) == static_cast<const void*>(this))
+      return;
+    store.clear();
+    cache.put_blocks(a.cache);
+    store.flush();
+    if (compact)
+      store.compact();
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, 0, nx, ny); }
+
+  // sum of elements in nx * ny box with origin (x, y)
+  double sum(size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, y, nx, ny);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, 0, nx, ny); }
+
+  // smallest element in nx * ny box with origin (x, y)
+  value_type minimum(size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, y, nx, ny);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, 0, nx, ny); }
+
+  // largest element in nx * ny box with origin (x, y)
+  value_type maximum(size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, y, nx, ny);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const const_array2& a) const { return dot(a, 0, 0, nx, ny); }
+
+  // inner product with array a in nx * ny box with origin (x, y)
+  double dot(const const_array2& a, size_t x, size_t y, size_t nx, size_t ny) const
+  {
+    if (a.nx != this->nx || a.ny != this->ny)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, y, nx, ny);
+    return r.value;
+  }
+
   // (i, j) accessor
   const_reference operator()(size_t i, size_t j) const { return const_reference(const_cast<container_type*>(this), i, j); }
 
@@ -248,6 +342,9 @@ protected:
   friend class zfp::internal::dim2::const_iterator<const_array2>;
   friend class zfp::internal::dim2::const_view<const_array2>;
   friend class zfp::internal::dim2::private_const_view<const_array2>;
+  friend class zfp::internal::dim2::const_tile<const_array2>;
+  template <typename, class, class, class> friend class array2;
+  template <typename, class, class, class> friend class const_array2;
 
   // perform a deep copy
   void deep_copy(const const_array2& a)
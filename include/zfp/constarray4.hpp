@@ -5,14 +5,17 @@
 #include <cstring>
 #include <iterator>
 #include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/index.hpp"
 #include "zfp/codec/zfpcodec.hpp"
 #include "zfp/internal/array/cache4.hpp"
 #include "zfp/internal/array/handle4.hpp"
 #include "zfp/internal/array/iterator4.hpp"
 #include "zfp/internal/array/pointer4.hpp"
+#include "zfp/internal/array/reduce.hpp"
 #include "zfp/internal/array/reference4.hpp"
 #include "zfp/internal/array/store4.hpp"
+#include "zfp/internal/array/tile4.hpp"
 #include "zfp/internal/array/view4.hpp"
 
 namespace zfp {
@@ -21,7 +24,8 @@ namespace zfp {
 template <
   typename Scalar,
   class Codec = zfp::codec::zfp4<Scalar>,
-  class Index = zfp::index::hybrid4
+  class Index = zfp::index::hybrid4,
+  class CachePolicy = zfp::cache_policy::direct
 >
 class const_array4 : public array {
 public:
@@ -30,8 +34,9 @@ public:
   typedef Scalar value_type;
   typedef Codec codec_type;
   typedef Index index_type;
+  typedef CachePolicy cache_policy_type;
   typedef zfp::internal::BlockStore4<value_type, codec_type, index_type> store_type;
-  typedef zfp::internal::BlockCache4<value_type, store_type> cache_type;
+  typedef zfp::internal::BlockCache4<value_type, store_type, cache_policy_type> cache_type;
   typedef typename Codec::header header;
 
   // accessor classes
@@ -40,6 +45,7 @@ public:
   typedef zfp::internal::dim4::const_iterator<const_array4> const_iterator;
   typedef zfp::internal::dim4::const_view<const_array4> const_view;
   typedef zfp::internal::dim4::private_const_view<const_array4> private_const_view;
+  typedef zfp::internal::dim4::const_tile<const_array4> const_tile;
 
   // default constructor
   const_array4() :
@@ -61,6 +67,25 @@ public:
     set(p);
   }
 
+  // constructor of nx * ny * nz * nw array using given configuration and at least
+  // cache_size bytes of cache whose compressed data resides in caller-managed
+  // buffer (e.g., memory-mapped file); the array is zero-initialized if clear
+  // is set and otherwise assumed to hold previously compressed fixed-rate data
+  const_array4(size_t nx, size_t ny, size_t nz, size_t nw, const zfp_config& config, void* buffer, size_t buffer_size_bytes, bool clear, size_t cache_size = 0) :
+    array(4, Codec::type),
+    store(nx, ny, nz, nw, config, buffer, buffer_size_bytes, clear),
+    cache(store, cache_size)
+  {
+    this->nx = nx;
+    this->ny = ny;
+    this->nz = nz;
+    this->nw = nw;
+    if (clear)
+      set(0);
+    else if (config.mode != zfp_mode_fixed_rate)
+      throw zfp::exception("zfp array requires fixed-rate mode to reuse compressed data");
+  }
+
   // copy constructor--performs a deep copy
   const_array4(const const_array4& a) :
     cache(store)
@@ -82,6 +107,9 @@ public:
   // total number of elements in array
   size_t size() const { return nx * ny * nz * nw; }
 
+  // number of blocks, e.g., for traversing the array by tiles
+  size_t blocks() const { return store.blocks(); }
+
   // array dimensions
   size_t size_x() const { return nx; }
   size_t size_y() const { return ny; }
@@ -190,23 +218,26 @@ public:
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics cache_stats() const { return cache.statistics(); }
+
+  // reset cache statistics to zero
+  void reset_cache_stats() const { cache.reset_statistics(); }
+
+  // number of blocks decoded ahead of a block that is not cached
+  uint cache_prefetch() const { return cache.prefetch(); }
+
+  // set number of blocks (at most 64) to decode ahead on cache misses
+  void set_cache_prefetch(uint blocks) { cache.set_prefetch(blocks); }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
-    const size_t bz = store.block_size_z();
-    const size_t bw = store.block_size_w();
     const ptrdiff_t sx = 1;
     const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
     const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
     const ptrdiff_t sw = static_cast<ptrdiff_t>(nx * ny * nz);
-    size_t block_index = 0;
-    for (size_t l = 0; l < bw; l++, p += 4 * sz * (nz - bz))
-      for (size_t k = 0; k < bz; k++, p += 4 * sy * (ny - by))
-        for (size_t j = 0; j < by; j++, p += 4 * sx * (nx - bx))
-          for (size_t i = 0; i < bx; i++, p += 4)
-            cache.get_block(block_index++, p, sx, sy, sz, sw);
+    cache.get_blocks(p, sx, sy, sz, sw);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -225,11 +256,7 @@ public:
       const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
       const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
       const ptrdiff_t sw = static_cast<ptrdiff_t>(nx * ny * nz);
-      for (size_t l = 0; l < bw; l++, p += 4 * sz * (nz - bz))
-        for (size_t k = 0; k < bz; k++, p += 4 * sy * (ny - by))
-          for (size_t j = 0; j < by; j++, p += 4 * sx * (nx - bx))
-            for (size_t i = 0; i < bx; i++, p += 4)
-              store.encode(block_index++, p, sx, sy, sz, sw);
+      store.encode_all(p, sx, sy, sz, sw);
     }
     else {
       // zero-initialize array
@@ -242,6 +269,70 @@ public:
       store.compact();
   }
 
+  // initialize array from array a of the same dimensions, possibly of another
+  // scalar type, codec, or array class, by decompressing each block of a once
+  // and compressing it into this array, in parallel when compiled with OpenMP
+  template <class Array>
+  void convert(const Array& a, bool compact = true)
+  {
+    if (a.size_x() != nx || a.size_y() != ny || a.size_z() != nz || a.size_w() != nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    if (static_cast<const void*>(&a) == static_cast<const void*>(this))
+      return;
+    store.clear();
+    cache.put_blocks(a.cache);
+    store.flush();
+    if (compact)
+      store.compact();
+  }
+
+  // sum of all elements
+  double sum() const { return sum(0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // sum of elements in nx * ny * nz * nw box with origin (x, y, z, w)
+  double sum(size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    zfp::internal::SumReduction<value_type> r;
+    cache.reduce(r, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // smallest element (infinity if array is empty)
+  value_type minimum() const { return minimum(0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // smallest element in nx * ny * nz * nw box with origin (x, y, z, w)
+  value_type minimum(size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    zfp::internal::MinReduction<value_type> r;
+    cache.reduce(r, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // largest element (minus infinity if array is empty)
+  value_type maximum() const { return maximum(0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // largest element in nx * ny * nz * nw box with origin (x, y, z, w)
+  value_type maximum(size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    zfp::internal::MaxReduction<value_type> r;
+    cache.reduce(r, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
+  // inner product with array a of the same dimensions
+  double dot(const const_array4& a) const { return dot(a, 0, 0, 0, 0, nx, ny, nz, nw); }
+
+  // inner product with array a in nx * ny * nz * nw box with origin
+  // (x, y, z, w)
+  double dot(const const_array4& a, size_t x, size_t y, size_t z, size_t w, size_t nx, size_t ny, size_t nz, size_t nw) const
+  {
+    if (a.nx != this->nx || a.ny != this->ny || a.nz != this->nz || a.nw != this->nw)
+      throw zfp::exception("zfp array dimensions do not match");
+    zfp::internal::DotReduction<value_type> r;
+    cache.reduce(r, a.cache, x, y, z, w, nx, ny, nz, nw);
+    return r.value;
+  }
+
   // (i, j, k, l) accessor
   const_reference operator()(size_t i, size_t j, size_t k, size_t l) const { return const_reference(const_cast<container_type*>(this), i, j, k, l); }
 
@@ -266,6 +357,9 @@ protected:
   friend class zfp::internal::dim4::const_iterator<const_array4>;
   friend class zfp::internal::dim4::const_view<const_array4>;
   friend class zfp::internal::dim4::private_const_view<const_array4>;
+  friend class zfp::internal::dim4::const_tile<const_array4>;
+  template <typename, class, class, class> friend class array4;
+  template <typename, class, class, class> friend class const_array4;
 
   // perform a deep copy
   void deep_copy(const const_array4& a)
@@ -1,6 +1,10 @@
 #ifndef ZFP_CACHE_HPP
 #define ZFP_CACHE_HPP
 
+#include <ctime>
+#include <vector>
+#include "zfp/array.hpp"
+#include "zfp/cachepolicy.hpp"
 #include "zfp/internal/array/memory.hpp"
 
 #ifdef ZFP_WITH_CACHE_PROFILE
@@ -8,16 +12,86 @@
   #include <iostream>
 #endif
 
+#ifdef _OPENMP
+  // guard cache lines shared among threads with locks; time (de)compression
+  #include <omp.h>
+#elif defined(__unix__) || defined(__APPLE__)
+  // time (de)compression
+  #include <sys/time.h>
+#endif
+
 namespace zfp {
 namespace internal {
 
-// direct-mapped or two-way skew-associative write-back cache
-template <class Line>
-class Cache {
+// running statistics on cache accesses and block (de)compression
+class CacheStats {
 public:
-  // cache line index (zero is reserved for unused lines)
-  typedef uint Index;
+  CacheStats() { reset(); }
+
+  // current statistics
+  zfp::cache_statistics get() const { return stats; }
+
+  // reset all statistics to zero
+  void reset()
+  {
+    stats.hits = stats.misses = stats.writebacks = 0;
+    stats.decode_time = stats.encode_time = 0;
+  }
+
+  // record cache hit or miss
+  void access(bool hit) { add(hit ? stats.hits : stats.misses, uint64(1)); }
+
+  // record given numbers of cache hits and misses
+  void access(uint64 hits, uint64 misses)
+  {
+    add(stats.hits, hits);
+    add(stats.misses, misses);
+  }
+
+  // record decompression of block started at time t
+  void decoded(double t) { add(stats.decode_time, now() - t); }
+
+  // record compression of given number of blocks started at time t
+  void encoded(double t, uint64 blocks = 1)
+  {
+    add(stats.writebacks, blocks);
+    add(stats.encode_time, now() - t);
+  }
+
+  // wall clock time in seconds
+  static double now()
+  {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#elif defined(__unix__) || defined(__APPLE__)
+    timeval t;
+    gettimeofday(&t, 0);
+    return double(t.tv_sec) + 1e-6 * double(t.tv_usec);
+#else
+    return double(std::clock()) / CLOCKS_PER_SEC;
+#endif
+  }
+
+protected:
+  // increment statistic; atomically if cache is shared among threads
+  template <typename T>
+  static void add(T& x, T y)
+  {
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    #pragma omp atomic
+#endif
+    x += y;
+  }
+
+  zfp::cache_statistics stats; // accumulated statistics
+};
 
+// write-back cache whose lines are identified by integers of type Index (zero
+// is reserved for unused lines) and whose associativity and replacement are
+// determined by Policy
+template <class Line, typename Index = size_t, class Policy = zfp::cache_policy::direct>
+class Cache {
+public:
   // cache tag containing line meta data
   class Tag {
   public:
@@ -89,6 +163,9 @@ public:
 
   // allocate cache with at least minsize lines
   Cache(uint minsize = 0) : mask(0), tag(0), line(0)
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    , locks(0)
+#endif
   {
     resize(minsize);
 #ifdef ZFP_WITH_CACHE_PROFILE
@@ -100,6 +177,9 @@ public:
 
   // copy constructor--performs a deep copy
   Cache(const Cache& c) : tag(0), line(0)
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    , locks(0)
+#endif
   {
     deep_copy(c);
   }
@@ -107,6 +187,7 @@ public:
   // destructor
   ~Cache()
   {
+    free_locks();
     zfp::internal::deallocate_aligned(tag);
     zfp::internal::deallocate_aligned(line);
 #ifdef ZFP_WITH_CACHE_PROFILE
@@ -129,6 +210,7 @@ public:
     size_t size = 0;
     if (mask & ZFP_DATA_CACHE)
       size += this->size() * (sizeof(*tag) + sizeof(*line));
+    size += policy.size_bytes(mask & ~ZFP_DATA_META);
     if (mask & ZFP_DATA_META)
       size += sizeof(*this);
     return size;
@@ -140,31 +222,80 @@ public:
   // change cache size to at least minsize lines (all contents will be lost)
   void resize(uint minsize)
   {
+    free_locks();
     // compute smallest value of mask such that mask + 1 = 2^k >= minsize
     for (mask = minsize ? minsize - 1 : 1; mask & (mask + 1); mask |= mask + 1);
+    // ensure there is at least one set of lines
+    while (mask + 1 < policy.ways())
+      mask = 2 * mask + 1;
     zfp::internal::reallocate_aligned(tag, size() * sizeof(Tag), ZFP_MEMORY_ALIGNMENT);
     zfp::internal::reallocate_aligned(line, size() * sizeof(Line), ZFP_MEMORY_ALIGNMENT);
+    policy.resize(size());
+    alloc_locks();
     clear();
   }
 
+  // acquire exclusive access to the slots that may hold line #x; the line
+  // may be looked up, accessed, and replaced only while the lock is held
+  void lock(Index x)
+  {
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    uint i = policy.slot(x, 0);
+    if (policy.guards() > 1) {
+      // acquire locks in ascending order to avoid deadlock
+      uint j = policy.slot(x, 1);
+      if (i != j) {
+        omp_set_lock(locks + std::min(i, j));
+        i = std::max(i, j);
+      }
+    }
+    omp_set_lock(locks + i);
+#else
+    (void)x;
+#endif
+  }
+
+  // release exclusive access acquired by lock(x)
+  void unlock(Index x)
+  {
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    uint i = policy.slot(x, 0);
+    if (policy.guards() > 1) {
+      uint j = policy.slot(x, 1);
+      if (i != j)
+        omp_unset_lock(locks + j);
+    }
+    omp_unset_lock(locks + i);
+#else
+    (void)x;
+#endif
+  }
+
   // look up cache line #x and return pointer to it if in the cache;
   // otherwise return null
   Line* lookup(Index x, bool write)
   {
-    uint i = primary(x);
-    if (tag[i].index() == x) {
-      if (write)
-        tag[i].mark();
-      return line + i;
+    for (uint k = 0; k < policy.ways(); k++) {
+      uint i = policy.slot(x, k);
+      if (tag[i].index() == x) {
+        if (write)
+          tag[i].mark();
+        policy.touch(i);
+        return line + i;
+      }
     }
-#ifdef ZFP_WITH_CACHE_TWOWAY
-    uint j = secondary(x);
-    if (tag[j].index() == x) {
-      if (write)
-        tag[i].mark();
-      return line + j;
+    return 0;
+  }
+
+  // return pointer to cache line #x if in the cache, otherwise null; unlike
+  // lookup, the access is not recorded by the replacement policy
+  Line* find(Index x) const
+  {
+    for (uint k = 0; k < policy.ways(); k++) {
+      uint i = policy.slot(x, k);
+      if (tag[i].index() == x)
+        return line + i;
     }
-#endif
     return 0;
   }
 
@@ -173,36 +304,28 @@ public:
   // write-back (if the line is in use) and then fetch the requested line
   Tag access(Line*& ptr, Index x, bool write)
   {
-    uint i = primary(x);
-    if (tag[i].index() == x) {
-      ptr = line + i;
-      if (write)
-        tag[i].mark();
-#ifdef ZFP_WITH_CACHE_PROFILE
-      hit[0][write]++;
-#endif
-      return tag[i];
-    }
-#ifdef ZFP_WITH_CACHE_TWOWAY
-    uint j = secondary(x);
-    if (tag[j].index() == x) {
-      ptr = line + j;
-      if (write)
-        tag[j].mark();
+    for (uint k = 0; k < policy.ways(); k++) {
+      uint i = policy.slot(x, k);
+      if (tag[i].index() == x) {
+        ptr = line + i;
+        if (write)
+          tag[i].mark();
+        policy.touch(i);
 #ifdef ZFP_WITH_CACHE_PROFILE
-      hit[1][write]++;
+        hit[k ? 1 : 0][write]++;
 #endif
-      return tag[j];
+        return tag[i];
+      }
     }
-    // cache line not found; prefer primary and not dirty slots
-    i = tag[j].used() && (!tag[i].dirty() || tag[j].dirty()) ? i : j;
-#endif
+    // cache line not found; let policy choose slot to replace
+    uint i = policy.victim(tag, x);
     ptr = line + i;
     Tag t = tag[i];
     tag[i] = Tag(x, write);
+    policy.touch(i);
 #ifdef ZFP_WITH_CACHE_PROFILE
     miss[write]++;
-    if (tag[i].dirty())
+    if (t.dirty())
       back[write]++;
 #endif
     return t;
@@ -229,9 +352,12 @@ protected:
   // perform a deep copy
   void deep_copy(const Cache& c)
   {
+    free_locks();
     mask = c.mask;
     zfp::internal::clone_aligned(tag, c.tag, size(), ZFP_MEMORY_ALIGNMENT);
     zfp::internal::clone_aligned(line, c.line, size(), ZFP_MEMORY_ALIGNMENT);
+    policy = c.policy;
+    alloc_locks();
 #ifdef ZFP_WITH_CACHE_PROFILE
     hit[0][0] = c.hit[0][0];
     hit[0][1] = c.hit[0][1];
@@ -244,32 +370,38 @@ protected:
 #endif
   }
 
-  uint primary(Index x) const { return x & mask; }
-  uint secondary(Index x) const
+  // allocate and initialize one lock per cache line
+  void alloc_locks()
   {
-#ifdef ZFP_WITH_CACHE_FAST_HASH
-    // max entropy hash for 26- to 16-bit mapping (not full avalanche)
-    x -= x <<  7;
-    x ^= x >> 16;
-    x -= x <<  3;
-#else
-    // Jenkins hash; see http://burtleburtle.net/bob/hash/integer.html
-    x -= x <<  6;
-    x ^= x >> 17;
-    x -= x <<  9;
-    x ^= x <<  4;
-    x -= x <<  3;
-    x ^= x << 10;
-    x ^= x >> 15;
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    zfp::internal::reallocate(locks, size() * sizeof(omp_lock_t));
+    for (uint i = 0; i <= mask; i++)
+      omp_init_lock(locks + i);
 #endif
-    return x & mask;
   }
 
-  Index mask; // cache line mask
-  Tag* tag;   // cache line tags
-  Line* line; // actual decompressed cache lines
+  // destroy and deallocate locks
+  void free_locks()
+  {
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+    if (locks) {
+      for (uint i = 0; i <= mask; i++)
+        omp_destroy_lock(locks + i);
+      zfp::internal::deallocate(locks);
+      locks = 0;
+    }
+#endif
+  }
+
+  Index mask;    // cache line mask
+  Tag* tag;      // cache line tags
+  Line* line;    // actual decompressed cache lines
+  Policy policy; // associativity and replacement policy
+#if defined(ZFP_WITH_CACHE_SHARED) && defined(_OPENMP)
+  omp_lock_t* locks; // one lock per cache line
+#endif
 #ifdef ZFP_WITH_CACHE_PROFILE
-  uint64 hit[2][2]; // number of primary/secondary read/write hits
+  uint64 hit[2][2]; // number of first/other way read/write hits
   uint64 miss[2];   // number of read/write misses
   uint64 back[2];   // number of write-backs due to read/writes
 #endif
@@ -6,13 +6,14 @@
 namespace zfp {
 namespace internal {
 
-template <typename Scalar, class Store>
+template <typename Scalar, class Store, class Policy = zfp::cache_policy::direct>
 class BlockCache1 {
 public:
   // constructor of cache of given size
   BlockCache1(Store& store, size_t bytes = 0) :
     cache(lines(bytes, store.blocks())),
-    store(store)
+    store(store),
+    ahead(0)
   {}
 
   // byte size of cache data structure components indicated by mask
@@ -41,60 +42,256 @@ public:
   // flush cache by compressing all modified cached blocks
   void flush() const
   {
-    for (typename zfp::internal::Cache<CacheLine>::const_iterator p = cache.first(); p; p++) {
+    for (typename zfp::internal::Cache<CacheLine, size_t, Policy>::const_iterator p = cache.first(); p; p++) {
       if (p->tag.dirty()) {
         size_t block_index = p->tag.index() - 1;
-        store.encode(block_index, p->line->data());
+        encode(block_index, p->line->data());
       }
       cache.flush(p->line);
     }
   }
 
   // perform a deep copy
-  void deep_copy(const BlockCache1& c) { cache = c.cache; }
+  void deep_copy(const BlockCache1& c)
+  {
+    cache = c.cache;
+    stats = c.stats;
+    ahead = c.ahead;
+  }
+
+  // statistics on cache accesses and block (de)compression
+  zfp::cache_statistics statistics() const { return stats.get(); }
+
+  // reset cache statistics
+  void reset_statistics() const { stats.reset(); }
+
+  // number of blocks decoded ahead of a missed block
+  uint prefetch() const { return ahead; }
+
+  // set number of blocks (at most 64) to decode ahead of a missed block
+  void set_prefetch(uint blocks) { ahead = std::min(blocks, uint(max_prefetch)); }
 
   // inspector
   Scalar get(size_t i) const
   {
+    lock(i);
     const CacheLine* p = line(i, false);
-    return (*p)(i);
+    Scalar val = (*p)(i);
+    unlock(i);
+    return val;
   }
 
   // mutator
   void set(size_t i, Scalar val)
   {
+    lock(i);
     CacheLine* p = line(i, true);
     (*p)(i) = val;
+    unlock(i);
   }
 
-  // reference to cached element
-  Scalar& ref(size_t i)
-  {
-    CacheLine* p = line(i, true);
-    return (*p)(i);
-  }
+  // compound assignment mutators
+  void add(size_t i, Scalar val) { lock(i); (*line(i, true))(i) += val; unlock(i); }
+  void sub(size_t i, Scalar val) { lock(i); (*line(i, true))(i) -= val; unlock(i); }
+  void mul(size_t i, Scalar val) { lock(i); (*line(i, true))(i) *= val; unlock(i); }
+  void div(size_t i, Scalar val) { lock(i); (*line(i, true))(i) /= val; unlock(i); }
 
   // read-no-allocate: copy block from cache on hit, else from store without caching
   void get_block(size_t block_index, Scalar* p, ptrdiff_t sx) const
   {
-    const CacheLine* line = cache.lookup((uint)block_index + 1, false);
+    cache.lock(block_index + 1);
+    const CacheLine* line = cache.lookup(block_index + 1, false);
+    stats.access(line != 0);
     if (line)
       line->get(p, sx, store.block_shape(block_index));
-    else
+    else {
+      double t = CacheStats::now();
       store.decode(block_index, p, sx);
+      stats.decoded(t);
+    }
+    cache.unlock(block_index + 1);
   }
 
   // write-no-allocate: copy block to cache on hit, else to store without caching
   void put_block(size_t block_index, const Scalar* p, ptrdiff_t sx)
   {
-    CacheLine* line = cache.lookup((uint)block_index + 1, true);
+    cache.lock(block_index + 1);
+    CacheLine* line = cache.lookup(block_index + 1, true);
+    stats.access(line != 0);
     if (line)
       line->put(p, sx, store.block_shape(block_index));
-    else
+    else {
+      double t = CacheStats::now();
       store.encode(block_index, p, sx);
+      stats.encoded(t);
+    }
+    cache.unlock(block_index + 1);
+  }
+
+  // copy block to contiguous buffer, fetching it into the cache on a miss
+  void get_tile(size_t block_index, Scalar* block) const
+  {
+    cache.lock(block_index + 1);
+    const Scalar* p = block_line(block_index, false, true)->data();
+    std::copy(p, p + 4, block);
+    cache.unlock(block_index + 1);
+  }
+
+  // copy contiguous block to its cache line and mark the line modified; on a
+  // miss, the block is not fetched as all of its values are overwritten
+  void put_tile(size_t block_index, const Scalar* block)
+  {
+    cache.lock(block_index + 1);
+    Scalar* p = block_line(block_index, true, false)->data();
+    std::copy(block, block + 4, p);
+    cache.unlock(block_index + 1);
+  }
+
+  // copy block to contiguous buffer from cache or, on a miss, from store
+  // without caching it and return whether the block was cached
+  bool copy(size_t block_index, Scalar* block) const
+  {
+    cache.lock(block_index + 1);
+    const CacheLine* line = cache.find(block_index + 1);
+    if (line)
+      std::copy(line->data(), line->data() + 4, block);
+    else
+      store.decode(block_index, block);
+    cache.unlock(block_index + 1);
+    return line != 0;
+  }
+
+  // copy block to contiguous buffer of another scalar type
+  template <typename T>
+  bool copy(size_t block_index, T* block) const
+  {
+    Scalar a[4] = {};
+    bool hit = copy(block_index, a);
+    for (uint i = 0; i < 4; i++)
+      block[i] = static_cast<T>(a[i]);
+    return hit;
+  }
+
+  // enable thread-safe decompression while blocks are copied concurrently
+  void set_thread_safety(bool safety) const { store.set_thread_safety(safety); }
+
+  // copy all blocks to strided array p, decompressing uncached blocks in
+  // parallel when compiled with OpenMP
+  void get_blocks(Scalar* p, ptrdiff_t sx) const
+  {
+    const ptrdiff_t blocks = ptrdiff_t(store.blocks());
+    ptrdiff_t hits = 0;
+    double t = CacheStats::now();
+#ifdef _OPENMP
+    bool parallel = (blocks > 1 && omp_get_max_threads() > 1 && !omp_in_parallel());
+    if (parallel)
+      store.set_thread_safety(true);
+    #pragma omp parallel for if (parallel) reduction(+:hits)
+#endif
+    for (ptrdiff_t b = 0; b < blocks; b++) {
+      size_t block_index = size_t(b);
+      Scalar* q = p + store.block_origin(block_index, sx);
+      cache.lock(block_index + 1);
+      const CacheLine* line = cache.find(block_index + 1);
+      if (line) {
+        line->get(q, sx, store.block_shape(block_index));
+        hits++;
+      }
+      else
+        store.decode(block_index, q, sx);
+      cache.unlock(block_index + 1);
+    }
+#ifdef _OPENMP
+    if (parallel)
+      store.set_thread_safety(false);
+#endif
+    stats.access(uint64(hits), uint64(blocks - hits));
+    if (hits < blocks)
+      stats.decoded(t);
+  }
+
+  // compress all blocks from strided array p, in parallel when compiled with
+  // OpenMP; cached blocks are discarded as they are overwritten
+  void put_blocks(const Scalar* p, ptrdiff_t sx) const
+  {
+    cache.clear();
+    double t = CacheStats::now();
+    store.encode_all(p, sx);
+    stats.access(0, store.blocks());
+    stats.encoded(t, store.blocks());
+  }
+
+  // compress all blocks from cache c of a same-sized array, possibly of
+  // another scalar type, in parallel when compiled with OpenMP; cached blocks
+  // are discarded as they are overwritten
+  template <class Cache>
+  void put_blocks(const Cache& c) const
+  {
+    cache.clear();
+    double t = CacheStats::now();
+#ifdef _OPENMP
+    bool parallel = store.parallel(store.blocks());
+    if (parallel)
+      c.set_thread_safety(true);
+#endif
+    store.encode_all(c);
+#ifdef _OPENMP
+    if (parallel)
+      c.set_thread_safety(false);
+#endif
+    stats.access(0, store.blocks());
+    stats.encoded(t, store.blocks());
+  }
+
+  // reduce values in range [x, x + nx) using r, decoding each uncached block
+  // that overlaps the range at most once and skipping those that r deems
+  // irrelevant based on their bound, in parallel when compiled with OpenMP
+  template <class Reduction>
+  void reduce(Reduction& r, size_t x, size_t nx) const
+  {
+    reduce_blocks(r, 0, x, nx);
+  }
+
+  // reduce pairs of values from this cache and cache c of same-sized array
+  template <class Reduction>
+  void reduce(Reduction& r, const BlockCache1& c, size_t x, size_t nx) const
+  {
+    reduce_blocks(r, &c, x, nx);
+  }
+
+  // combine each block with the corresponding block of optional cache c of a
+  // same-sized array via op and re-encode the result in place, bypassing the
+  // cache and in parallel when compiled with OpenMP; modified cached blocks
+  // are written back beforehand, and cached blocks are then discarded
+  template <class Operation>
+  void transform(const Operation& op, const BlockCache1* c)
+  {
+    flush();
+    cache.clear();
+    const BlockCache1* d = (c == this ? 0 : c);
+    const size_t blocks = store.blocks();
+    Transform<Operation> source(*this, d, op);
+    double t = CacheStats::now();
+#ifdef _OPENMP
+    bool parallel = d && store.parallel(blocks);
+    if (parallel)
+      d->store.set_thread_safety(true);
+#endif
+    store.update_blocks(source);
+#ifdef _OPENMP
+    if (parallel)
+      d->store.set_thread_safety(false);
+#endif
+    stats.access(0, blocks);
+    stats.encoded(t, blocks);
+    if (d)
+      d->stats.access(source.hits, blocks - source.hits);
   }
 
 protected:
+  // maximum number of blocks decoded ahead
+  enum { max_prefetch = 64 };
+
   // cache line representing one block of decompressed values
   class CacheLine {
   public:
@@ -155,23 +352,239 @@ protected:
     Scalar a[4];
   };
 
+  // acquire and release exclusive access to cache line for i (shared cache only)
+  void lock(size_t i) const { cache.lock(store.block_index(i) + 1); }
+  void unlock(size_t i) const { cache.unlock(store.block_index(i) + 1); }
+
   // return cache line for i; may require write-back and fetch
   CacheLine* line(size_t i, bool write) const
+  {
+    return block_line(store.block_index(i), write, true);
+  }
+
+  // return cache line for block; may require write-back and, if requested,
+  // fetch of the block
+  CacheLine* block_line(size_t block_index, bool write, bool fetch) const
   {
     CacheLine* p = 0;
-    size_t block_index = store.block_index(i);
-    typename zfp::internal::Cache<CacheLine>::Tag tag = cache.access(p, (uint)block_index + 1, write);
+#ifndef ZFP_WITH_CACHE_SHARED
+    // on a miss, first decode blocks that follow in storage order
+    if (ahead && fetch && !cache.find(block_index + 1))
+      decode_ahead(block_index);
+#endif
+    typename zfp::internal::Cache<CacheLine, size_t, Policy>::Tag tag = cache.access(p, block_index + 1, write);
     size_t stored_block_index = tag.index() - 1;
-    if (stored_block_index != block_index) {
+    bool hit = (stored_block_index == block_index);
+    stats.access(hit);
+    if (!hit) {
       // write back occupied cache line if it is dirty
       if (tag.dirty())
-        store.encode(stored_block_index, p->data());
+        encode(stored_block_index, p->data());
       // fetch cache line
-      store.decode(block_index, p->data());
+      if (fetch)
+        decode(block_index, p->data());
     }
     return p;
   }
 
+  // compress contiguous block to store and record its compression time
+  void encode(size_t block_index, const Scalar* block) const
+  {
+    double t = CacheStats::now();
+    store.encode(block_index, block);
+    stats.encoded(t);
+  }
+
+  // decompress contiguous block from store and record its decompression time
+  void decode(size_t block_index, Scalar* block) const
+  {
+    double t = CacheStats::now();
+    store.decode(block_index, block);
+    stats.decoded(t);
+  }
+
+  // decompress up to prefetch() uncached blocks following block_index into
+  // the cache, in parallel when compiled with OpenMP
+  void decode_ahead(size_t block_index) const
+  {
+    size_t index[max_prefetch];
+    size_t n = 0;
+    size_t m = std::min(size_t(std::min(ahead, cache.size() - 1)), store.blocks() - block_index - 1);
+    // reserve cache lines, writing back any modified blocks they hold
+    for (size_t b = block_index + 1; b <= block_index + m; b++) {
+      CacheLine* p = 0;
+      typename zfp::internal::Cache<CacheLine, size_t, Policy>::Tag tag = cache.access(p, b + 1, false);
+      if (tag.index() != b + 1) {
+        if (tag.dirty())
+          encode(tag.index() - 1, p->data());
+        index[n++] = b;
+      }
+    }
+    // fetch blocks whose cache lines were not reclaimed by later blocks
+    double t = CacheStats::now();
+#ifdef _OPENMP
+    if (n > 1 && !omp_in_parallel()) {
+      // each thread decodes using its own copy of the zfp stream
+      store.set_thread_safety(true);
+      #pragma omp parallel for
+      for (int i = 0; i < int(n); i++)
+        fetch(index[i]);
+      store.set_thread_safety(false);
+    }
+    else
+#endif
+    for (size_t i = 0; i < n; i++)
+      fetch(index[i]);
+    if (n)
+      stats.decoded(t);
+  }
+
+  // decompress block into cache line reserved for it unless since reclaimed
+  void fetch(size_t block_index) const
+  {
+    CacheLine* p = cache.find(block_index + 1);
+    if (p)
+      store.decode(block_index, p->data());
+  }
+
+  // reduce values from this cache and optional cache c in range
+  template <class Reduction>
+  void reduce_blocks(Reduction& r, const BlockCache1* c, size_t x, size_t nx) const
+  {
+    if (!nx)
+      return;
+    // range of blocks overlapping range
+    const size_t bx = x / 4, mx = (x + nx + 3) / 4 - bx;
+    const ptrdiff_t blocks = ptrdiff_t(mx);
+    const BlockCache1* d = (c == this ? 0 : c);
+    ptrdiff_t hits = 0, misses = 0, dhits = 0, dmisses = 0;
+    double t = CacheStats::now();
+#ifdef _OPENMP
+    bool parallel = (blocks > 1 && omp_get_max_threads() > 1 && !omp_in_parallel());
+    // per-thread partial reductions, merged in thread order for reproducibility
+    std::vector<Reduction> partial(parallel ? size_t(omp_get_max_threads()) : 1);
+    if (parallel) {
+      store.set_thread_safety(true);
+      if (d)
+        d->store.set_thread_safety(true);
+    }
+    #pragma omp parallel if (parallel) reduction(+:hits, misses, dhits, dmisses)
+#endif
+    {
+      // thread-private partial reduction
+      Reduction s;
+#ifdef _OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (ptrdiff_t n = 0; n < blocks; n++) {
+        size_t i = 4 * (bx + size_t(n));
+        size_t block_index = store.block_index(i);
+        Scalar a[4];
+        Scalar b[4];
+        if (!read(s, block_index, a, hits, misses))
+          continue;
+        if (d && !d->read(s, block_index, b, dhits, dmisses))
+          continue;
+        // elements outside the range do not contribute
+        if (mask(a, s.identity(), i, x, nx) && d)
+          mask(b, s.identity(), i, x, nx);
+        s(a, d ? b : a, 4);
+      }
+#ifdef _OPENMP
+      partial[size_t(omp_get_thread_num())] = s;
+#else
+      r.merge(s);
+#endif
+    }
+#ifdef _OPENMP
+    for (size_t i = 0; i < partial.size(); i++)
+      r.merge(partial[i]);
+    if (parallel) {
+      store.set_thread_safety(false);
+      if (d)
+        d->store.set_thread_safety(false);
+    }
+#endif
+    stats.access(uint64(hits), uint64(misses));
+    if (misses)
+      stats.decoded(t);
+    if (d) {
+      d->stats.access(uint64(dhits), uint64(dmisses));
+      if (dmisses)
+        d->stats.decoded(t);
+    }
+  }
+
+  // encoder of blocks combined with those of an optional second cache
+  template <class Operation>
+  class Transform {
+  public:
+    Transform(const BlockCache1& dst, const BlockCache1* src, const Operation& op) : hits(0), dst(dst), src(src), op(op) {}
+
+    // decode block, combine it with source block, and encode result using
+    // codec at given bit offset
+    template <class Codec>
+    size_t operator()(const Codec& codec, bitstream_offset offset, size_t block_index) const
+    {
+      Scalar a[4] = {};
+      Scalar b[4] = {};
+      dst.store.decode(block_index, a);
+      if (src && src->copy(block_index, b)) {
+#ifdef _OPENMP
+        #pragma omp atomic
+#endif
+        hits++;
+      }
+      op(a, src ? b : a, 4);
+      return codec.encode_block(offset, dst.store.block_shape(block_index), a);
+    }
+
+    mutable uint64 hits;    // number of source blocks found in cache
+
+  protected:
+    const BlockCache1& dst; // cache of blocks to update
+    const BlockCache1* src; // optional cache of second operand
+    const Operation& op;    // element-wise operation
+  };
+
+  // copy block to contiguous buffer from cache or store and return true
+  // unless the block is not cached and r may skip it
+  template <class Reduction>
+  bool read(const Reduction& r, size_t block_index, Scalar* block, ptrdiff_t& hits, ptrdiff_t& misses) const
+  {
+    bool copied = true;
+    cache.lock(block_index + 1);
+    const CacheLine* line = cache.find(block_index + 1);
+    if (line) {
+      const Scalar* p = line->data();
+      for (uint n = 0; n < 4; n++)
+        block[n] = p[n];
+      hits++;
+    }
+    else if (r.skip(store.block_bound(block_index)))
+      copied = false;
+    else {
+      store.decode(block_index, block);
+      misses++;
+    }
+    cache.unlock(block_index + 1);
+    return copied;
+  }
+
+  // set elements of block with origin i that lie outside the range to
+  // value and return whether the block is not contained in the range
+  static bool mask(Scalar* block, Scalar value, size_t i, size_t x, size_t nx)
+  {
+    // range extent relative to block
+    uint x0 = uint(x > i ? x - i : 0), x1 = uint(std::min(x + nx - i, size_t(4)));
+    if (!x0 && x1 == 4)
+      return false;
+    for (uint t = 0; t < 4; t++)
+      if (t < x0 || t >= x1)
+        block[t] = value;
+    return true;
+  }
+
   // default number of cache lines for array with given number of blocks
   static uint lines(size_t blocks)
   {
@@ -185,14 +598,16 @@ protected:
   static uint lines(size_t bytes, size_t blocks)
   {
     // ensure block index fits in tag
-    if (blocks >> ((sizeof(uint) * CHAR_BIT) - 1))
+    if (blocks >> ((sizeof(size_t) * CHAR_BIT) - 1))
       throw zfp::exception("zfp array too large for cache");
     uint n = bytes ? static_cast<uint>((bytes + sizeof(CacheLine) - 1) / sizeof(CacheLine)) : lines(blocks);
     return std::max(n, 1u);
   }
 
-  mutable Cache<CacheLine> cache; // cache of decompressed blocks
-  Store& store;                   // store backed by cache
+  mutable Cache<CacheLine, size_t, Policy> cache; // cache of decompressed blocks
+  mutable CacheStats stats;                       // cache access statistics
+  Store& store;                                   // store backed by cache
+  uint ahead;                                     // number of blocks to decode ahead
 };
 
 } // internal
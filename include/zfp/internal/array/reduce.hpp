@@ -0,0 +1,116 @@
+#ifndef ZFP_REDUCE_HPP
+#define ZFP_REDUCE_HPP
+
+#include <limits>
+
+namespace zfp {
+namespace internal {
+
+// Reductions over blocks of decompressed values.  Blocks are reduced whole,
+// with elements outside the region of interest set to the identity element,
+// using four independent accumulators that the compiler can map onto vector
+// lanes.  Reductions over one array ignore the second operand q.  A block
+// whose values are bounded in magnitude by bound may be skipped, without
+// being decoded, if skip(bound) is true.  Partial results computed by
+// different threads are combined via merge().
+
+// sum of values, accumulated in double precision
+template <typename Scalar>
+class SumReduction {
+public:
+  SumReduction() : value(0) {}
+
+  static Scalar identity() { return 0; }
+  bool skip(Scalar bound) const { return bound == 0; }
+  void merge(const SumReduction& r) { value += r.value; }
+
+  // reduce n values, with n a multiple of four
+  void operator()(const Scalar* p, const Scalar*, size_t n)
+  {
+    double s[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < n; i += 4)
+      for (uint k = 0; k < 4; k++)
+        s[k] += p[i + k];
+    value += (s[0] + s[1]) + (s[2] + s[3]);
+  }
+
+  double value; // accumulated sum
+};
+
+// smallest value
+template <typename Scalar>
+class MinReduction {
+public:
+  MinReduction() : value(identity()) {}
+
+  static Scalar identity() { return std::numeric_limits<Scalar>::infinity(); }
+  bool skip(Scalar bound) const { return -bound >= value; }
+  void merge(const MinReduction& r) { value = r.value < value ? r.value : value; }
+
+  // reduce n values, with n a multiple of four
+  void operator()(const Scalar* p, const Scalar*, size_t n)
+  {
+    Scalar m[4] = { value, value, value, value };
+    for (size_t i = 0; i < n; i += 4)
+      for (uint k = 0; k < 4; k++)
+        m[k] = p[i + k] < m[k] ? p[i + k] : m[k];
+    m[0] = m[1] < m[0] ? m[1] : m[0];
+    m[2] = m[3] < m[2] ? m[3] : m[2];
+    value = m[2] < m[0] ? m[2] : m[0];
+  }
+
+  Scalar value; // smallest value seen
+};
+
+// largest value
+template <typename Scalar>
+class MaxReduction {
+public:
+  MaxReduction() : value(identity()) {}
+
+  static Scalar identity() { return -std::numeric_limits<Scalar>::infinity(); }
+  bool skip(Scalar bound) const { return bound <= value; }
+  void merge(const MaxReduction& r) { value = r.value > value ? r.value : value; }
+
+  // reduce n values, with n a multiple of four
+  void operator()(const Scalar* p, const Scalar*, size_t n)
+  {
+    Scalar m[4] = { value, value, value, value };
+    for (size_t i = 0; i < n; i += 4)
+      for (uint k = 0; k < 4; k++)
+        m[k] = p[i + k] > m[k] ? p[i + k] : m[k];
+    m[0] = m[1] > m[0] ? m[1] : m[0];
+    m[2] = m[3] > m[2] ? m[3] : m[2];
+    value = m[2] > m[0] ? m[2] : m[0];
+  }
+
+  Scalar value; // largest value seen
+};
+
+// inner product of two arrays, accumulated in double precision
+template <typename Scalar>
+class DotReduction {
+public:
+  DotReduction() : value(0) {}
+
+  static Scalar identity() { return 0; }
+  bool skip(Scalar bound) const { return bound == 0; }
+  void merge(const DotReduction& r) { value += r.value; }
+
+  // reduce n pairs of values, with n a multiple of four
+  void operator()(const Scalar* p, const Scalar* q, size_t n)
+  {
+    double s[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < n; i += 4)
+      for (uint k = 0; k < 4; k++)
+        s[k] += double(p[i + k]) * double(q[i + k]);
+    value += (s[0] + s[1]) + (s[2] + s[3]);
+  }
+
+  double value; // accumulated inner product
+};
+
+} // internal
+} // zfp
+
+#endif
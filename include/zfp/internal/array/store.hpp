@@ -3,8 +3,14 @@
 
 #include <climits>
 #include <cmath>
+#include <cstring>
 #include "zfp/internal/array/memory.hpp"
 
+#ifdef _OPENMP
+  // (de)compress blocks in parallel
+  #include <omp.h>
+#endif
+
 namespace zfp {
 namespace internal {
 
@@ -117,12 +123,32 @@ public:
     size_t size = zfp::internal::round_up(index.range(), codec.alignment() * CHAR_BIT) / CHAR_BIT;
     if (bytes > size) {
       codec.close();
-      zfp::internal::reallocate_aligned(data, size, ZFP_MEMORY_ALIGNMENT, bytes);
+      // caller-managed buffer is left in place
+      if (!external)
+        zfp::internal::reallocate_aligned(data, size, ZFP_MEMORY_ALIGNMENT, bytes);
       bytes = size;
       codec.open(data, bytes);
     }
   }
 
+  // use caller-managed buffer of size bytes (e.g., memory-mapped file) for
+  // compressed data; buffer is zero-initialized only if clear is set
+  void attach(void* buffer, size_t size, const zfp_config& config, bool clear)
+  {
+    free();
+    external = true;
+    capacity = size;
+    // set compression parameters and validate buffer size without touching
+    // the buffer, which may hold previously compressed data
+    data = 0;
+    set_config(config);
+    codec.close();
+    data = buffer;
+    if (clear)
+      std::fill(static_cast<uchar*>(data), static_cast<uchar*>(data) + bytes, uchar(0));
+    codec.open(data, bytes);
+  }
+
   // increment private view reference count (for thread safety)
   void reference()
   {
@@ -130,7 +156,7 @@ public:
     #pragma omp critical(references)
     {
       references++;
-      codec.set_thread_safety(references > 1);
+      codec.set_thread_safety(shared());
     }
 #endif
   }
@@ -142,11 +168,15 @@ public:
     #pragma omp critical(references)
     {
       references--;
-      codec.set_thread_safety(references > 1);
+      codec.set_thread_safety(shared());
     }
 #endif
   }
 
+  // enable thread-safe (de)compression while the owner of the store accesses
+  // blocks concurrently, e.g., to decode a batch of blocks in parallel
+  void set_thread_safety(bool safety) { codec.set_thread_safety(safety || shared()); }
+
   // byte size of store data structure components indicated by mask
   virtual size_t size_bytes(uint mask = ZFP_DATA_ALL) const
   {
@@ -166,18 +196,54 @@ public:
   // pointer to compressed data for read or write access
   void* compressed_data() const { return data; }
 
+  // re-encode all blocks in place, in parallel when compiled with OpenMP;
+  // source(codec, offset, block_index) may decode the block before encoding
+  // its replacement, which in word-aligned fixed-rate mode occupies the same
+  // bits of the store
+  template <class Source>
+  void update_blocks(const Source& source)
+  {
+    const size_t n = blocks();
+    if (n && mode() != zfp_mode_fixed_rate)
+      throw zfp::exception("zfp block update requires fixed-rate mode");
+#ifdef _OPENMP
+    if (parallel(n)) {
+      encode_in_place(source, n);
+      return;
+    }
+#endif
+    for (size_t b = 0; b < n; b++)
+      source(codec, offset(b), b);
+  }
+
+#ifdef _OPENMP
+  // whether n blocks are to be (re-)encoded in parallel
+  static bool parallel(size_t n) { return n > 1 && omp_get_max_threads() > 1 && !omp_in_parallel(); }
+#endif
+
 protected:
   // protected default constructor
   BlockStore() :
     data(0),
     bytes(0),
+    capacity(0),
+    external(false),
     references(0),
     index(0)
-  {}
+  {
+    codec.set_thread_safety(shared());
+  }
 
   // destructor
   virtual ~BlockStore() { free(); }
 
+  // whether blocks may be encoded and decoded concurrently
+#ifdef ZFP_WITH_CACHE_SHARED
+  bool shared() const { return true; }
+#else
+  bool shared() const { return references > 1; }
+#endif
+
   // buffer size in bytes needed for current codec settings
   virtual size_t buffer_size() const = 0;
 
@@ -198,7 +264,15 @@ protected:
   void deep_copy(const BlockStore& s)
   {
     free();
-    zfp::internal::clone_aligned(data, s.data, s.bytes, ZFP_MEMORY_ALIGNMENT);
+    if (external) {
+      // copy compressed data into caller-managed buffer
+      if (s.bytes > capacity)
+        throw zfp::exception("buffer size is smaller than required");
+      if (s.bytes)
+        std::memcpy(data, s.data, s.bytes);
+    }
+    else
+      zfp::internal::clone_aligned(data, s.data, s.bytes, ZFP_MEMORY_ALIGNMENT);
     bytes = s.bytes;
     references = s.references;
     index = s.index;
@@ -211,18 +285,26 @@ protected:
   {
     free();
     bytes = buffer_size();
-    zfp::internal::reallocate_aligned(data, bytes, ZFP_MEMORY_ALIGNMENT);
-    if (clear)
+    if (external) {
+      // reuse caller-managed buffer
+      if (bytes > capacity)
+        throw zfp::exception("buffer size is smaller than required");
+    }
+    else
+      zfp::internal::reallocate_aligned(data, bytes, ZFP_MEMORY_ALIGNMENT);
+    if (clear && data)
       std::fill(static_cast<uchar*>(data), static_cast<uchar*>(data) + bytes, uchar(0));
     codec.open(data, bytes);
   }
 
-  // free block store
+  // free block store (caller-managed buffer is retained but not deallocated)
   void free()
   {
-    if (data) {
-      zfp::internal::deallocate_aligned(data);
-      data = 0;
+    if (data || bytes) {
+      if (!external) {
+        zfp::internal::deallocate_aligned(data);
+        data = 0;
+      }
       bytes = 0;
       codec.close();
     }
@@ -231,6 +313,95 @@ protected:
   // bit offset to block store
   bitstream_offset offset(size_t block_index) const { return index.block_offset(block_index); }
 
+  // encode all blocks in sequence, in parallel when compiled with OpenMP;
+  // source(codec, offset, block_index) encodes one block at the given bit
+  // offset using the given codec and returns its size in bits
+  template <class Source>
+  void encode_blocks(const Source& source)
+  {
+    const size_t n = blocks();
+#ifdef _OPENMP
+    if (parallel(n)) {
+      if (index.has_variable_rate())
+        encode_staged(source, n);
+      else
+        encode_in_place(source, n);
+      return;
+    }
+#endif
+    for (size_t b = 0; b < n; b++)
+      index.set_block_size(b, source(codec, offset(b), b));
+  }
+
+#ifdef _OPENMP
+  // encode fixed-size blocks in parallel directly at their offsets; blocks
+  // that share a stream word are encoded in order by the same thread
+  template <class Source>
+  void encode_in_place(const Source& source, size_t n)
+  {
+    size_t group = 1;
+    while ((group * index.block_size(0)) % stream_word_bits)
+      group *= 2;
+    const ptrdiff_t groups = ptrdiff_t((n + group - 1) / group);
+    set_thread_safety(true);
+    #pragma omp parallel for
+    for (ptrdiff_t g = 0; g < groups; g++) {
+      size_t first = size_t(g) * group;
+      size_t last = std::min(first + group, n);
+      for (size_t b = first; b < last; b++)
+        source(codec, offset(b), b);
+    }
+    set_thread_safety(false);
+  }
+
+  // encode variable-size blocks in parallel into per-thread staging buffers
+  // and then append them to the store and build the index in sequence
+  template <class Source>
+  void encode_staged(const Source& source, size_t n)
+  {
+    // blocks per staging buffer and conservative buffer size
+    const size_t chunk = 0x100u;
+    uint maxbits;
+    codec.params(0, &maxbits, 0, 0);
+    const size_t chunk_bytes = zfp::internal::round_up(chunk * maxbits + stream_word_bits, stream_word_bits) / CHAR_BIT;
+    const size_t threads = size_t(omp_get_max_threads());
+    uchar* buffer = static_cast<uchar*>(zfp::internal::allocate_aligned(threads * chunk_bytes, ZFP_MEMORY_ALIGNMENT));
+    size_t* size = static_cast<size_t*>(zfp::internal::allocate(threads * chunk * sizeof(size_t)));
+    bitstream* dst = stream_open(data, bytes);
+    for (size_t first = 0; first < n; first += threads * chunk) {
+      const size_t last = std::min(first + threads * chunk, n);
+      const ptrdiff_t chunks = ptrdiff_t((last - first + chunk - 1) / chunk);
+      // encode each chunk of blocks into its own buffer
+      #pragma omp parallel for
+      for (ptrdiff_t c = 0; c < chunks; c++) {
+        Codec staging;
+        staging = codec;
+        staging.set_thread_safety(false);
+        staging.open(buffer + size_t(c) * chunk_bytes, chunk_bytes);
+        bitstream_offset offset = 0;
+        for (size_t b = first + size_t(c) * chunk; b < std::min(first + size_t(c + 1) * chunk, last); b++) {
+          size_t bits = source(staging, offset, b);
+          size[b - first] = bits;
+          offset += bits;
+        }
+      }
+      // concatenate chunks and index their blocks
+      for (ptrdiff_t c = 0; c < chunks; c++) {
+        bitstream* src = stream_open(buffer + size_t(c) * chunk_bytes, chunk_bytes);
+        for (size_t b = first + size_t(c) * chunk; b < std::min(first + size_t(c + 1) * chunk, last); b++) {
+          index.set_block_size(b, size[b - first]);
+          stream_copy(dst, src, size[b - first]);
+        }
+        stream_close(src);
+      }
+    }
+    stream_flush(dst);
+    stream_close(dst);
+    zfp::internal::deallocate(size);
+    zfp::internal::deallocate_aligned(buffer);
+  }
+#endif
+
   // shape 0 <= m <= 3 of block containing index i, 0 <= i <= n - 1
   static uint shape_code(size_t i, size_t n)
   {
@@ -244,6 +415,8 @@ protected:
 
   void* data;        // pointer to compressed blocks
   size_t bytes;      // compressed data size
+  size_t capacity;   // size of caller-managed buffer
+  bool external;     // whether data is caller-managed
   size_t references; // private view references to array (for thread safety)
   Index index;       // block index (size and offset)
   Codec codec;       // compression codec
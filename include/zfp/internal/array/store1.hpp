@@ -23,6 +23,14 @@ public:
     this->set_config(config);
   }
 
+  // block store for array of size nx and given configuration whose
+  // compressed data resides in caller-managed buffer of given byte size
+  BlockStore1(size_t nx, const zfp_config& config, void* buffer, size_t size, bool clear)
+  {
+    set_size(nx);
+    this->attach(buffer, size, config, clear);
+  }
+
   // perform a deep copy
   void deep_copy(const BlockStore1& s)
   {
@@ -80,6 +88,12 @@ public:
     return mx;
   }
 
+  // offset of first element of block in strided array
+  ptrdiff_t block_origin(size_t block_index, ptrdiff_t sx) const
+  {
+    return ptrdiff_t(4 * block_index) * sx;
+  }
+
   // encode contiguous block with given index
   size_t encode(size_t block_index, const Scalar* block)
   {
@@ -108,7 +122,64 @@ public:
     return codec.decode_block_strided(offset(block_index), block_shape(block_index), p, sx);
   }
 
+  // upper bound on magnitude of values in block with given index
+  Scalar block_bound(size_t block_index) const
+  {
+    return codec.block_bound(offset(block_index));
+  }
+
+  // encode all blocks from strided array p, in parallel when compiled with OpenMP
+  void encode_all(const Scalar* p, ptrdiff_t sx)
+  {
+    this->encode_blocks(StridedSource(*this, p, sx));
+  }
+
+  // encode all blocks from those of a same-sized source, e.g., the cache of
+  // another array, whose copy(block_index, block) decompresses one block, in
+  // parallel when compiled with OpenMP
+  template <class Source>
+  void encode_all(const Source& source)
+  {
+    this->encode_blocks(BlockSource<Source>(*this, source));
+  }
+
 protected:
+  // encoder of blocks from strided array
+  class StridedSource {
+  public:
+    StridedSource(const BlockStore1& store, const Scalar* p, ptrdiff_t sx) : store(store), p(p), sx(sx) {}
+
+    // encode block using codec at given bit offset and return its bit size
+    size_t operator()(const Codec& codec, bitstream_offset offset, size_t block_index) const
+    {
+      return codec.encode_block_strided(offset, store.block_shape(block_index), p + store.block_origin(block_index, sx), sx);
+    }
+
+  protected:
+    const BlockStore1& store;  // store holding blocks
+    const Scalar* p;           // pointer to first array element
+    const ptrdiff_t sx;        // array strides
+  };
+
+  // encoder of blocks copied one at a time from another source
+  template <class Source>
+  class BlockSource {
+  public:
+    BlockSource(const BlockStore1& store, const Source& source) : store(store), source(source) {}
+
+    // encode block using codec at given bit offset and return its bit size
+    size_t operator()(const Codec& codec, bitstream_offset offset, size_t block_index) const
+    {
+      Scalar block[4] = {};
+      source.copy(block_index, block);
+      return codec.encode_block(offset, store.block_shape(block_index), block);
+    }
+
+  protected:
+    const BlockStore1& store; // store holding blocks
+    const Source& source;     // source of blocks
+  };
+
   using BlockStore<Codec, Index>::alloc;
   using BlockStore<Codec, Index>::free;
   using BlockStore<Codec, Index>::offset;
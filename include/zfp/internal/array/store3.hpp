@@ -23,6 +23,14 @@ public:
     this->set_config(config);
   }
 
+  // block store for array of size nx * ny * nz and given configuration whose
+  // compressed data resides in caller-managed buffer of given byte size
+  BlockStore3(size_t nx, size_t ny, size_t nz, const zfp_config& config, void* buffer, size_t size, bool clear)
+  {
+    set_size(nx, ny, nz);
+    this->attach(buffer, size, config, clear);
+  }
+
   // perform a deep copy
   void deep_copy(const BlockStore3& s)
   {
@@ -90,6 +98,15 @@ public:
     return mx + 4 * (my + 4 * mz);
   }
 
+  // offset of first element of block in strided array
+  ptrdiff_t block_origin(size_t block_index, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
+  {
+    ptrdiff_t i = ptrdiff_t(4 * (block_index % bx)); block_index /= bx;
+    ptrdiff_t j = ptrdiff_t(4 * (block_index % by)); block_index /= by;
+    ptrdiff_t k = ptrdiff_t(4 * block_index);
+    return i * sx + j * sy + k * sz;
+  }
+
   // encode contiguous block with given index
   size_t encode(size_t block_index, const Scalar* block)
   {
@@ -118,7 +135,64 @@ public:
     return codec.decode_block_strided(offset(block_index), block_shape(block_index), p, sx, sy, sz);
   }
 
+  // upper bound on magnitude of values in block with given index
+  Scalar block_bound(size_t block_index) const
+  {
+    return codec.block_bound(offset(block_index));
+  }
+
+  // encode all blocks from strided array p, in parallel when compiled with OpenMP
+  void encode_all(const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz)
+  {
+    this->encode_blocks(StridedSource(*this, p, sx, sy, sz));
+  }
+
+  // encode all blocks from those of a same-sized source, e.g., the cache of
+  // another array, whose copy(block_index, block) decompresses one block, in
+  // parallel when compiled with OpenMP
+  template <class Source>
+  void encode_all(const Source& source)
+  {
+    this->encode_blocks(BlockSource<Source>(*this, source));
+  }
+
 protected:
+  // encoder of blocks from strided array
+  class StridedSource {
+  public:
+    StridedSource(const BlockStore3& store, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) : store(store), p(p), sx(sx), sy(sy), sz(sz) {}
+
+    // encode block using codec at given bit offset and return its bit size
+    size_t operator()(const Codec& codec, bitstream_offset offset, size_t block_index) const
+    {
+      return codec.encode_block_strided(offset, store.block_shape(block_index), p + store.block_origin(block_index, sx, sy, sz), sx, sy, sz);
+    }
+
+  protected:
+    const BlockStore3& store;   // store holding blocks
+    const Scalar* p;            // pointer to first array element
+    const ptrdiff_t sx, sy, sz; // array strides
+  };
+
+  // encoder of blocks copied one at a time from another source
+  template <class Source>
+  class BlockSource {
+  public:
+    BlockSource(const BlockStore3& store, const Source& source) : store(store), source(source) {}
+
+    // encode block using codec at given bit offset and return its bit size
+    size_t operator()(const Codec& codec, bitstream_offset offset, size_t block_index) const
+    {
+      Scalar block[4 * 4 * 4] = {};
+      source.copy(block_index, block);
+      return codec.encode_block(offset, store.block_shape(block_index), block);
+    }
+
+  protected:
+    const BlockStore3& store; // store holding blocks
+    const Source& source;     // source of blocks
+  };
+
   using BlockStore<Codec, Index>::alloc;
   using BlockStore<Codec, Index>::free;
   using BlockStore<Codec, Index>::offset;
@@ -0,0 +1,101 @@
+#ifndef ZFP_TILE1_HPP
+#define ZFP_TILE1_HPP
+
+// tiles holding the decompressed values of one 1D block
+
+namespace zfp {
+namespace internal {
+namespace dim1 {
+
+// read-only tile of decompressed values of one block
+template <class Container>
+class const_tile {
+public:
+  typedef Container container_type;
+  typedef typename container_type::value_type value_type;
+
+  // tile of block with given index, which is fetched into the array's cache
+  const_tile(const container_type* array, size_t block_index) :
+    array(const_cast<container_type*>(array)),
+    index(block_index)
+  {
+    x = 4 * block_index;
+    nx = std::min(array->size_x() - x, size_t(4));
+    array->cache.get_tile(index, a);
+  }
+
+  // index of block held by tile
+  size_t block_index() const { return index; }
+
+  // number of elements in tile that belong to the array
+  size_t size() const { return nx; }
+
+  // tile dimensions (less than four for partial blocks)
+  size_t size_x() const { return nx; }
+
+  // local to global array indices
+  size_t global_x(size_t i) const { return x + i; }
+
+  // decompressed values stored with strides (1)
+  const value_type* data() const { return a; }
+
+  // inspector
+  value_type operator()(size_t i) const { return a[i]; }
+
+protected:
+  container_type* array; // underlying container
+  size_t index;          // block index
+  size_t x;              // offset of block in array
+  size_t nx;             // dimensions of tile
+  value_type a[4];       // decompressed values
+};
+
+// mutable tile of decompressed values of one block; modified values are
+// written back to the array's cache on commit or destruction
+template <class Container>
+class tile : public const_tile<Container> {
+public:
+  typedef Container container_type;
+  typedef typename container_type::value_type value_type;
+
+  // tile of block with given index, which is fetched into the array's cache
+  tile(container_type* array, size_t block_index) : const_tile<Container>(array, block_index), modified(false) {}
+
+  // destructor--commits any modifications
+  ~tile() { commit(); }
+
+  // decompressed values stored with strides (1); the tile is
+  // assumed modified once this pointer has been obtained
+  const value_type* data() const { return a; }
+  value_type* data() { modified = true; return a; }
+
+  // accessors
+  value_type operator()(size_t i) const { return a[i]; }
+  value_type& operator()(size_t i) { modified = true; return a[i]; }
+
+  // copy modified values to the array's cache and mark its line modified
+  void commit()
+  {
+    if (modified) {
+      array->cache.put_tile(index, a);
+      modified = false;
+    }
+  }
+
+protected:
+  using const_tile<Container>::array;
+  using const_tile<Container>::index;
+  using const_tile<Container>::a;
+
+  // tiles cannot be copied, as each would commit its modifications
+  tile(const tile&);
+  tile& operator=(const tile&);
+
+  bool modified; // have values possibly been modified?
+};
+
+} // dim1
+} // internal
+} // zfp
+
+#endif
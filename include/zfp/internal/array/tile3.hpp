@@ -0,0 +1,110 @@
+#ifndef ZFP_TILE3_HPP
+#define ZFP_TILE3_HPP
+
+// tiles holding the decompressed values of one 3D block
+
+namespace zfp {
+namespace internal {
+namespace dim3 {
+
+// read-only tile of decompressed values of one block
+template <class Container>
+class const_tile {
+public:
+  typedef Container container_type;
+  typedef typename container_type::value_type value_type;
+
+  // tile of block with given index, which is fetched into the array's cache
+  const_tile(const container_type* array, size_t block_index) :
+    array(const_cast<container_type*>(array)),
+    index(block_index)
+  {
+    const typename container_type::store_type& store = array->store;
+    x = 4 * (block_index % store.block_size_x()); block_index /= store.block_size_x();
+    y = 4 * (block_index % store.block_size_y()); block_index /= store.block_size_y();
+    z = 4 * block_index;
+    nx = std::min(array->size_x() - x, size_t(4));
+    ny = std::min(array->size_y() - y, size_t(4));
+    nz = std::min(array->size_z() - z, size_t(4));
+    array->cache.get_tile(index, a);
+  }
+
+  // index of block held by tile
+  size_t block_index() const { return index; }
+
+  // number of elements in tile that belong to the array
+  size_t size() const { return nx * ny * nz; }
+
+  // tile dimensions (less than four for partial blocks)
+  size_t size_x() const { return nx; }
+  size_t size_y() const { return ny; }
+  size_t size_z() const { return nz; }
+
+  // local to global array indices
+  size_t global_x(size_t i) const { return x + i; }
+  size_t global_y(size_t j) const { return y + j; }
+  size_t global_z(size_t k) const { return z + k; }
+
+  // decompressed values stored with strides (1, 4, 16)
+  const value_type* data() const { return a; }
+
+  // inspector
+  value_type operator()(size_t i, size_t j, size_t k) const { return a[i + 4 * (j + 4 * k)]; }
+
+protected:
+  container_type* array;   // underlying container
+  size_t index;            // block index
+  size_t x, y, z;          // offset of block in array
+  size_t nx, ny, nz;       // dimensions of tile
+  value_type a[4 * 4 * 4]; // decompressed values
+};
+
+// mutable tile of decompressed values of one block; modified values are
+// written back to the array's cache on commit or destruction
+template <class Container>
+class tile : public const_tile<Container> {
+public:
+  typedef Container container_type;
+  typedef typename container_type::value_type value_type;
+
+  // tile of block with given index, which is fetched into the array's cache
+  tile(container_type* array, size_t block_index) : const_tile<Container>(array, block_index), modified(false) {}
+
+  // destructor--commits any modifications
+  ~tile() { commit(); }
+
+  // decompressed values stored with strides (1, 4, 16); the tile is
+  // assumed modified once this pointer has been obtained
+  const value_type* data() const { return a; }
+  value_type* data() { modified = true; return a; }
+
+  // accessors
+  value_type operator()(size_t i, size_t j, size_t k) const { return a[i + 4 * (j + 4 * k)]; }
+  value_type& operator()(size_t i, size_t j, size_t k) { modified = true; return a[i + 4 * (j + 4 * k)]; }
+
+  // copy modified values to the array's cache and mark its line modified
+  void commit()
+  {
+    if (modified) {
+      array->cache.put_tile(index, a);
+      modified = false;
+    }
+  }
+
+protected:
+  using const_tile<Container>::array;
+  using const_tile<Container>::index;
+  using const_tile<Container>::a;
+
+  // tiles cannot be copied, as each would commit its modifications
+  tile(const tile&);
+  tile& operator=(const tile&);
+
+  bool modified; // have values possibly been modified?
+};
+
+} // dim3
+} // internal
+} // zfp
+
+#endif
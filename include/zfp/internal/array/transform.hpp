@@ -0,0 +1,74 @@
+#ifndef ZFP_TRANSFORM_HPP
+#define ZFP_TRANSFORM_HPP
+
+namespace zfp {
+namespace internal {
+
+// Element-wise operations that update a block p of decompressed values in
+// place, optionally using a second block q of the same size.  The loops are
+// free of dependences between iterations so that the compiler can vectorize
+// them.  Operations that use only one block ignore q, which may alias p.
+
+// p = a * p
+template <typename Scalar>
+class ScaleTransform {
+public:
+  explicit ScaleTransform(Scalar a) : a(a) {}
+
+  void operator()(Scalar* p, const Scalar*, size_t n) const
+  {
+    for (size_t i = 0; i < n; i++)
+      p[i] *= a;
+  }
+
+protected:
+  Scalar a; // scale factor
+};
+
+// p = p + q
+template <typename Scalar>
+class AddTransform {
+public:
+  void operator()(Scalar* p, const Scalar* q, size_t n) const
+  {
+    for (size_t i = 0; i < n; i++)
+      p[i] += q[i];
+  }
+};
+
+// p = p + a * q
+template <typename Scalar>
+class AxpyTransform {
+public:
+  explicit AxpyTransform(Scalar a) : a(a) {}
+
+  void operator()(Scalar* p, const Scalar* q, size_t n) const
+  {
+    for (size_t i = 0; i < n; i++)
+      p[i] += a * q[i];
+  }
+
+protected:
+  Scalar a; // scale factor of q
+};
+
+// p = (1 - t) * p + t * q
+template <typename Scalar>
+class LerpTransform {
+public:
+  explicit LerpTransform(Scalar t) : t(t) {}
+
+  void operator()(Scalar* p, const Scalar* q, size_t n) const
+  {
+    for (size_t i = 0; i < n; i++)
+      p[i] += t * (q[i] - p[i]);
+  }
+
+protected:
+  Scalar t; // interpolation weight of q
+};
+
+} // internal
+} // zfp
+
+#endif
@@ -216,7 +216,7 @@ protected:
   // inspector
   value_type get(size_t x) const { return cache.get(x); }
 
-  BlockCache1<value_type, store_type> cache; // cache of decompressed blocks
+  typename container_type::cache_type cache; // cache of decompressed blocks
 };
 
 // thread-safe read-write view of private 1D (sub)array
@@ -290,10 +290,10 @@ protected:
   void set(size_t x, value_type val) { cache.set(x, val); }
 
   // in-place updates
-  void add(size_t x, value_type val) { cache.ref(x) += val; }
-  void sub(size_t x, value_type val) { cache.ref(x) -= val; }
-  void mul(size_t x, value_type val) { cache.ref(x) *= val; }
-  void div(size_t x, value_type val) { cache.ref(x) /= val; }
+  void add(size_t x, value_type val) { cache.add(x, val); }
+  void sub(size_t x, value_type val) { cache.sub(x, val); }
+  void mul(size_t x, value_type val) { cache.mul(x, val); }
+  void div(size_t x, value_type val) { cache.div(x, val); }
 };
 
 } // dim1
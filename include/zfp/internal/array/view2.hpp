@@ -404,7 +404,7 @@ protected:
   // inspector
   value_type get(size_t x, size_t y) const { return cache.get(x, y); }
 
-  BlockCache2<value_type, store_type> cache; // cache of decompressed blocks
+  typename container_type::cache_type cache; // cache of decompressed blocks
 };
 
 // thread-safe read-write view of private 2D (sub)array
@@ -485,10 +485,10 @@ protected:
   void set(size_t x, size_t y, value_type val) { cache.set(x, y, val); }
 
   // in-place updates
-  void add(size_t x, size_t y, value_type val) { cache.ref(x, y) += val; }
-  void sub(size_t x, size_t y, value_type val) { cache.ref(x, y) -= val; }
-  void mul(size_t x, size_t y, value_type val) { cache.ref(x, y) *= val; }
-  void div(size_t x, size_t y, value_type val) { cache.ref(x, y) /= val; }
+  void add(size_t x, size_t y, value_type val) { cache.add(x, y, val); }
+  void sub(size_t x, size_t y, value_type val) { cache.sub(x, y, val); }
+  void mul(size_t x, size_t y, value_type val) { cache.mul(x, y, val); }
+  void div(size_t x, size_t y, value_type val) { cache.div(x, y, val); }
 };
 
 } // dim2
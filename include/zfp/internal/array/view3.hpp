@@ -484,7 +484,7 @@ protected:
   // inspector
   value_type get(size_t x, size_t y, size_t z) const { return cache.get(x, y, z); }
 
-  BlockCache3<value_type, store_type> cache; // cache of decompressed blocks
+  typename container_type::cache_type cache; // cache of decompressed blocks
 };
 
 // thread-safe read-write view of private 3D (sub)array
@@ -571,10 +571,10 @@ protected:
   void set(size_t x, size_t y, size_t z, value_type val) { cache.set(x, y, z, val); }
 
   // in-place updates
-  void add(size_t x, size_t y, size_t z, value_type val) { cache.ref(x, y, z) += val; }
-  void sub(size_t x, size_t y, size_t z, value_type val) { cache.ref(x, y, z) -= val; }
-  void mul(size_t x, size_t y, size_t z, value_type val) { cache.ref(x, y, z) *= val; }
-  void div(size_t x, size_t y, size_t z, value_type val) { cache.ref(x, y, z) /= val; }
+  void add(size_t x, size_t y, size_t z, value_type val) { cache.add(x, y, z, val); }
+  void sub(size_t x, size_t y, size_t z, value_type val) { cache.sub(x, y, z, val); }
+  void mul(size_t x, size_t y, size_t z, value_type val) { cache.mul(x, y, z, val); }
+  void div(size_t x, size_t y, size_t z, value_type val) { cache.div(x, y, z, val); }
 };
 
 } // dim3
@@ -569,7 +569,7 @@ protected:
   // inspector
   value_type get(size_t x, size_t y, size_t z, size_t w) const { return cache.get(x, y, z, w); }
 
-  BlockCache4<value_type, store_type> cache; // cache of decompressed blocks
+  typename container_type::cache_type cache; // cache of decompressed blocks
 };
 
 // thread-safe read-write view of private 4D (sub)array
@@ -666,10 +666,10 @@ protected:
   void set(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.set(x, y, z, w, val); }
 
   // in-place updates
-  void add(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.ref(x, y, z, w) += val; }
-  void sub(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.ref(x, y, z, w) -= val; }
-  void mul(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.ref(x, y, z, w) *= val; }
-  void div(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.ref(x, y, z, w) /= val; }
+  void add(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.add(x, y, z, w, val); }
+  void sub(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.sub(x, y, z, w, val); }
+  void mul(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.mul(x, y, z, w, val); }
+  void div(size_t x, size_t y, size_t z, size_t w, value_type val) { cache.div(x, y, z, w, val); }
 };
 
 } // dim4
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include "zfp.h"
+#include "zfp/internal/cfp/stats.h"
 
 typedef struct {
   void* object;
@@ -112,6 +113,8 @@ typedef struct {
   void (*set_cache_size)(cfp_array3d self, size_t bytes);
   void (*clear_cache)(const cfp_array3d self);
   void (*flush_cache)(const cfp_array3d self);
+  cfp_cache_stats (*cache_stats)(const cfp_array3d self);
+  void (*reset_cache_stats)(const cfp_array3d self);
   size_t (*size_bytes)(const cfp_array3d self, uint mask);
   size_t (*compressed_size)(const cfp_array3d self);
   void* (*compressed_data)(const cfp_array3d self);
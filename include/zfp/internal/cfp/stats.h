@@ -0,0 +1,14 @@
+#ifndef CFP_STATS_H
+#define CFP_STATS_H
+
+#include "zfp.h"
+
+typedef struct {
+  uint64 hits;        /* number of accesses to cached blocks */
+  uint64 misses;      /* number of accesses to uncached blocks */
+  uint64 writebacks;  /* number of modified blocks compressed */
+  double decode_time; /* seconds spent decompressing blocks */
+  double encode_time; /* seconds spent compressing blocks */
+} cfp_cache_stats;
+
+#endif
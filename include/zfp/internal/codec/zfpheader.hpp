@@ -4,7 +4,8 @@ public:
   // serialization: construct header from array
   header(const zfp::array& a) :
     zfp::array::header(a),
-    bit_rate(a.rate())
+    bit_rate(a.rate()),
+    byte_size(0)
   {
     std::string error;
 
@@ -36,10 +37,12 @@ public:
       }
 
       if (field) {
-        // write header to buffer
-        size_t bits = zfp_write_header(zfp, field, ZFP_HEADER_FULL);
-        if (bits != bit_size)
+        // write short header unless array dimensions require extended header
+        bool extended = (zfp_field_metadata(field) == ZFP_META_NULL);
+        size_t bits = zfp_write_header(zfp, field, extended ? ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED : ZFP_HEADER_FULL);
+        if (bits != bit_size(extended, dimensionality()))
           error = "zfp header length does not match expected length";
+        byte_size = (bits + CHAR_BIT - 1) / CHAR_BIT;
         zfp_stream_flush(zfp);
         zfp_field_free(field);
       }
@@ -54,24 +57,38 @@ public:
 
   // deserialization: construct header from memory buffer of optional size
   header(const void* data, size_t bytes = 0) :
-    bit_rate(0)
+    bit_rate(0),
+    byte_size(0)
   {
     std::string error;
 
+    // copy short header, which is also a prefix of any extended header
+    std::fill(buffer, buffer + word_size, 0);
+    byte_size = (bit_size(false, 0) + CHAR_BIT - 1) / CHAR_BIT;
+    if (!bytes || bytes >= byte_size)
+      std::memcpy(buffer, data, byte_size);
+    // extended headers set the high bit of the codec version in the magic
+    const uint64 magic = 'z' + ('f' << 8) + ('p' << 16);
+    if ((buffer[0] & 0xffffffffu) == magic + (uint64(zfp_codec_version + 0x80u) << 24)) {
+      // metadata determines extended header size
+      uint d = static_cast<uint>((buffer[0] >> (ZFP_MAGIC_BITS + 2)) & 0x3u) + 1;
+      byte_size = bit_size(true, d) / CHAR_BIT;
+      if (!bytes || bytes == byte_size)
+        std::memcpy(buffer, data, byte_size);
+    }
+
     // ensure byte size matches
     if (bytes && bytes != byte_size)
       error = "zfp header length does not match expectations";
     else {
-      // copy and parse header
-      std::fill(buffer, buffer + word_size, 0);
-      std::memcpy(buffer, data, byte_size);
+      // parse header
       bitstream* stream = stream_open(buffer, sizeof(buffer));
       zfp_stream* zfp = zfp_stream_open(stream);
       zfp_field field;
       size_t bits = zfp_read_header(zfp, &field, ZFP_HEADER_FULL);
       if (!bits)
         error = "zfp header is corrupt";
-      else if (bits != bit_size)
+      else if (bits != CHAR_BIT * byte_size)
         error = "zfp deserialization supports only short headers";
       else if (zfp_stream_compression_mode(zfp) != zfp_mode_fixed_rate)
         error = "zfp deserialization supports only fixed-rate mode";
@@ -113,10 +130,19 @@ public:
   }
 
 protected:
-  // header size measured in bits, bytes, and 64-bit words
-  static const size_t bit_size = ZFP_MAGIC_BITS + ZFP_META_BITS + ZFP_MODE_SHORT_BITS;
-  static const size_t byte_size = (bit_size + CHAR_BIT - 1) / CHAR_BIT;
-  static const size_t word_size = (byte_size + sizeof(uint64) - 1) / sizeof(uint64);
+  // size in bits of short or extended d-dimensional header with short mode
+  static size_t bit_size(bool extended, uint d)
+  {
+    if (!extended)
+      return ZFP_MAGIC_BITS + ZFP_META_BITS + ZFP_MODE_SHORT_BITS;
+    // magic, metadata, 64-bit dimensions, mode, checksum
+    size_t bits = ZFP_MAGIC_BITS + ZFP_META_EXT_BITS + 64 * d + ZFP_MODE_SHORT_BITS + ZFP_CHECKSUM_BITS;
+    // extended headers are padded to whole 64-bit words
+    return zfp::internal::round_up(bits, size_t(64));
+  }
+
+  // maximum header size measured in 64-bit words
+  static const size_t word_size = ZFP_HEADER_EXT_MAX_BITS / 64;
 
   using zfp::array::header::type;
   using zfp::array::header::nx;
@@ -125,5 +151,6 @@ protected:
   using zfp::array::header::nw;
 
   double bit_rate;          // array rate in bits per value
+  size_t byte_size;         // header byte size
   uint64 buffer[word_size]; // header data
 };
@@ -25,6 +25,12 @@ cdef extern from "zfp.h":
         zfp_mode_fixed_accuracy  = 4,
         zfp_mode_reversible      = 5
 
+    ctypedef enum zfp_exec_policy:
+        zfp_exec_serial  = 0,
+        zfp_exec_omp     = 1,
+        zfp_exec_cuda    = 2,
+        zfp_exec_threads = 3
+
     # structs
     ctypedef struct zfp_field:
         zfp_type _type "type"
@@ -41,6 +47,9 @@ cdef extern from "zfp.h":
     cython.uint ZFP_HEADER_META
     cython.uint ZFP_HEADER_MODE
     cython.uint ZFP_HEADER_FULL
+    cython.uint ZFP_HEADER_EXTENDED
+    cython.uint ZFP_HEADER_MAX_BITS
+    cython.uint ZFP_HEADER_EXT_MAX_BITS
 
     # function declarations
     zfp_stream* zfp_stream_open(bitstream* stream)
@@ -58,6 +67,10 @@ cdef extern from "zfp.h":
     double zfp_stream_accuracy(zfp_stream* stream)
     double zfp_stream_rate(zfp_stream* stream, cython.uint dims)
     cython.uint zfp_stream_precision(const zfp_stream* stream)
+    zfp_bool zfp_stream_set_execution(zfp_stream* stream, zfp_exec_policy policy)
+    zfp_bool zfp_stream_set_omp_threads(zfp_stream* stream, cython.uint threads)
+    zfp_bool zfp_stream_set_omp_chunk_size(zfp_stream* stream, cython.uint chunk_size)
+    void zfp_stream_set_chunk_index(zfp_stream* stream, zfp_bool enable)
     zfp_field* zfp_field_alloc()
     zfp_field* zfp_field_1d(void* pointer, zfp_type, size_t nx)
     zfp_field* zfp_field_2d(void* pointer, zfp_type, size_t nx, size_t ny)
@@ -22,6 +22,7 @@ HEADER_MAGIC = ZFP_HEADER_MAGIC
 HEADER_META = ZFP_HEADER_META
 HEADER_MODE = ZFP_HEADER_MODE
 HEADER_FULL = ZFP_HEADER_FULL
+HEADER_EXTENDED = ZFP_HEADER_EXTENDED
 
 # export enums
 type_none = zfp_type_none
@@ -34,6 +35,9 @@ mode_expert = zfp_mode_expert
 mode_fixed_rate = zfp_mode_fixed_rate
 mode_fixed_precision = zfp_mode_fixed_precision
 mode_fixed_accuracy = zfp_mode_fixed_accuracy
+exec_serial = zfp_exec_serial
+exec_omp = zfp_exec_omp
+exec_cuda = zfp_exec_cuda
 
 
 cpdef dtype_to_ztype(dtype):
@@ -137,54 +141,206 @@ cdef class Memory:
     def __exit__(self, exc_type, exc_value, exc_tb):
         free(self.data)
 
+cdef zfp_stream* _init_stream(
+    int ndim,
+    double tolerance,
+    double rate,
+    int precision,
+    execution,
+    int threads,
+    int chunk_size,
+    chunk_index,
+) except NULL:
+    num_params_set = sum([1 for x in [tolerance, rate, precision] if x >= 0])
+    if num_params_set > 1:
+        raise ValueError("Only one of tolerance, rate, or precision can be set")
+
+    cdef zfp_stream* stream = zfp_stream_open(NULL)
+    try:
+        _set_compression_mode(stream, zfp_type_none, ndim, tolerance, rate, precision)
+        _set_execution(stream, execution, threads, chunk_size, chunk_index)
+    except:
+        zfp_stream_close(stream)
+        raise
+    return stream
+
+cdef size_t _maximum_size(zfp_stream* stream, zfp_field* field):
+    # zfp_stream_maximum_size() allows only for the short header; reserve
+    # whole words for the extended header written for large arrays
+    cdef size_t size = zfp_stream_maximum_size(stream, field)
+    if size:
+        size += (ZFP_HEADER_EXT_MAX_BITS - ZFP_HEADER_MAX_BITS + 63) // 64 * 8
+    return size
+
+cdef size_t _compress_to_buffer(
+    zfp_stream* stream,
+    zfp_field* field,
+    void* data,
+    size_t size,
+    write_header,
+) except 0:
+    # the caller guarantees that size >= _maximum_size()
+    cdef size_t compressed_size
+    cdef bitstream* bstream = stream_open(data, size)
+    zfp_stream_set_bit_stream(stream, bstream)
+    try:
+        zfp_stream_rewind(stream)
+        # write the full header so we can reconstruct the numpy array on
+        # decompression; fall back on the extended header for arrays too
+        # large for the short header
+        if write_header and zfp_write_header(stream, field, HEADER_FULL) == 0 \
+                and zfp_write_header(stream, field, HEADER_FULL | HEADER_EXTENDED) == 0:
+            raise RuntimeError("Failed to write header to stream")
+        with nogil:
+            compressed_size = zfp_compress(stream, field)
+        if compressed_size == 0:
+            raise RuntimeError("Failed to write to stream")
+    finally:
+        zfp_stream_set_bit_stream(stream, NULL)
+        stream_close(bstream)
+    return compressed_size
+
+cpdef size_t maximum_size(
+    np.ndarray arr,
+    double tolerance = -1,
+    double rate = -1,
+    int precision = -1,
+    execution=None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index=False,
+) except? 0:
+    if arr is None:
+        raise TypeError("Input array cannot be None")
+    cdef zfp_stream* stream = _init_stream(
+        arr.ndim, tolerance, rate, precision,
+        execution, threads, chunk_size, chunk_index
+    )
+    cdef zfp_field* field = NULL
+    try:
+        field = _init_field(arr)
+        return _maximum_size(stream, field)
+    finally:
+        if field != NULL:
+            zfp_field_free(field)
+        zfp_stream_close(stream)
+
 cpdef bytes compress_numpy(
     np.ndarray arr,
     double tolerance = -1,
     double rate = -1,
     int precision = -1,
-    write_header=True
+    write_header=True,
+    execution=None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index=False,
 ):
     # Input validation
     if arr is None:
         raise TypeError("Input array cannot be None")
-    num_params_set = sum([1 for x in [tolerance, rate, precision] if x >= 0])
-    if num_params_set > 1:
-        raise ValueError("Only one of tolerance, rate, or precision can be set")
 
     # Setup zfp structs to begin compression
-    cdef zfp_field* field = _init_field(arr)
-    cdef zfp_stream* stream = zfp_stream_open(NULL)
-
-    cdef zfp_type ztype = zfp_type_none
-    cdef int ndim = arr.ndim
-    _set_compression_mode(stream, ztype, ndim, tolerance, rate, precision)
-
-    # Allocate space based on the maximum size potentially required by zfp to
-    # store the compressed array
+    cdef zfp_stream* stream = _init_stream(
+        arr.ndim, tolerance, rate, precision,
+        execution, threads, chunk_size, chunk_index
+    )
+    cdef zfp_field* field = NULL
     cdef bytes compress_str = None
-    cdef size_t maxsize = zfp_stream_maximum_size(stream, field)
+    cdef size_t maxsize
+    cdef size_t compressed_size
     try:
+        field = _init_field(arr)
+        # Allocate space based on the maximum size potentially required by
+        # zfp to store the compressed array
+        maxsize = _maximum_size(stream, field)
         with Memory(maxsize) as data:
-            bstream = stream_open(data, maxsize)
-            zfp_stream_set_bit_stream(stream, bstream)
-            zfp_stream_rewind(stream)
-            # write the full header so we can reconstruct the numpy array on
-            # decompression
-            if write_header and zfp_write_header(stream, field, HEADER_FULL) == 0:
-                raise RuntimeError("Failed to write header to stream")
-            with nogil:
-                compressed_size = zfp_compress(stream, field)
-            if compressed_size == 0:
-                raise RuntimeError("Failed to write to stream")
+            compressed_size = _compress_to_buffer(
+                stream, field, data, maxsize, write_header
+            )
             # copy the compressed data into a perfectly sized bytes object
             compress_str = (<char *>data)[:compressed_size]
     finally:
-        zfp_field_free(field)
+        if field != NULL:
+            zfp_field_free(field)
         zfp_stream_close(stream)
-        stream_close(bstream)
 
     return compress_str
 
+cpdef size_t compress_into(
+    np.ndarray arr,
+    out,
+    double tolerance = -1,
+    double rate = -1,
+    int precision = -1,
+    write_header=True,
+    execution=None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index=False,
+) except? 0:
+    if arr is None:
+        raise TypeError("Input array cannot be None")
+    if out is None:
+        raise TypeError("Output buffer cannot be None")
+
+    # view any writable, contiguous buffer as bytes
+    cdef uint8_t[::1] buffer = memoryview(out).cast("B")
+    cdef zfp_stream* stream = _init_stream(
+        arr.ndim, tolerance, rate, precision,
+        execution, threads, chunk_size, chunk_index
+    )
+    cdef zfp_field* field = NULL
+    cdef size_t maxsize
+    try:
+        field = _init_field(arr)
+        # zfp does not bounds check the stream, so the buffer must be able to
+        # hold the largest possible compressed stream
+        maxsize = _maximum_size(stream, field)
+        if <size_t>buffer.shape[0] < maxsize:
+            raise ValueError(
+                "Output buffer of {} bytes is smaller than the maximum "
+                "compressed size of {} bytes".format(buffer.shape[0], maxsize)
+            )
+        return _compress_to_buffer(
+            stream, field, &buffer[0], buffer.shape[0], write_header
+        )
+    finally:
+        if field != NULL:
+            zfp_field_free(field)
+        zfp_stream_close(stream)
+
+cpdef memoryview compress_view(
+    np.ndarray arr,
+    out=None,
+    double tolerance = -1,
+    double rate = -1,
+    int precision = -1,
+    write_header=True,
+    execution=None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index=False,
+):
+    cdef size_t compressed_size
+    if out is None:
+        out = bytearray(maximum_size(
+            arr, tolerance, rate, precision,
+            execution, threads, chunk_size, chunk_index
+        ))
+        compressed_size = compress_into(
+            arr, out, tolerance, rate, precision, write_header,
+            execution, threads, chunk_size, chunk_index
+        )
+        # shrink the buffer to the compressed size before it is exported
+        del out[compressed_size:]
+        return memoryview(out)
+    compressed_size = compress_into(
+        arr, out, tolerance, rate, precision, write_header,
+        execution, threads, chunk_size, chunk_index
+    )
+    return memoryview(out).cast("B")[:compressed_size]
+
 cdef view.array _decompress_with_view(
     zfp_field* field,
     zfp_stream* stream,
@@ -238,6 +394,43 @@ cdef _set_compression_mode(
     else:
         zfp_stream_set_reversible(stream)
 
+zfp_exec_map = {
+    "serial": zfp_exec_serial,
+    "omp": zfp_exec_omp,
+    "cuda": zfp_exec_cuda,
+}
+cdef _set_execution(
+    zfp_stream *stream,
+    execution = None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index = False,
+):
+    # a thread count or chunk size implies OpenMP execution
+    if execution is None:
+        execution = "omp" if threads > 0 or chunk_size > 0 else "serial"
+    if threads < 0 or chunk_size < 0:
+        raise ValueError("threads and chunk_size must be nonnegative")
+    if execution in zfp_exec_map:
+        policy = zfp_exec_map[execution]
+    elif execution in zfp_exec_map.values():
+        policy = execution
+    else:
+        raise ValueError("Unknown execution policy: {}".format(execution))
+    if policy != zfp_exec_omp and (threads > 0 or chunk_size > 0):
+        raise ValueError("threads and chunk_size require OpenMP execution")
+    if not zfp_stream_set_execution(stream, policy):
+        raise RuntimeError(
+            "Execution policy {} is not supported by this build of "
+            "zfp".format(execution)
+        )
+    if policy == zfp_exec_omp:
+        zfp_stream_set_omp_threads(stream, threads)
+        zfp_stream_set_omp_chunk_size(stream, chunk_size)
+    # None keeps the setting, e.g., as recorded in an extended header
+    if chunk_index is not None:
+        zfp_stream_set_chunk_index(stream, bool(chunk_index))
+
 cdef _validate_4d_list(in_list, list_name):
     # Validate that the input list is either a valid list for strides or shape
     # Specifically, check it is a list and the length is > 0 and <= 4
@@ -265,6 +458,10 @@ cpdef np.ndarray _decompress(
     double tolerance = -1,
     double rate = -1,
     int precision = -1,
+    execution=None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index=False,
 ):
     if compressed_data is None:
         raise TypeError("compressed_data cannot be None")
@@ -290,6 +487,7 @@ cpdef np.ndarray _decompress(
         zfp_field_set_type(field, ztype)
         ndim = sum([1 for x in zshape if x > 0])
         _set_compression_mode(stream, ztype, ndim, tolerance, rate, precision)
+        _set_execution(stream, execution, threads, chunk_size, chunk_index)
 
         # pad the shape with zeros to reach len == 4
         # strides = gen_padded_int_list(reversed(strides), pad=0, length=4)
@@ -342,6 +540,10 @@ cpdef np.ndarray _decompress(
 
 cpdef np.ndarray decompress_numpy(
     const uint8_t[::1] compressed_data,
+    execution=None,
+    int threads = 0,
+    int chunk_size = 0,
+    chunk_index=None,
 ):
     if compressed_data is None:
         raise TypeError("compressed_data cannot be None")
@@ -358,6 +560,7 @@ cpdef np.ndarray decompress_numpy(
     try:
         if zfp_read_header(stream, field, HEADER_FULL) == 0:
             raise ValueError("Failed to read required zfp header")
+        _set_execution(stream, execution, threads, chunk_size, chunk_index)
         output = np.asarray(_decompress_with_view(field, stream))
     finally:
         zfp_field_free(field)
@@ -421,3 +624,242 @@ cpdef dict header(const uint8_t[::1] compressed_data):
         zfp_field_free(field)
         zfp_stream_close(stream)
         stream_close(bstream)
+
+cdef _decompress_tile(
+    const uint8_t[::1] compressed_data,
+    np.ndarray out,
+    double tolerance,
+    double rate,
+    int precision,
+):
+    # decompress a headerless stream into a possibly strided ndarray view
+    cdef zfp_field* field = _init_field(out)
+    cdef bitstream* bstream = stream_open(
+        <void *>&compressed_data[0],
+        len(compressed_data)
+    )
+    cdef zfp_stream* stream = zfp_stream_open(bstream)
+    cdef size_t ret
+    try:
+        zfp_stream_rewind(stream)
+        # zfp_type_none matches the mode set by compress_numpy
+        _set_compression_mode(stream, zfp_type_none, out.ndim, tolerance, rate, precision)
+        with nogil:
+            ret = zfp_decompress(stream, field)
+        if ret == 0:
+            raise RuntimeError("error during zfp decompression")
+    finally:
+        zfp_field_free(field)
+        zfp_stream_close(stream)
+        stream_close(bstream)
+
+cdef _run_tasks(func, tasks, int threads):
+    # zfp releases the GIL, so tasks run concurrently on a thread pool
+    if threads == 1 or len(tasks) <= 1:
+        return [func(task) for task in tasks]
+    from concurrent.futures import ThreadPoolExecutor
+    with ThreadPoolExecutor(max_workers=threads if threads > 0 else None) as pool:
+        return list(pool.map(func, tasks))
+
+cdef _tile_parts(indices, size_t size, size_t extent):
+    # Split the positive-step range of indices into one part per tile it
+    # touches: (tile, tile extent, indices within tile, positions in result)
+    parts = []
+    cdef size_t count = len(indices)
+    if count == 0:
+        return parts
+    start = indices.start
+    step = indices.step
+    for t in range(indices[0] // extent, indices[-1] // extent + 1):
+        t0 = t * extent
+        t1 = min(t0 + extent, size)
+        # first selected index in tile and one past the last one
+        j0 = max(0, -((start - t0) // step))
+        j1 = min(count, -((start - t1) // step))
+        if j0 < j1:
+            parts.append((
+                t,
+                t1 - t0,
+                slice(indices[j0] - t0, indices[j1 - 1] - t0 + 1, step),
+                slice(j0, j1),
+            ))
+    return parts
+
+# default tile extent per dimension, giving 2^16 to 2^18 values per tile
+_default_tile_extent = {1: 65536, 2: 256, 3: 64, 4: 16}
+
+cdef class ZfpTiledArray:
+    """
+    NumPy array compressed as independently decodable tiles.  Indexing
+    decompresses only the tiles that overlap the selection.
+    """
+    cdef readonly tuple shape
+    cdef readonly object dtype
+    cdef readonly tuple tile_shape
+    cdef readonly tuple tiles
+    cdef readonly double tolerance
+    cdef readonly double rate
+    cdef readonly int precision
+    cdef public int threads
+    cdef bytes _data
+    cdef np.ndarray _offsets
+
+    def __init__(
+        self,
+        np.ndarray arr,
+        tile_shape=None,
+        double tolerance = -1,
+        double rate = -1,
+        int precision = -1,
+        int threads = 0,
+    ):
+        if arr is None:
+            raise TypeError("Input array cannot be None")
+        dtype_to_ztype(arr.dtype)
+        if arr.ndim < 1 or arr.ndim > 4:
+            raise ValueError("Only 1 to 4 dimensions are supported")
+        num_params_set = sum([1 for x in [tolerance, rate, precision] if x >= 0])
+        if num_params_set > 1:
+            raise ValueError("Only one of tolerance, rate, or precision can be set")
+        if threads < 0:
+            raise ValueError("threads must be nonnegative")
+        if tile_shape is None:
+            tile_shape = (_default_tile_extent[arr.ndim],) * arr.ndim
+        tile_shape = tuple(int(x) for x in tile_shape)
+        if len(tile_shape) != arr.ndim:
+            raise ValueError(
+                "tile_shape {} does not match array of {} dimensions".format(
+                    tile_shape, arr.ndim
+                )
+            )
+        if any(x <= 0 or x % 4 for x in tile_shape):
+            raise ValueError(
+                "tile_shape {} must be positive multiples of 4".format(tile_shape)
+            )
+
+        self.shape = tuple(np.shape(arr))
+        self.dtype = arr.dtype
+        self.tile_shape = tile_shape
+        self.tiles = tuple(-(-n // t) for n, t in zip(self.shape, tile_shape))
+        self.tolerance = tolerance
+        self.rate = rate
+        self.precision = precision
+        self.threads = threads
+
+        # compress tiles in C order as headerless streams
+        def compress_tile(index):
+            tile = tuple(
+                slice(i * t, (i + 1) * t) for i, t in zip(index, tile_shape)
+            )
+            return compress_numpy(arr[tile], tolerance, rate, precision, False)
+        streams = _run_tasks(
+            compress_tile, list(np.ndindex(*self.tiles)), threads
+        )
+        self._offsets = np.zeros(len(streams) + 1, dtype=np.uint64)
+        np.cumsum([len(s) for s in streams], out=self._offsets[1:])
+        self._data = b"".join(streams)
+
+    @property
+    def ndim(self):
+        return len(self.shape)
+
+    @property
+    def size(self):
+        return functools.reduce(operator.mul, self.shape, 1)
+
+    @property
+    def nbytes(self):
+        return self.size * self.dtype.itemsize
+
+    @property
+    def compressed_size(self):
+        return len(self._data)
+
+    @property
+    def compressed_data(self):
+        """Concatenated tile streams; tile i spans offsets[i]:offsets[i+1]."""
+        return self._data
+
+    @property
+    def offsets(self):
+        offsets = self._offsets.view()
+        offsets.flags.writeable = False
+        return offsets
+
+    def __len__(self):
+        return self.shape[0]
+
+    def __array__(self, dtype=None, copy=None):
+        output = self[...]
+        return output if dtype is None else output.astype(dtype, copy=False)
+
+    def __getitem__(self, key):
+        # normalize key to one range of indices per dimension
+        if not isinstance(key, tuple):
+            key = (key,)
+        if any(k is Ellipsis for k in key):
+            i = [k is Ellipsis for k in key].index(True)
+            key = key[:i] + (slice(None),) * (self.ndim - len(key) + 1) + key[i + 1:]
+        if any(k is Ellipsis for k in key):
+            raise IndexError("an index can only have a single ellipsis")
+        if len(key) > self.ndim:
+            raise IndexError("too many indices for ZfpTiledArray")
+        key = key + (slice(None),) * (self.ndim - len(key))
+
+        ranges = []
+        squeeze = []
+        flip = []
+        for k, n in zip(key, self.shape):
+            if isinstance(k, slice):
+                indices = range(*k.indices(n))
+                squeeze.append(slice(None))
+            else:
+                try:
+                    i = operator.index(k)
+                except TypeError:
+                    raise IndexError(
+                        "only integers, slices, and ellipsis are valid indices"
+                    )
+                if not -n <= i < n:
+                    raise IndexError(
+                        "index {} is out of bounds for size {}".format(i, n)
+                    )
+                i %= n
+                indices = range(i, i + 1)
+                squeeze.append(0)
+            # decode in increasing order and reverse afterwards
+            if indices.step < 0:
+                indices = indices[::-1]
+                flip.append(slice(None, None, -1))
+            else:
+                flip.append(slice(None))
+            ranges.append(indices)
+
+        output = np.empty([len(r) for r in ranges], dtype=self.dtype)
+        parts = [
+            _tile_parts(r, n, t)
+            for r, n, t in zip(ranges, self.shape, self.tile_shape)
+        ]
+
+        def decompress_tile(part):
+            tile = np.ravel_multi_index([p[0] for p in part], self.tiles)
+            data = memoryview(self._data)[
+                self._offsets[tile] : self._offsets[tile + 1]
+            ]
+            extent = tuple(p[1] for p in part)
+            local = tuple(p[2] for p in part)
+            target = output[tuple(p[3] for p in part)]
+            if target.shape == extent:
+                # whole tile is selected; decompress in place
+                _decompress_tile(
+                    data, target, self.tolerance, self.rate, self.precision
+                )
+            else:
+                values = np.empty(extent, dtype=self.dtype)
+                _decompress_tile(
+                    data, values, self.tolerance, self.rate, self.precision
+                )
+                target[...] = values[local]
+        _run_tasks(decompress_tile, list(itertools.product(*parts)), self.threads)
+
+        return output[tuple(flip)][tuple(squeeze)]
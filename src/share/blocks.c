@@ -0,0 +1,94 @@
+/* set up field that describes count contiguous blocks stored back to back */
+static zfp_bool
+blocks_field(zfp_field* field, zfp_type type, uint dims, void* data, size_t count)
+{
+  switch (type) {
+    case zfp_type_int32:
+    case zfp_type_int64:
+    case zfp_type_float:
+    case zfp_type_double:
+      break;
+    default:
+      return zfp_false;
+  }
+  if (dims < 1 || dims > 4 || !count)
+    return zfp_false;
+
+  /* blocks are laid out along the slowest varying dimension */
+  field->type = type;
+  field->nx = dims == 1 ? 4 * count : 4;
+  field->ny = dims == 2 ? 4 * count : dims > 2 ? 4 : 0;
+  field->nz = dims == 3 ? 4 * count : dims > 3 ? 4 : 0;
+  field->nw = dims == 4 ? 4 * count : 0;
+  field->sx = field->sy = field->sz = field->sw = 0;
+  field->data = data;
+
+  return zfp_true;
+}
+
+/* compress count blocks under stream's execution policy; return bits written */
+static size_t
+compress_blocks(zfp_stream* zfp, const zfp_field* field, size_t count, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  bitstream_offset offset = stream_wtell(zfp->stream);
+
+  switch (zfp->exec.policy) {
+    case zfp_exec_serial:
+      if (zfp->chunk_index) {
+        /* serial compression produces a single chunk */
+        bitstream_offset begin = chunk_index_reserve(zfp->stream, 1);
+        bitstream* index;
+        compress(zfp, field, 0, count);
+        index = chunk_index_open(zfp->stream, begin, 1);
+        chunk_index_write(index, stream_wtell(zfp->stream) - begin);
+        chunk_index_close(index);
+      }
+      else
+        compress(zfp, field, 0, count);
+      break;
+#ifdef _OPENMP
+    case zfp_exec_omp:
+      compress_chunks_omp(zfp, field, count, compress);
+      break;
+#endif
+    case zfp_exec_threads:
+      compress_chunks_threads(zfp, field, count, compress);
+      break;
+    default:
+      return 0;
+  }
+
+  return (size_t)(stream_wtell(zfp->stream) - offset);
+}
+
+/* decompress count blocks under stream's execution policy; return bits read */
+static size_t
+decompress_blocks(zfp_stream* zfp, zfp_field* field, size_t count, void (*decompress)(zfp_stream*, zfp_field*, size_t, size_t))
+{
+  bitstream_offset offset = stream_rtell(zfp->stream);
+
+  /* return 0 if chunk index is corrupt */
+  if (zfp->chunk_index && !chunk_index_valid(zfp->stream, count))
+    return 0;
+
+  switch (zfp->exec.policy) {
+    case zfp_exec_serial:
+      /* chunks are contiguous; skip index */
+      if (zfp->chunk_index)
+        chunk_index_skip(zfp->stream, count);
+      decompress(zfp, field, 0, count);
+      break;
+#ifdef _OPENMP
+    case zfp_exec_omp:
+      decompress_chunks_omp(zfp, field, count, decompress);
+      break;
+#endif
+    case zfp_exec_threads:
+      decompress_chunks_threads(zfp, field, count, decompress);
+      break;
+    default:
+      return 0;
+  }
+
+  return (size_t)(stream_rtell(zfp->stream) - offset);
+}
@@ -0,0 +1,140 @@
+/* state shared by tasks that estimate compressed size */
+typedef struct {
+  const zfp_stream* stream;
+  const zfp_field* field;
+  bitstream_size* bits; /* per-chunk number of bits of sampled blocks */
+  size_t blocks;        /* number of blocks in field */
+  size_t samples;       /* number of blocks sampled */
+  size_t chunks;        /* number of chunks that samples are partitioned into */
+  size_t size;          /* byte size of scratch buffer that holds one block */
+  void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t);
+} estimate_state;
+
+/* number of chunks that compression of blocks is partitioned into */
+static size_t
+chunk_count(const zfp_stream* stream, size_t blocks)
+{
+  switch (stream->exec.policy) {
+#ifdef _OPENMP
+    case zfp_exec_omp:
+      return chunk_count_omp(stream, blocks, thread_count_omp(stream));
+#endif
+    case zfp_exec_threads:
+      return chunk_count_threads(stream, blocks, thread_count_threads(stream));
+    default:
+      return 1;
+  }
+}
+
+/* block sampled from the sample'th of samples equal-size runs of blocks */
+static size_t
+estimate_block(size_t blocks, size_t samples, size_t sample)
+{
+  size_t bmin = chunk_offset(blocks, samples, sample + 0);
+  size_t bmax = chunk_offset(blocks, samples, sample + 1);
+  uint64 h = (uint64)sample;
+
+  if (bmax - bmin < 2)
+    return bmin;
+
+  /* pick pseudo-random but reproducible block within run (splitmix64) */
+  h += UINT64C(0x9e3779b97f4a7c15);
+  h = (h ^ (h >> 30)) * UINT64C(0xbf58476d1ce4e5b9);
+  h = (h ^ (h >> 27)) * UINT64C(0x94d049bb133111eb);
+  h ^= h >> 31;
+
+  return bmin + (size_t)(h % (bmax - bmin));
+}
+
+/* compress sampled blocks of one chunk to scratch stream and count bits */
+static void
+estimate_task(void* data, size_t chunk)
+{
+  const estimate_state* state = (const estimate_state*)data;
+  /* determine range of samples assigned to this task */
+  size_t smin = chunk_offset(state->samples, state->chunks, chunk + 0);
+  size_t smax = chunk_offset(state->samples, state->chunks, chunk + 1);
+  size_t sample;
+  /* set up task-local scratch stream; no output is retained */
+  bitstream_size bits = 0;
+  zfp_stream s = *state->stream;
+  void* buffer = malloc(state->size);
+  bitstream* scratch = buffer ? stream_open(buffer, state->size) : NULL;
+  if (!scratch) {
+    free(buffer);
+    state->bits[chunk] = ~(bitstream_size)0;
+    return;
+  }
+  zfp_stream_set_bit_stream(&s, scratch);
+  /* encode one block at a time, rewinding the stream after each */
+  for (sample = smin; sample < smax; sample++) {
+    size_t block = estimate_block(state->blocks, state->samples, sample);
+    stream_rewind(scratch);
+    state->compress(&s, state->field, block, block + 1);
+    bits += stream_wtell(scratch);
+  }
+  state->bits[chunk] = bits;
+  stream_close(scratch);
+  free(buffer);
+}
+
+/* estimate compressed bit size of all blocks from that of sampled blocks */
+static zfp_bool
+estimate_bits(const zfp_stream* stream, const zfp_field* field, size_t samples, bitstream_size* bits, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  estimate_state state;
+  bitstream_size sum = 0;
+  zfp_field f = *field;
+  size_t chunk;
+
+  /* scratch buffer must hold one block plus a trailing word */
+  f.nx = f.nx ? 4 : 0;
+  f.ny = f.ny ? 4 : 0;
+  f.nz = f.nz ? 4 : 0;
+  f.nw = f.nw ? 4 : 0;
+  state.size = zfp_stream_maximum_size(stream, &f) + stream_word_bits / CHAR_BIT;
+
+  state.stream = stream;
+  state.field = field;
+  state.blocks = zfp_field_blocks(field);
+  state.samples = samples;
+  state.chunks = chunk_count(stream, samples);
+  state.compress = compress;
+  state.bits = malloc(state.chunks * sizeof(bitstream_size));
+  if (!state.bits)
+    return zfp_false;
+
+  /* compress chunks of sampled blocks in parallel */
+  switch (stream->exec.policy) {
+#ifdef _OPENMP
+    case zfp_exec_omp:
+      reset_timings_omp(stream);
+      parallel_for_omp(stream, thread_count_omp(stream), state.chunks, estimate_task, &state);
+      break;
+#endif
+    case zfp_exec_threads:
+      parallel_for_threads(stream, state.chunks, estimate_task, &state);
+      break;
+    default:
+      estimate_task(&state, 0);
+      break;
+  }
+
+  /* sum bits over chunks */
+  for (chunk = 0; chunk < state.chunks; chunk++) {
+    if (state.bits[chunk] == ~(bitstream_size)0) {
+      free(state.bits);
+      return zfp_false;
+    }
+    sum += state.bits[chunk];
+  }
+  free(state.bits);
+
+  /* extrapolate from sampled to all blocks */
+  if (samples == state.blocks)
+    *bits = sum;
+  else
+    *bits = (bitstream_size)((double)sum * (double)state.blocks / (double)samples + 0.5);
+
+  return zfp_true;
+}
@@ -0,0 +1,274 @@
+/* block index for random access to variable-rate compressed streams */
+struct zfp_index {
+  zfp_index_type type;     /* encoding of block offsets */
+  size_t nx, ny, nz, nw;   /* dimensions of indexed field */
+  size_t blocks;           /* number of indexed blocks */
+  bitstream_size end;      /* offset one past last block */
+  void* data;              /* encoded block offsets */
+  uint32* size;            /* block sizes while index is being built */
+  void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t); /* chunk compressor while index is being built */
+};
+
+/* magic word identifying serialized index */
+#define INDEX_MAGIC (((uint64)'z' << 16) + ((uint64)'f' << 8) + (uint64)'i')
+
+/* number of bits of serialized index header */
+#define INDEX_HEADER_BITS (6 * 64)
+
+/* number of bits to shift high bits of hybrid4 base offset */
+#define HYBRID4_SHIFT 12
+
+/* number of low bits per block size in hybrid8 index */
+#define HYBRID8_LBITS 8
+
+/* dimensionality of indexed field */
+static uint
+index_dims(const zfp_index* index)
+{
+  return index->nw ? 4 : index->nz ? 3 : index->ny ? 2 : index->nx ? 1 : 0;
+}
+
+/* number of high bits per block size in hybrid8 index */
+static uint
+index_hbits(const zfp_index* index)
+{
+  return 2 * (index_dims(index) - 1);
+}
+
+/* number of bits of encoded block offsets */
+static bitstream_size
+index_data_bits(zfp_index_type type, size_t blocks)
+{
+  switch (type) {
+    case zfp_index_verbatim:
+      return (bitstream_size)64 * (blocks + 1);
+    case zfp_index_hybrid4:
+      return (bitstream_size)96 * ((blocks + 3) / 4);
+    case zfp_index_hybrid8:
+      return (bitstream_size)128 * ((blocks + 7) / 8);
+    default:
+      return 0;
+  }
+}
+
+/* sum of eight packed n-bit values (0 <= n <= 8) */
+static uint64
+hybrid8_sum(uint64 x, uint n)
+{
+  /* bit masks for extracting terms of sums */
+  uint64 m3 = n ? ~UINT64C(0) << (4 * n) : 0;
+  uint64 m2 = m3 ^ (m3 << (4 * n));
+  uint64 m1 = m2 ^ (m2 >> (2 * n));
+  uint64 m0 = m1 ^ (m1 >> (1 * n));
+  uint64 y;
+  /* perform summations in parallel */
+  y = x & m0; x -= y; x += y >> n; n *= 2; /* four summations */
+  y = x & m1; x -= y; x += y >> n; n *= 2; /* two summations */
+  y = x & m2; x -= y; x += y >> n; n *= 2; /* final summation */
+  return x;
+}
+
+/* bit offset of given block relative to first block */
+static bitstream_offset
+index_block_offset(const zfp_index* index, size_t block)
+{
+  size_t chunk;
+  uint k;
+
+  if (block == index->blocks)
+    return index->end;
+
+  switch (index->type) {
+    case zfp_index_verbatim: {
+      const uint64* data = (const uint64*)index->data;
+      return data[block];
+    }
+    case zfp_index_hybrid4: {
+      /* 32-bit base offset followed by four 16-bit offsets from base */
+      const uint32* data = (const uint32*)index->data + 3 * (block / 4);
+      k = (uint)(block % 4);
+      return ((bitstream_offset)data[0] << HYBRID4_SHIFT) + ((data[1 + k / 2] >> (16 * (k % 2))) & 0xffffu);
+    }
+    case zfp_index_hybrid8: {
+      /* high and low bits of base offset and first seven block sizes */
+      const uint hbits = index_hbits(index);
+      const uint lbits = HYBRID8_LBITS;
+      uint64 h, l, base;
+      chunk = block / 8;
+      k = (uint)(block % 8);
+      h = ((const uint64*)index->data)[2 * chunk + 0];
+      l = ((const uint64*)index->data)[2 * chunk + 1];
+      /* extract all but lowest (8 * hbits) bits */
+      base = h >> (8 * hbits);
+      h -= base << (8 * hbits);
+      /* add LSBs of base offset and k block sizes */
+      h = hbits ? hybrid8_sum(h >> ((7 - k) * hbits), hbits) : 0;
+      l = hybrid8_sum(l >> ((7 - k) * lbits), lbits);
+      return (((base << hbits) + h) << lbits) + l;
+    }
+    default:
+      return 0;
+  }
+}
+
+/* encode block sizes as hybrid4 chunks of four blocks each */
+static zfp_bool
+index_encode_hybrid4(zfp_index* index)
+{
+  uint32* data = (uint32*)index->data;
+  bitstream_offset ptr = 0;
+  size_t block;
+
+  for (block = 0; block < index->blocks; block += 4, data += 3) {
+    bitstream_offset base;
+    uint32 lo[4];
+    uint k;
+    if (ptr >> (32 + HYBRID4_SHIFT))
+      return zfp_false;
+    /* store high bits of base offset and low bits of block offsets */
+    data[0] = (uint32)(ptr >> HYBRID4_SHIFT);
+    base = (bitstream_offset)data[0] << HYBRID4_SHIFT;
+    for (k = 0; k < 4; k++) {
+      size_t size = block + k < index->blocks ? index->size[block + k] : 0;
+      if (size > ZFP_MAX_BITS)
+        return zfp_false;
+      lo[k] = (uint32)(ptr - base);
+      ptr += size;
+    }
+    data[1] = lo[0] + (lo[1] << 16);
+    data[2] = lo[2] + (lo[3] << 16);
+  }
+
+  return zfp_true;
+}
+
+/* encode block sizes as hybrid8 chunks of eight blocks each */
+static zfp_bool
+index_encode_hybrid8(zfp_index* index)
+{
+  const uint hbits = index_hbits(index);
+  const uint lbits = HYBRID8_LBITS;
+  uint64* data = (uint64*)index->data;
+  bitstream_offset ptr = 0;
+  size_t block;
+
+  for (block = 0; block < index->blocks; block += 8, data += 2) {
+    /* partition chunk offset into low and high bits */
+    uint64 h = ptr >> lbits;
+    uint64 l = ptr - (h << lbits);
+    uint64 hi = h << (7 * hbits);
+    uint64 lo = l << (7 * lbits);
+    uint k;
+    /* make sure base offset does not overflow */
+    if ((hi >> (7 * hbits)) != h)
+      return zfp_false;
+    /* store sizes of blocks 0-6 */
+    for (k = 0; k < 8; k++) {
+      uint64 size = block + k < index->blocks ? index->size[block + k] : 0;
+      if (size >> (hbits + lbits))
+        return zfp_false;
+      ptr += size;
+      if (k < 7) {
+        /* partition block size into hbits high and lbits low bits */
+        h = size >> lbits;
+        l = size - (h << lbits);
+        hi += h << ((6 - k) * hbits);
+        lo += l << ((6 - k) * lbits);
+      }
+    }
+    data[0] = hi;
+    data[1] = lo;
+  }
+
+  return zfp_true;
+}
+
+/* allocate storage for encoded block offsets */
+static zfp_bool
+index_alloc(zfp_index* index)
+{
+  free(index->data);
+  index->data = malloc((size_t)(index_data_bits(index->type, index->blocks) / CHAR_BIT));
+  return index->data != NULL;
+}
+
+/* prepare index for recording sizes of blocks of field during compression */
+static zfp_bool
+index_begin(zfp_index* index, const zfp_field* field, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  index->nx = field->nx;
+  index->ny = field->ny;
+  index->nz = field->nz;
+  index->nw = field->nw;
+  index->blocks = zfp_field_blocks(field);
+  index->end = 0;
+  index->compress = compress;
+  free(index->size);
+  index->size = malloc(index->blocks * sizeof(uint32));
+  if (!index->size || !index_alloc(index)) {
+    index->blocks = 0;
+    return zfp_false;
+  }
+  return zfp_true;
+}
+
+/* encode recorded block sizes as offsets */
+static zfp_bool
+index_end(zfp_index* index)
+{
+  zfp_bool success = zfp_true;
+  size_t block;
+
+  for (block = 0; block < index->blocks; block++)
+    index->end += index->size[block];
+
+  switch (index->type) {
+    case zfp_index_verbatim: {
+      uint64* data = (uint64*)index->data;
+      data[0] = 0;
+      for (block = 0; block < index->blocks; block++)
+        data[block + 1] = data[block] + index->size[block];
+      break;
+    }
+    case zfp_index_hybrid4:
+      success = index_encode_hybrid4(index);
+      break;
+    case zfp_index_hybrid8:
+      success = index_encode_hybrid8(index);
+      break;
+  }
+
+  free(index->size);
+  index->size = NULL;
+  index->compress = NULL;
+  if (!success)
+    index->blocks = 0;
+
+  return success;
+}
+
+/* compress blocks bmin through bmax - 1 and record their sizes in index */
+static void
+index_compress_chunk(zfp_stream* zfp, const zfp_field* field, size_t bmin, size_t bmax)
+{
+  const zfp_index* index = zfp->index;
+  size_t block;
+
+  for (block = bmin; block < bmax; block++) {
+    bitstream_offset offset = stream_wtell(zfp->stream);
+    index->compress(zfp, field, block, block + 1);
+    index->size[block] = (uint32)(stream_wtell(zfp->stream) - offset);
+  }
+}
+
+/* whether index covers box of field with origin (x0, y0, z0, w0) */
+static zfp_bool
+index_covers(const zfp_index* index, const zfp_field* field, size_t x0, size_t y0, size_t z0, size_t w0)
+{
+  if (!index->blocks || index_dims(index) != zfp_field_dimensionality(field))
+    return zfp_false;
+  return (x0 + field->nx <= index->nx) &&
+         (field->ny ? y0 + field->ny <= index->ny : !y0) &&
+         (field->nz ? z0 + field->nz <= index->nz : !z0) &&
+         (field->nw ? w0 + field->nw <= index->nw : !w0);
+}
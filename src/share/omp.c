@@ -29,3 +29,267 @@ chunk_count_omp(const zfp_stream* stream, size_t blocks, uint threads)
 }
 
 #endif
+
+#ifdef _OPENMP
+
+/* run task on one chunk and accumulate its wall-clock time if requested */
+static void
+run_task_omp(zfp_task task, void* data, size_t chunk, double* timing)
+{
+  if (timing) {
+    double t = omp_get_wtime();
+    task(data, chunk);
+    *timing += omp_get_wtime() - t;
+  }
+  else
+    task(data, chunk);
+}
+
+/* zero per-chunk timings, if requested */
+static void
+reset_timings_omp(const zfp_stream* stream)
+{
+  const zfp_exec_params_omp* params = (const zfp_exec_params_omp*)stream->exec.params;
+  size_t chunk;
+
+  for (chunk = 0; chunk < params->timing_count; chunk++)
+    params->timings[chunk] = 0;
+}
+
+/* execute task once per chunk using the requested OpenMP schedule */
+static void
+parallel_for_omp(const zfp_stream* stream, uint threads, size_t chunks, zfp_task task, void* data)
+{
+  const zfp_exec_params_omp* params = (const zfp_exec_params_omp*)stream->exec.params;
+  double* timings = params->timings;
+  size_t count = MIN(params->timing_count, chunks);
+  int chunk; /* OpenMP 2.0 requires int loop counter */
+
+  if (params->dynamic) {
+    /* assign one chunk at a time to threads as they become idle */
+    #pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+    for (chunk = 0; chunk < (int)chunks; chunk++)
+      run_task_omp(task, data, chunk, (size_t)chunk < count ? timings + chunk : NULL);
+  }
+  else {
+    /* use default OpenMP schedule */
+    #pragma omp parallel for num_threads(threads)
+    for (chunk = 0; chunk < (int)chunks; chunk++)
+      run_task_omp(task, data, chunk, (size_t)chunk < count ? timings + chunk : NULL);
+  }
+}
+
+/* state shared by tasks of zero-copy compression */
+typedef struct {
+  const zfp_stream* stream;
+  const zfp_field* field;
+  bitstream** bs;
+  bitstream_offset* offset;
+  uint64* head;
+  size_t blocks;
+  size_t chunks;
+  void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t);
+} compress_direct_state_omp;
+
+/* first pass: determine compressed size of one chunk */
+static void
+compress_size_task_omp(void* data, size_t chunk)
+{
+  const compress_direct_state_omp* state = (const compress_direct_state_omp*)data;
+  /* determine range of block indices assigned to this thread */
+  size_t bmin = chunk_offset(state->blocks, state->chunks, chunk + 0);
+  size_t bmax = chunk_offset(state->blocks, state->chunks, chunk + 1);
+  size_t block;
+  /* encode one block at a time to thread-local scratch stream */
+  bitstream_size bits = 0;
+  zfp_stream s = *state->stream;
+  zfp_stream_set_bit_stream(&s, state->bs[2 * omp_get_thread_num() + 0]);
+  for (block = bmin; block < bmax; block++) {
+    stream_rewind(s.stream);
+    state->compress(&s, state->field, block, block + 1);
+    bits += stream_wtell(s.stream);
+  }
+  state->offset[chunk + 1] = bits;
+}
+
+/* second pass: compress one chunk directly to its final location */
+static void
+compress_direct_task_omp(void* data, size_t chunk)
+{
+  const compress_direct_state_omp* state = (const compress_direct_state_omp*)data;
+  /* determine range of block indices assigned to this thread */
+  size_t bmin = chunk_offset(state->blocks, state->chunks, chunk + 0);
+  size_t bmax = chunk_offset(state->blocks, state->chunks, chunk + 1);
+  /* set up thread-local bit streams */
+  zfp_stream s = *state->stream;
+  bitstream* scratch = state->bs[2 * omp_get_thread_num() + 0];
+  bitstream* out = state->bs[2 * omp_get_thread_num() + 1];
+  bmin = compress_head_par(&s, state->field, bmin, bmax, state->offset[chunk], scratch, out, &state->head[chunk], state->compress);
+  /* compress remaining blocks directly to output stream */
+  if (bmin < bmax) {
+    zfp_stream_set_bit_stream(&s, out);
+    state->compress(&s, state->field, bmin, bmax);
+  }
+  stream_flush(out);
+}
+
+/* compress chunks of blocks in parallel via per-chunk streams */
+static void
+compress_chunks_copy_omp(zfp_stream* stream, const zfp_field* field, size_t blocks, uint threads, size_t chunks, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  compress_state_par state;
+
+  /* allocate per-thread streams */
+  bitstream** bs = compress_init_par(stream, field, chunks, blocks);
+  if (!bs)
+    return;
+
+  /* compress chunks of blocks in parallel */
+  state.stream = stream;
+  state.field = field;
+  state.bs = bs;
+  state.blocks = blocks;
+  state.chunks = chunks;
+  state.compress = compress;
+  parallel_for_omp(stream, threads, chunks, compress_task_par, &state);
+
+  /* concatenate per-thread streams */
+  compress_finish_par(stream, bs, chunks);
+}
+
+/* compress chunks of blocks in parallel directly into output stream */
+static zfp_bool
+compress_chunks_direct_omp(zfp_stream* stream, const zfp_field* field, size_t blocks, uint threads, size_t chunks, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  bitstream* dst = zfp_stream_bit_stream(stream);
+  compress_direct_state_omp state;
+  bitstream_offset* offset;
+  uint64* head;
+  bitstream** bs;
+  size_t size;
+  size_t chunk;
+
+  /* allocate per-chunk offsets and leading bits, and per-thread streams */
+  offset = malloc((chunks + 1) * sizeof(bitstream_offset));
+  head = malloc(chunks * sizeof(uint64));
+  bs = compress_init_direct_par(stream, field, threads, &size);
+  if (!offset || !head || !bs) {
+    free(offset);
+    free(head);
+    compress_finish_direct_par(bs, threads);
+    return zfp_false;
+  }
+
+  state.stream = stream;
+  state.field = field;
+  state.bs = bs;
+  state.offset = offset;
+  state.head = head;
+  state.blocks = blocks;
+  state.chunks = chunks;
+  state.compress = compress;
+
+  /* first pass: determine compressed size of each chunk */
+  if (stream->minbits == stream->maxbits) {
+    /* in fixed-rate mode, chunk size is given by number of blocks */
+    for (chunk = 0; chunk < chunks; chunk++) {
+      size_t bmin = chunk_offset(blocks, chunks, chunk + 0);
+      size_t bmax = chunk_offset(blocks, chunks, chunk + 1);
+      offset[chunk + 1] = (bitstream_size)(bmax - bmin) * stream->maxbits;
+    }
+  }
+  else
+    parallel_for_omp(stream, threads, chunks, compress_size_task_omp, &state);
+
+  /* record chunk sizes in index */
+  if (stream->chunk_index) {
+    stream_flush(dst);
+    stream_write_bits(dst, chunks, CHUNK_INDEX_BITS);
+    for (chunk = 0; chunk < chunks; chunk++)
+      stream_write_bits(dst, offset[chunk + 1], CHUNK_INDEX_BITS);
+  }
+
+  /* convert chunk sizes to bit offsets */
+  offset[0] = stream_wtell(dst);
+  for (chunk = 0; chunk < chunks; chunk++)
+    offset[chunk + 1] += offset[chunk];
+
+  /* write any buffered bits that share a word with the first chunk */
+  if (offset[0] % stream_word_bits) {
+    bitstream* s = stream_clone(dst);
+    if (!s) {
+      free(offset);
+      free(head);
+      compress_finish_direct_par(bs, threads);
+      return zfp_false;
+    }
+    stream_flush(s);
+    stream_close(s);
+  }
+
+  /* second pass: compress chunks of blocks in parallel */
+  parallel_for_omp(stream, threads, chunks, compress_direct_task_omp, &state);
+
+  /* merge leading bits of each chunk with trailing bits of its predecessor */
+  compress_merge_par(dst, offset, head, chunks);
+
+  free(offset);
+  free(head);
+  compress_finish_direct_par(bs, threads);
+  return zfp_true;
+}
+
+/* compress chunks of blocks in parallel */
+static void
+compress_chunks_omp(zfp_stream* stream, const zfp_field* field, size_t blocks, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  /* number of omp threads and chunks */
+  uint threads = thread_count_omp(stream);
+  size_t chunks = chunk_count_omp(stream, blocks, threads);
+
+  /* reset per-chunk timings */
+  reset_timings_omp(stream);
+
+  /* avoid temporary buffers if requested */
+  if (zfp_stream_omp_zero_copy(stream) && compress_copy_par(stream))
+    if (compress_chunks_direct_omp(stream, field, blocks, threads, chunks, compress))
+      return;
+
+  compress_chunks_copy_omp(stream, field, blocks, threads, chunks, compress);
+}
+
+/* decompress chunks of blocks in parallel */
+static void
+decompress_chunks_omp(zfp_stream* stream, zfp_field* field, size_t blocks, void (*decompress)(zfp_stream*, zfp_field*, size_t, size_t))
+{
+  decompress_state_par state;
+
+  /* number of omp threads and chunks */
+  uint threads = thread_count_omp(stream);
+  size_t chunks = chunk_count_omp(stream, blocks, threads);
+  bitstream** bs;
+
+  /* reset per-chunk timings */
+  reset_timings_omp(stream);
+
+  /* allocate per-thread streams; decompress serially if chunks cannot be located */
+  bs = decompress_init_par(stream, &chunks, blocks);
+  if (!bs) {
+    decompress(stream, field, 0, blocks);
+    return;
+  }
+
+  /* decompress chunks of blocks in parallel */
+  state.stream = stream;
+  state.field = field;
+  state.bs = bs;
+  state.blocks = blocks;
+  state.chunks = chunks;
+  state.decompress = decompress;
+  parallel_for_omp(stream, threads, chunks, decompress_task_par, &state);
+
+  /* advance past decompressed chunks */
+  decompress_finish_par(stream, bs, chunks);
+}
+
+#endif
@@ -1,4 +1,5 @@
-#ifdef _OPENMP
+/* number of bits per chunk index entry */
+#define CHUNK_INDEX_BITS 64
 
 /* block index at which chunk begins */
 static size_t
@@ -7,6 +8,170 @@ chunk_offset(size_t blocks, size_t chunks, size_t chunk)
   return (size_t)(((uint64)blocks * (uint64)chunk) / chunks);
 }
 
+/* number of bits of storage needed for (word-aligned) chunk index */
+static bitstream_size
+chunk_index_bits(size_t chunks)
+{
+  return stream_word_bits + (bitstream_size)CHUNK_INDEX_BITS * (1 + chunks);
+}
+
+/* align stream and reserve space for chunk index; return offset to chunk data */
+static bitstream_offset
+chunk_index_reserve(bitstream* stream, size_t chunks)
+{
+  stream_flush(stream);
+  stream_write_bits(stream, chunks, CHUNK_INDEX_BITS);
+  stream_pad(stream, (bitstream_size)CHUNK_INDEX_BITS * chunks);
+  return stream_wtell(stream);
+}
+
+/* open stream for writing sizes of chunks beginning at offset */
+static bitstream*
+chunk_index_open(const bitstream* stream, bitstream_offset offset, size_t chunks)
+{
+  bitstream* index = stream_clone(stream);
+  if (index)
+    stream_wseek(index, offset - (bitstream_offset)CHUNK_INDEX_BITS * chunks);
+  return index;
+}
+
+/* record size of next chunk in index */
+static void
+chunk_index_write(bitstream* index, bitstream_size bits)
+{
+  if (index)
+    stream_write_bits(index, bits, CHUNK_INDEX_BITS);
+}
+
+/* close chunk index stream */
+static void
+chunk_index_close(bitstream* index)
+{
+  if (index) {
+    stream_flush(index);
+    stream_close(index);
+  }
+}
+
+/* read number of chunks in index; return whether it is consistent with blocks */
+static zfp_bool
+chunk_index_count(bitstream* stream, size_t blocks, size_t* chunks)
+{
+  uint64 n;
+
+  stream_align(stream);
+  n = stream_read_bits(stream, CHUNK_INDEX_BITS);
+  *chunks = (size_t)n;
+  /* nonempty fields have between one chunk and one chunk per block */
+  return blocks ? 0 < n && n <= (uint64)blocks : n <= 1;
+}
+
+/* return whether chunk index at current stream position is well formed */
+static zfp_bool
+chunk_index_valid(bitstream* stream, size_t blocks)
+{
+  bitstream_offset offset = stream_rtell(stream);
+  size_t n;
+  zfp_bool valid = chunk_index_count(stream, blocks, &n);
+  stream_rseek(stream, offset);
+  return valid;
+}
+
+/* skip chunk index; return false if index is corrupt */
+static zfp_bool
+chunk_index_skip(bitstream* stream, size_t blocks)
+{
+  size_t n;
+
+  if (!chunk_index_count(stream, blocks, &n))
+    return zfp_false;
+  stream_skip(stream, (bitstream_size)CHUNK_INDEX_BITS * n);
+  return zfp_true;
+}
+
+/* read chunk index and return chunk offsets (or NULL if index is corrupt) */
+static bitstream_offset*
+chunk_index_read(bitstream* stream, size_t* chunks, size_t blocks)
+{
+  bitstream_offset* offset;
+  size_t n, chunk;
+
+  /* validate chunk count before sizing allocations or skips by it */
+  if (!chunk_index_count(stream, blocks, &n) || !n)
+    return NULL;
+  offset = malloc((n + 1) * sizeof(bitstream_offset));
+  if (!offset) {
+    stream_skip(stream, (bitstream_size)CHUNK_INDEX_BITS * n);
+    return NULL;
+  }
+  /* convert chunk sizes to absolute bit offsets */
+  offset[0] = stream_rtell(stream) + (bitstream_size)CHUNK_INDEX_BITS * n;
+  for (chunk = 0; chunk < n; chunk++)
+    offset[chunk + 1] = offset[chunk] + stream_read_bits(stream, CHUNK_INDEX_BITS);
+  *chunks = n;
+  return offset;
+}
+
+/* state shared by tasks that compress one chunk each */
+typedef struct {
+  const zfp_stream* stream;
+  const zfp_field* field;
+  bitstream** bs;
+  size_t blocks;
+  size_t chunks;
+  void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t);
+} compress_state_par;
+
+/* state shared by tasks that decompress one chunk each */
+typedef struct {
+  const zfp_stream* stream;
+  zfp_field* field;
+  bitstream** bs;
+  size_t blocks;
+  size_t chunks;
+  void (*decompress)(zfp_stream*, zfp_field*, size_t, size_t);
+} decompress_state_par;
+
+/* compress one chunk of blocks */
+static void
+compress_task_par(void* data, size_t chunk)
+{
+  const compress_state_par* state = (const compress_state_par*)data;
+  /* determine range of block indices assigned to this task */
+  size_t bmin = chunk_offset(state->blocks, state->chunks, chunk + 0);
+  size_t bmax = chunk_offset(state->blocks, state->chunks, chunk + 1);
+  /* set up task-local bit stream */
+  zfp_stream s = *state->stream;
+  zfp_stream_set_bit_stream(&s, state->bs[chunk]);
+  /* compress sequence of blocks */
+  state->compress(&s, state->field, bmin, bmax);
+}
+
+/* decompress one chunk of blocks */
+static void
+decompress_task_par(void* data, size_t chunk)
+{
+  const decompress_state_par* state = (const decompress_state_par*)data;
+  /* determine range of block indices assigned to this task */
+  size_t bmin = chunk_offset(state->blocks, state->chunks, chunk + 0);
+  size_t bmax = chunk_offset(state->blocks, state->chunks, chunk + 1);
+  /* set up task-local bit stream */
+  zfp_stream s = *state->stream;
+  zfp_stream_set_bit_stream(&s, state->bs[chunk]);
+  /* decompress sequence of blocks */
+  state->decompress(&s, state->field, bmin, bmax);
+}
+
+/* whether parallel compression requires per-chunk buffers to be concatenated */
+static zfp_bool
+compress_copy_par(const zfp_stream* stream)
+{
+  /* a chunk index (if any) begins on a word boundary */
+  return (stream->minbits != stream->maxbits) ||
+         (stream->maxbits % stream_word_bits != 0) ||
+         (!stream->chunk_index && stream_wtell(stream->stream) % stream_word_bits != 0);
+}
+
 /* initialize per-thread bit streams for parallel compression */
 static bitstream**
 compress_init_par(zfp_stream* stream, const zfp_field* field, size_t chunks, size_t blocks)
@@ -43,10 +208,12 @@ compress_init_par(zfp_stream* stream, const zfp_field* field, size_t chunks, siz
   }
   size = zfp_stream_maximum_size(stream, &f);
 
+  /* reserve space for chunk sizes ahead of compressed chunks */
+  if (stream->chunk_index)
+    chunk_index_reserve(stream->stream, chunks);
+
   /* avoid copies in fixed-rate mode when each bitstream is word aligned */
-  copy = (stream->minbits != stream->maxbits) ||
-         (stream->maxbits % stream_word_bits != 0) ||
-         (stream_wtell(stream->stream) % stream_word_bits != 0);
+  copy = compress_copy_par(stream);
 
   /* set up buffer for each thread to compress to */
   bs = malloc(chunks * sizeof(bitstream*));
@@ -78,14 +245,16 @@ static void
 compress_finish_par(zfp_stream* stream, bitstream** src, size_t chunks)
 {
   bitstream* dst = zfp_stream_bit_stream(stream);
-  zfp_bool copy = (stream_data(dst) != stream_data(*src));
+  zfp_bool copy = (stream_data(*src) != (uchar*)stream_data(dst) + stream_size(dst));
   bitstream_offset offset = stream_wtell(dst);
+  bitstream* index = stream->chunk_index ? chunk_index_open(dst, offset, chunks) : NULL;
   size_t chunk;
 
   /* flush each stream and concatenate if necessary */
   for (chunk = 0; chunk < chunks; chunk++) {
     bitstream_size bits = stream_wtell(src[chunk]);
     offset += bits;
+    chunk_index_write(index, bits);
     stream_flush(src[chunk]);
     /* concatenate streams if they are not already contiguous */
     if (copy) {
@@ -97,8 +266,188 @@ compress_finish_par(zfp_stream* stream, bitstream** src, size_t chunks)
   }
 
   free(src);
+  chunk_index_close(index);
   if (!copy)
     stream_wseek(dst, offset);
 }
 
+/* initialize per-thread bit streams for parallel decompression */
+static bitstream**
+decompress_init_par(zfp_stream* stream, size_t* chunks, size_t blocks)
+{
+  bitstream_offset* offset = NULL;
+  bitstream** bs;
+  size_t chunk;
+
+  /* locate chunks via index or, in fixed-rate mode, from their block offsets */
+  if (stream->chunk_index) {
+    offset = chunk_index_read(stream->stream, chunks, blocks);
+    if (!offset)
+      return NULL;
+  }
+  else if (stream->minbits != stream->maxbits)
+    return NULL;
+
+  /* set up bit stream for each thread to decompress from */
+  bs = malloc(*chunks * sizeof(bitstream*));
+  if (bs) {
+    for (chunk = 0; chunk < *chunks; chunk++) {
+      bs[chunk] = stream_clone(stream->stream);
+      if (!bs[chunk])
+        break;
+      if (offset)
+        stream_rseek(bs[chunk], offset[chunk]);
+      else
+        stream_rseek(bs[chunk], stream_rtell(stream->stream) + (bitstream_offset)chunk_offset(blocks, *chunks, chunk) * stream->maxbits);
+    }
+    /* handle memory allocation failure */
+    if (chunk < *chunks) {
+      while (chunk--)
+        stream_close(bs[chunk]);
+      free(bs);
+      bs = NULL;
+    }
+  }
+
+  /* with no chunk streams, position stream at first chunk for serial decoding */
+  if (!bs && offset)
+    stream_rseek(stream->stream, offset[0]);
+
+  free(offset);
+  return bs;
+}
+
+/* advance bit stream past last chunk and deallocate per-thread streams */
+static void
+decompress_finish_par(zfp_stream* stream, bitstream** src, size_t chunks)
+{
+  size_t chunk;
+
+  if (chunks)
+    stream_rseek(stream->stream, stream_rtell(src[chunks - 1]));
+  for (chunk = 0; chunk < chunks; chunk++)
+    stream_close(src[chunk]);
+
+  free(src);
+}
+
+#ifdef _OPENMP
+
+/* deallocate per-thread streams used for direct compression */
+static void
+compress_finish_direct_par(bitstream** bs, uint threads)
+{
+  uint thread;
+
+  if (!bs)
+    return;
+  for (thread = 0; thread < threads; thread++) {
+    if (bs[2 * thread + 0]) {
+      free(stream_data(bs[2 * thread + 0]));
+      stream_close(bs[2 * thread + 0]);
+    }
+    if (bs[2 * thread + 1])
+      stream_close(bs[2 * thread + 1]);
+  }
+  free(bs);
+}
+
+/* initialize per-thread scratch and output streams for direct compression */
+static bitstream**
+compress_init_direct_par(zfp_stream* stream, const zfp_field* field, uint threads, size_t* size)
+{
+  bitstream* dst = zfp_stream_bit_stream(stream);
+  bitstream** bs;
+  zfp_field f = *field;
+  uint thread;
+
+  /* scratch buffer must hold one block plus leading and trailing words */
+  f.nx = f.nx ? 4 : 0;
+  f.ny = f.ny ? 4 : 0;
+  f.nz = f.nz ? 4 : 0;
+  f.nw = f.nw ? 4 : 0;
+  *size = zfp_stream_maximum_size(stream, &f) + 2 * stream_word_bits / CHAR_BIT;
+
+  /* allocate scratch stream (even) and output stream (odd) per thread */
+  bs = calloc(2 * threads, sizeof(bitstream*));
+  if (!bs)
+    return NULL;
+  for (thread = 0; thread < threads; thread++) {
+    void* buffer = malloc(*size);
+    if (!buffer)
+      break;
+    bs[2 * thread + 0] = stream_open(buffer, *size);
+    bs[2 * thread + 1] = stream_clone(dst);
+    if (!bs[2 * thread + 0]) {
+      free(buffer);
+      break;
+    }
+    if (!bs[2 * thread + 1])
+      break;
+  }
+
+  /* handle memory allocation failure */
+  if (thread < threads) {
+    compress_finish_direct_par(bs, threads);
+    bs = NULL;
+  }
+
+  return bs;
+}
+
+/* compress leading blocks of chunk that begins in a word shared with its predecessor */
+static size_t
+compress_head_par(zfp_stream* stream, const zfp_field* field, size_t bmin, size_t bmax, bitstream_offset offset, bitstream* scratch, bitstream* out, uint64* head, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  bitstream_count n = (bitstream_count)(offset % stream_word_bits);
+  bitstream_size bits;
+
+  *head = 0;
+  if (!n) {
+    /* chunk begins on word boundary and is written directly */
+    stream_wseek(out, offset);
+    return bmin;
+  }
+
+  /* compress to scratch stream until the shared word is filled */
+  stream_rewind(scratch);
+  stream_pad(scratch, n);
+  zfp_stream_set_bit_stream(stream, scratch);
+  for (; bmin < bmax && stream_wtell(scratch) < stream_word_bits; bmin++)
+    compress(stream, field, bmin, bmin + 1);
+  bits = stream_wtell(scratch);
+  stream_flush(scratch);
+
+  /* save leading bits to be merged once the previous chunk is written */
+  stream_rseek(scratch, n);
+  if (MIN(bits, stream_word_bits) > n)
+    *head = stream_read_bits(scratch, (bitstream_count)MIN(bits, stream_word_bits) - n);
+
+  /* copy any remaining bits to output stream */
+  if (bits >= stream_word_bits) {
+    stream_wseek(out, offset - n + stream_word_bits);
+    stream_copy(out, scratch, bits - stream_word_bits);
+  }
+
+  return bmin;
+}
+
+/* merge leading bits of unaligned chunks and advance stream past last chunk */
+static void
+compress_merge_par(bitstream* dst, const bitstream_offset* offset, const uint64* head, size_t chunks)
+{
+  size_t chunk;
+
+  for (chunk = 0; chunk < chunks; chunk++) {
+    bitstream_count n = (bitstream_count)(offset[chunk] % stream_word_bits);
+    if (n) {
+      bitstream_size bits = MIN(offset[chunk + 1] - offset[chunk], stream_word_bits - n);
+      stream_wseek(dst, offset[chunk]);
+      stream_write_bits(dst, head[chunk], (bitstream_count)bits);
+      stream_flush(dst);
+    }
+  }
+  stream_wseek(dst, offset[chunks]);
+}
+
 #endif
@@ -0,0 +1,51 @@
+/* state of field compressed one slab at a time */
+typedef struct {
+  zfp_field field;         /* field metadata (data pointer unused) */
+  size_t size;             /* number of units along slowest varying dimension */
+  size_t next;             /* first unit along slowest dimension of next slab */
+  bitstream_offset offset; /* offset to first block following chunk index */
+  void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t); /* chunk compressor */
+} slab_state;
+
+/* set up field that describes slab of n units along slowest dimension */
+static void
+slab_field(zfp_field* field, const slab_state* state, const void* data, size_t n)
+{
+  *field = state->field;
+  field->data = (void*)data;
+  switch (zfp_field_dimensionality(field)) {
+    case 1:
+      field->nx = n;
+      break;
+    case 2:
+      field->ny = n;
+      break;
+    case 3:
+      field->nz = n;
+      break;
+    case 4:
+      field->nw = n;
+      break;
+  }
+}
+
+/* compress all blocks of slab under stream's execution policy */
+static void
+slab_compress(zfp_stream* zfp, const zfp_field* field, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  size_t blocks = zfp_field_blocks(field);
+
+  switch (zfp->exec.policy) {
+#ifdef _OPENMP
+    case zfp_exec_omp:
+      compress_chunks_omp(zfp, field, blocks, compress);
+      break;
+#endif
+    case zfp_exec_threads:
+      compress_chunks_threads(zfp, field, blocks, compress);
+      break;
+    default:
+      compress(zfp, field, 0, blocks);
+      break;
+  }
+}
@@ -0,0 +1,101 @@
+/* number of threads to partition work among */
+static uint
+thread_count_threads(const zfp_stream* stream)
+{
+  uint count = zfp_stream_thread_count(stream);
+  /* if no thread count is specified, use a single thread */
+  if (!count)
+    count = 1;
+  return count;
+}
+
+/* number of chunks to partition array into */
+static size_t
+chunk_count_threads(const zfp_stream* stream, size_t blocks, uint threads)
+{
+  size_t chunk_size = (size_t)zfp_stream_thread_chunk_size(stream);
+  /* if no chunk size is specified, assign one chunk per thread */
+  size_t chunks = chunk_size ? (blocks + chunk_size - 1) / chunk_size : threads;
+  /* each chunk must contain at least one block */
+  chunks = MIN(chunks, blocks);
+  return chunks;
+}
+
+/* execute tasks in calling thread when no scheduler is given */
+static void
+parallel_for_serial(void* context, size_t count, zfp_task task, void* data)
+{
+  size_t i;
+  (void)context;
+  for (i = 0; i < count; i++)
+    task(data, i);
+}
+
+/* hand tasks to user-provided scheduler */
+static void
+parallel_for_threads(const zfp_stream* stream, size_t count, zfp_task task, void* data)
+{
+  const zfp_exec_params_threads* params = (const zfp_exec_params_threads*)stream->exec.params;
+  if (params->parallel_for)
+    params->parallel_for(params->context, count, task, data);
+  else
+    parallel_for_serial(params->context, count, task, data);
+}
+
+/* compress chunks of blocks in parallel via user-provided scheduler */
+static void
+compress_chunks_threads(zfp_stream* stream, const zfp_field* field, size_t blocks, void (*compress)(zfp_stream*, const zfp_field*, size_t, size_t))
+{
+  compress_state_par state;
+
+  /* number of threads and chunks */
+  uint threads = thread_count_threads(stream);
+  size_t chunks = chunk_count_threads(stream, blocks, threads);
+
+  /* allocate per-chunk streams */
+  bitstream** bs = compress_init_par(stream, field, chunks, blocks);
+  if (!bs)
+    return;
+
+  /* compress chunks of blocks in parallel */
+  state.stream = stream;
+  state.field = field;
+  state.bs = bs;
+  state.blocks = blocks;
+  state.chunks = chunks;
+  state.compress = compress;
+  parallel_for_threads(stream, chunks, compress_task_par, &state);
+
+  /* concatenate per-chunk streams */
+  compress_finish_par(stream, bs, chunks);
+}
+
+/* decompress chunks of blocks in parallel via user-provided scheduler */
+static void
+decompress_chunks_threads(zfp_stream* stream, zfp_field* field, size_t blocks, void (*decompress)(zfp_stream*, zfp_field*, size_t, size_t))
+{
+  decompress_state_par state;
+
+  /* number of threads and chunks */
+  uint threads = thread_count_threads(stream);
+  size_t chunks = chunk_count_threads(stream, blocks, threads);
+
+  /* allocate per-chunk streams; decompress serially if chunks cannot be located */
+  bitstream** bs = decompress_init_par(stream, &chunks, blocks);
+  if (!bs) {
+    decompress(stream, field, 0, blocks);
+    return;
+  }
+
+  /* decompress chunks of blocks in parallel */
+  state.stream = stream;
+  state.field = field;
+  state.bs = bs;
+  state.blocks = blocks;
+  state.chunks = chunks;
+  state.decompress = decompress;
+  parallel_for_threads(stream, chunks, decompress_task_par, &state);
+
+  /* advance past decompressed chunks */
+  decompress_finish_par(stream, bs, chunks);
+}
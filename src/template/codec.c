@@ -4,3 +4,28 @@ with_maxbits(uint maxbits, uint maxprec, uint size)
 {
   return (maxprec + 1) * size - 1 > maxbits;
 }
+
+/* true if bit planes are best (de)interleaved by transposing whole block */
+static int
+with_transpose(uint size, uint planes)
+{
+  /* transposing 64 integers costs about as much as extracting 8 bit planes */
+  return size == 64 && planes > 8;
+}
+
+/* in-place transpose of 64x64 bit matrix; bit j of a[i] becomes bit i of a[j] */
+static void
+transpose_bits(uint64* a)
+{
+  uint64 m = UINT64C(0x00000000ffffffff);
+  uint64 t;
+  uint j, k;
+
+  /* swap off-diagonal j*j submatrices for j = 32, 16, ..., 1 */
+  for (j = 32; j; j >>= 1, m ^= m << j)
+    for (k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+      t = ((a[k] >> j) ^ a[k | j]) & m;
+      a[k] ^= t << j;
+      a[k | j] ^= t;
+    }
+}
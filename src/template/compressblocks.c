@@ -0,0 +1,41 @@
+/* compress blocks bmin through bmax - 1 stored back to back */
+static void
+_t1(compress_blocks_chunk, Scalar)(zfp_stream* stream, const zfp_field* field, size_t bmin, size_t bmax)
+{
+  const Scalar* data = (const Scalar*)field->data;
+  switch (zfp_field_dimensionality(field)) {
+    case 1:
+      _t2(zfp_encode_blocks, Scalar, 1)(stream, data + 4 * bmin, bmax - bmin);
+      break;
+    case 2:
+      _t2(zfp_encode_blocks, Scalar, 2)(stream, data + 16 * bmin, bmax - bmin);
+      break;
+    case 3:
+      _t2(zfp_encode_blocks, Scalar, 3)(stream, data + 64 * bmin, bmax - bmin);
+      break;
+    case 4:
+      _t2(zfp_encode_blocks, Scalar, 4)(stream, data + 256 * bmin, bmax - bmin);
+      break;
+  }
+}
+
+/* compress blocks bmin through bmax - 1 whose addresses are stored in field data */
+static void
+_t1(compress_blocks_indirect_chunk, Scalar)(zfp_stream* stream, const zfp_field* field, size_t bmin, size_t bmax)
+{
+  const Scalar* const* block = (const Scalar* const*)field->data + bmin;
+  switch (zfp_field_dimensionality(field)) {
+    case 1:
+      _t2(zfp_encode_blocks_indirect, Scalar, 1)(stream, block, bmax - bmin);
+      break;
+    case 2:
+      _t2(zfp_encode_blocks_indirect, Scalar, 2)(stream, block, bmax - bmin);
+      break;
+    case 3:
+      _t2(zfp_encode_blocks_indirect, Scalar, 3)(stream, block, bmax - bmin);
+      break;
+    case 4:
+      _t2(zfp_encode_blocks_indirect, Scalar, 4)(stream, block, bmax - bmin);
+      break;
+  }
+}
@@ -1,4 +1,5 @@
 #include <limits.h>
+#include "simd.h"
 
 static void _t2(inv_xform, Int, DIMS)(Int* p);
 
@@ -44,6 +45,58 @@ _t1(inv_lift, Int)(Int* p, ptrdiff_t s)
   p -= s; *p = x;
 }
 
+#ifdef ZFP_SIMD
+/* inverse lifting transform of four 4-vectors, one per SIMD lane */
+_t1(simd_target, Int) inline_ void
+_t1(inv_lift_simd, Int)(_t1(vec, Int)* v)
+{
+  _t1(vec, Int) x = v[0], y = v[1], z = v[2], w = v[3];
+
+  /* same sequence of operations as inv_lift() */
+  y = _t1(simd_add, Int)(y, _t1(simd_shr, Int)(w)); w = _t1(simd_sub, Int)(w, _t1(simd_shr, Int)(y));
+  y = _t1(simd_add, Int)(y, w); w = _t1(simd_sub, Int)(w, _t1(simd_sub, Int)(y, w));
+  z = _t1(simd_add, Int)(z, x); x = _t1(simd_sub, Int)(x, _t1(simd_sub, Int)(z, x));
+  y = _t1(simd_add, Int)(y, z); z = _t1(simd_sub, Int)(z, _t1(simd_sub, Int)(y, z));
+  w = _t1(simd_add, Int)(w, x); x = _t1(simd_sub, Int)(x, _t1(simd_sub, Int)(w, x));
+
+  v[0] = x;
+  v[1] = y;
+  v[2] = z;
+  v[3] = w;
+}
+
+/* inverse transform of four contiguous 4-vectors laid out with stride s */
+_t1(simd_target, Int) inline_ void
+_t1(inv_lift_rows_simd, Int)(Int* p, ptrdiff_t s)
+{
+  _t1(vec, Int) v[4];
+  uint i;
+  for (i = 0; i < 4; i++)
+    v[i] = _t1(simd_load, Int)(p + i * s);
+  _t1(inv_lift_simd, Int)(v);
+  for (i = 0; i < 4; i++)
+    _t1(simd_store, Int)(p + i * s, v[i]);
+}
+
+/* inverse transform along y and x of contiguous 4x4 slab */
+_t1(simd_target, Int) inline_ void
+_t1(inv_lift_slab_simd, Int)(Int* p)
+{
+  _t1(vec, Int) v[4];
+  uint i;
+  for (i = 0; i < 4; i++)
+    v[i] = _t1(simd_load, Int)(p + 4 * i);
+  /* transform along y */
+  _t1(inv_lift_simd, Int)(v);
+  /* transform along x */
+  _t1(simd_transpose, Int)(v);
+  _t1(inv_lift_simd, Int)(v);
+  _t1(simd_transpose, Int)(v);
+  for (i = 0; i < 4; i++)
+    _t1(simd_store, Int)(p + 4 * i, v[i]);
+}
+#endif
+
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_LAST
 /* bias values such that truncation is equivalent to round to nearest */
 static void
@@ -75,6 +128,35 @@ _t1(inv_order, Int)(const UInt* ublock, Int* iblock, const uchar* perm, uint n)
   while (--n);
 }
 
+/* deposit bit planes #kmin through #intprec-1 into size <= 64 integers */
+static void
+_t1(deposit_planes, UInt)(UInt* restrict_ data, uint size, uint64* restrict_ plane, uint kmin)
+{
+  uint intprec = (uint)(CHAR_BIT * sizeof(UInt));
+  uint i, k;
+
+  if (with_transpose(size, intprec - kmin)) {
+    /* deposit all bit planes at once */
+    for (k = 0; k < kmin; k++)
+      plane[k] = 0;
+    for (k = intprec; k < 64; k++)
+      plane[k] = 0;
+    transpose_bits(plane);
+    for (i = 0; i < size; i++)
+      data[i] = (UInt)plane[i];
+  }
+  else {
+    /* deposit one bit plane at a time */
+    for (i = 0; i < size; i++)
+      data[i] = 0;
+    for (k = kmin; k < intprec; k++) {
+      uint64 x = plane[k];
+      for (i = 0; x; i++, x >>= 1)
+        data[i] += (UInt)(x & 1u) << k;
+    }
+  }
+}
+
 /* decompress sequence of size <= 64 unsigned integers */
 static uint
 _t1(decode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxprec, UInt* restrict_ data, uint size)
@@ -83,13 +165,11 @@ _t1(decode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxpr
   bitstream s = *stream;
   uint intprec = (uint)(CHAR_BIT * sizeof(UInt));
   uint kmin = intprec > maxprec ? intprec - maxprec : 0;
+  uint kend = intprec;
   uint bits = maxbits;
-  uint i, k, m, n;
+  uint k, m, n;
   uint64 x;
-
-  /* initialize data array to all zeros */
-  for (i = 0; i < size; i++)
-    data[i] = 0;
+  uint64 plane[64];
 
   /* decode one bit plane at a time from MSB to LSB */
   for (k = intprec, m = n = 0; bits && (m = 0, k-- > kmin);) {
@@ -116,11 +196,14 @@ _t1(decode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxpr
         break;
       }
     }
-    /* step 3: deposit bit plane from x */
-    for (i = 0; x; i++, x >>= 1)
-      data[i] += (UInt)(x & 1u) << k;
+    /* step 3: save bit plane from x */
+    plane[k] = x;
+    kend = k;
   }
 
+  /* deposit bit planes #kend through #intprec-1 */
+  _t1(deposit_planes, UInt)(data, size, plane, kend);
+
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_LAST
   /* bias values to achieve proper rounding */
   _t1(inv_round, UInt)(data, size, m, intprec - k);
@@ -192,11 +275,8 @@ _t1(decode_few_ints_prec, UInt)(bitstream* restrict_ stream, uint maxprec, UInt*
   bitstream_offset offset = stream_rtell(&s);
   uint intprec = (uint)(CHAR_BIT * sizeof(UInt));
   uint kmin = intprec > maxprec ? intprec - maxprec : 0;
-  uint i, k, n;
-
-  /* initialize data array to all zeros */
-  for (i = 0; i < size; i++)
-    data[i] = 0;
+  uint k, n;
+  uint64 plane[64];
 
   /* decode one bit plane at a time from MSB to LSB */
   for (k = intprec, n = 0; k-- > kmin;) {
@@ -206,11 +286,13 @@ _t1(decode_few_ints_prec, UInt)(bitstream* restrict_ stream, uint maxprec, UInt*
     for (; n < size && stream_read_bit(&s); x += (uint64)1 << n, n++)
       for (; n < size - 1 && !stream_read_bit(&s); n++)
         ;
-    /* step 3: deposit bit plane from x */
-    for (i = 0; x; i++, x >>= 1)
-      data[i] += (UInt)(x & 1u) << k;
+    /* step 3: save bit plane from x */
+    plane[k] = x;
   }
 
+  /* deposit bit planes #kmin through #intprec-1 */
+  _t1(deposit_planes, UInt)(data, size, plane, kmin);
+
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_LAST
   /* bias values to achieve proper rounding */
   _t1(inv_round, UInt)(data, size, 0, intprec - k);
@@ -20,11 +20,27 @@ _t2(scatter_partial, Scalar, 2)(const Scalar* q, Scalar* p, size_t nx, size_t ny
       *p = *q;
 }
 
+#ifdef ZFP_SIMD
+/* inverse decorrelating 2D transform using SIMD instructions */
+_t1(simd_target, Int) static void
+_t2(inv_xform_simd, Int, 2)(Int* p)
+{
+  /* transform along y and x */
+  _t1(inv_lift_slab_simd, Int)(p);
+}
+#endif
+
 /* inverse decorrelating 2D transform */
 static void
 _t2(inv_xform, Int, 2)(Int* p)
 {
   uint x, y;
+#ifdef ZFP_SIMD
+  if (_t1(simd_supported, Int)()) {
+    _t2(inv_xform_simd, Int, 2)(p);
+    return;
+  }
+#endif
   /* transform along y */
   for (x = 0; x < 4; x++)
     _t1(inv_lift, Int)(p + 1 * x, 4);
@@ -22,11 +22,32 @@ _t2(scatter_partial, Scalar, 3)(const Scalar* q, Scalar* p, size_t nx, size_t ny
         *p = *q;
 }
 
+#ifdef ZFP_SIMD
+/* inverse decorrelating 3D transform using SIMD instructions */
+_t1(simd_target, Int) static void
+_t2(inv_xform_simd, Int, 3)(Int* p)
+{
+  uint y, z;
+  /* transform along z */
+  for (y = 0; y < 4; y++)
+    _t1(inv_lift_rows_simd, Int)(p + 4 * y, 16);
+  /* transform along y and x */
+  for (z = 0; z < 4; z++)
+    _t1(inv_lift_slab_simd, Int)(p + 16 * z);
+}
+#endif
+
 /* inverse decorrelating 3D transform */
 static void
 _t2(inv_xform, Int, 3)(Int* p)
 {
   uint x, y, z;
+#ifdef ZFP_SIMD
+  if (_t1(simd_supported, Int)()) {
+    _t2(inv_xform_simd, Int, 3)(p);
+    return;
+  }
+#endif
   /* transform along z */
   for (y = 0; y < 4; y++)
     for (x = 0; x < 4; x++)
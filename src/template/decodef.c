@@ -34,6 +34,27 @@ _t2(decode_block, Scalar, DIMS)(zfp_stream* zfp, Scalar* fblock)
   return bits;
 }
 
+/* decode count contiguous blocks stored back to back at fblock or at block[i] */
+static size_t
+_t2(decode_blocks, Scalar, DIMS)(zfp_stream* zfp, Scalar* fblock, Scalar* const* block, size_t count)
+{
+  /* make a copy of stream to avoid aliasing and reloading its parameters */
+  bitstream s = *zfp->stream;
+  zfp_stream z = *zfp;
+  zfp_bool reversible = REVERSIBLE(zfp);
+  size_t bits = 0;
+  size_t i;
+
+  z.stream = &s;
+  for (i = 0; i < count; i++) {
+    Scalar* p = block ? block[i] : fblock + BLOCK_SIZE * i;
+    bits += reversible ? _t2(rev_decode_block, Scalar, DIMS)(&z, p) : _t2(decode_block, Scalar, DIMS)(&z, p);
+  }
+
+  *zfp->stream = s;
+  return bits;
+}
+
 /* public functions -------------------------------------------------------- */
 
 /* decode contiguous floating-point block */
@@ -42,3 +63,17 @@ _t2(zfp_decode_block, Scalar, DIMS)(zfp_stream* zfp, Scalar* fblock)
 {
   return REVERSIBLE(zfp) ? _t2(rev_decode_block, Scalar, DIMS)(zfp, fblock) : _t2(decode_block, Scalar, DIMS)(zfp, fblock);
 }
+
+/* decode count contiguous floating-point blocks stored back to back */
+size_t
+_t2(zfp_decode_blocks, Scalar, DIMS)(zfp_stream* zfp, Scalar* fblock, size_t count)
+{
+  return _t2(decode_blocks, Scalar, DIMS)(zfp, fblock, NULL, count);
+}
+
+/* decode count contiguous floating-point blocks stored at block[0 ... count - 1] */
+size_t
+_t2(zfp_decode_blocks_indirect, Scalar, DIMS)(zfp_stream* zfp, Scalar* const* block, size_t count)
+{
+  return _t2(decode_blocks, Scalar, DIMS)(zfp, NULL, block, count);
+}
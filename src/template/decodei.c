@@ -1,5 +1,29 @@
 static uint _t2(rev_decode_block, Int, DIMS)(bitstream* stream, uint minbits, uint maxbits, Int* iblock);
 
+/* private functions ------------------------------------------------------- */
+
+/* decode count contiguous blocks stored back to back at iblock or at block[i] */
+static size_t
+_t2(decode_blocks, Int, DIMS)(zfp_stream* zfp, Int* iblock, Int* const* block, size_t count)
+{
+  /* make a copy of bit stream to avoid aliasing */
+  bitstream s = *zfp->stream;
+  uint minbits = zfp->minbits;
+  uint maxbits = zfp->maxbits;
+  uint maxprec = zfp->maxprec;
+  zfp_bool reversible = REVERSIBLE(zfp);
+  size_t bits = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    Int* p = block ? block[i] : iblock + BLOCK_SIZE * i;
+    bits += reversible ? _t2(rev_decode_block, Int, DIMS)(&s, minbits, maxbits, p) : _t2(decode_block, Int, DIMS)(&s, minbits, maxbits, maxprec, p);
+  }
+
+  *zfp->stream = s;
+  return bits;
+}
+
 /* public functions -------------------------------------------------------- */
 
 /* decode contiguous integer block */
@@ -8,3 +32,17 @@ _t2(zfp_decode_block, Int, DIMS)(zfp_stream* zfp, Int* iblock)
 {
   return REVERSIBLE(zfp) ? _t2(rev_decode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, iblock) : _t2(decode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, iblock);
 }
+
+/* decode count contiguous integer blocks stored back to back */
+size_t
+_t2(zfp_decode_blocks, Int, DIMS)(zfp_stream* zfp, Int* iblock, size_t count)
+{
+  return _t2(decode_blocks, Int, DIMS)(zfp, iblock, NULL, count);
+}
+
+/* decode count contiguous integer blocks stored at block[0 ... count - 1] */
+size_t
+_t2(zfp_decode_blocks_indirect, Int, DIMS)(zfp_stream* zfp, Int* const* block, size_t count)
+{
+  return _t2(decode_blocks, Int, DIMS)(zfp, NULL, block, count);
+}
@@ -0,0 +1,99 @@
+/* decode block whose sizes are given by n to strided storage at p */
+static size_t
+_t1(decode_block_box, Scalar)(zfp_stream* stream, Scalar* p, uint dims, const size_t* n, const ptrdiff_t* s)
+{
+  switch (dims) {
+    case 1:
+      return n[0] == 4
+               ? _t2(zfp_decode_block_strided, Scalar, 1)(stream, p, s[0])
+               : _t2(zfp_decode_partial_block_strided, Scalar, 1)(stream, p, n[0], s[0]);
+    case 2:
+      return n[0] == 4 && n[1] == 4
+               ? _t2(zfp_decode_block_strided, Scalar, 2)(stream, p, s[0], s[1])
+               : _t2(zfp_decode_partial_block_strided, Scalar, 2)(stream, p, n[0], n[1], s[0], s[1]);
+    case 3:
+      return n[0] == 4 && n[1] == 4 && n[2] == 4
+               ? _t2(zfp_decode_block_strided, Scalar, 3)(stream, p, s[0], s[1], s[2])
+               : _t2(zfp_decode_partial_block_strided, Scalar, 3)(stream, p, n[0], n[1], n[2], s[0], s[1], s[2]);
+    case 4:
+      return n[0] == 4 && n[1] == 4 && n[2] == 4 && n[3] == 4
+               ? _t2(zfp_decode_block_strided, Scalar, 4)(stream, p, s[0], s[1], s[2], s[3])
+               : _t2(zfp_decode_partial_block_strided, Scalar, 4)(stream, p, n[0], n[1], n[2], n[3], s[0], s[1], s[2], s[3]);
+    default:
+      return 0;
+  }
+}
+
+/* decompress box of field with origin o from blocks located via index */
+static size_t
+_t1(decompress_box, Scalar)(zfp_stream* stream, const zfp_index* index, zfp_field* field, const size_t* o)
+{
+  Scalar* data = (Scalar*)field->data;
+  uint dims = zfp_field_dimensionality(field);
+  bitstream_offset base = stream_rtell(stream->stream);
+  size_t bits = 0;
+  size_t n[4], N[4], g[4], bmin[4], bmax[4], b[4];
+  ptrdiff_t s[4] = { 0, 0, 0, 0 };
+  uint i;
+
+  /* box and field sizes and range of blocks overlapping box */
+  n[0] = field->nx; N[0] = index->nx;
+  n[1] = field->ny; N[1] = index->ny;
+  n[2] = field->nz; N[2] = index->nz;
+  n[3] = field->nw; N[3] = index->nw;
+  for (i = 0; i < 4; i++) {
+    g[i] = (N[i] + 3) / 4;
+    bmin[i] = i < dims ? o[i] / 4 : 0;
+    bmax[i] = i < dims ? (o[i] + n[i] + 3) / 4 : 1;
+  }
+  zfp_field_stride(field, s);
+
+  /* decode each block overlapping box */
+  for (b[3] = bmin[3]; b[3] < bmax[3]; b[3]++)
+    for (b[2] = bmin[2]; b[2] < bmax[2]; b[2]++)
+      for (b[1] = bmin[1]; b[1] < bmax[1]; b[1]++)
+        for (b[0] = bmin[0]; b[0] < bmax[0]; b[0]++) {
+          size_t block = b[0] + g[0] * (b[1] + g[1] * (b[2] + g[2] * b[3]));
+          size_t m[4];
+          zfp_bool inside = zfp_true;
+          Scalar* p = data;
+          stream_rseek(stream->stream, base + index_block_offset(index, block));
+          /* blocks contained in box are decoded directly to field */
+          for (i = 0; i < dims; i++) {
+            size_t x = 4 * b[i];
+            m[i] = MIN(x + 4, o[i] + n[i]) - x;
+            if (x < o[i] || m[i] < MIN(4, N[i] - x))
+              inside = zfp_false;
+            else
+              p += s[i] * (ptrdiff_t)(x - o[i]);
+          }
+          if (inside)
+            bits += _t1(decode_block_box, Scalar)(stream, p, dims, m, s);
+          else {
+            /* decode block to scratch storage and copy intersection with box */
+            Scalar block_data[256];
+            const size_t full[4] = { 4, 4, 4, 4 };
+            const ptrdiff_t bs[4] = { 1, 4, 16, 64 };
+            size_t xmin[4], xmax[4], x[4];
+            bits += _t1(decode_block_box, Scalar)(stream, block_data, dims, full, bs);
+            for (i = 0; i < 4; i++) {
+              xmin[i] = i < dims ? MAX(4 * b[i], o[i]) : 0;
+              xmax[i] = i < dims ? MIN(4 * b[i] + 4, o[i] + n[i]) : 1;
+            }
+            for (x[3] = xmin[3]; x[3] < xmax[3]; x[3]++)
+              for (x[2] = xmin[2]; x[2] < xmax[2]; x[2]++)
+                for (x[1] = xmin[1]; x[1] < xmax[1]; x[1]++)
+                  for (x[0] = xmin[0]; x[0] < xmax[0]; x[0]++) {
+                    ptrdiff_t q = 0;
+                    size_t r = 0;
+                    for (i = dims; i-- > 0;) {
+                      q += s[i] * (ptrdiff_t)(x[i] - o[i]);
+                      r = 4 * r + (x[i] - 4 * b[i]);
+                    }
+                    data[q] = block_data[r];
+                  }
+          }
+        }
+
+  return bits;
+}
@@ -1,4 +1,5 @@
 #include <limits.h>
+#include "simd.h"
 
 static void _t2(fwd_xform, Int, DIMS)(Int* p);
 
@@ -55,6 +56,58 @@ _t1(fwd_lift, Int)(Int* p, ptrdiff_t s)
   p -= s; *p = x;
 }
 
+#ifdef ZFP_SIMD
+/* forward lifting transform of four 4-vectors, one per SIMD lane */
+_t1(simd_target, Int) inline_ void
+_t1(fwd_lift_simd, Int)(_t1(vec, Int)* v)
+{
+  _t1(vec, Int) x = v[0], y = v[1], z = v[2], w = v[3];
+
+  /* same sequence of operations as fwd_lift() */
+  x = _t1(simd_add, Int)(x, w); x = _t1(simd_shr, Int)(x); w = _t1(simd_sub, Int)(w, x);
+  z = _t1(simd_add, Int)(z, y); z = _t1(simd_shr, Int)(z); y = _t1(simd_sub, Int)(y, z);
+  x = _t1(simd_add, Int)(x, z); x = _t1(simd_shr, Int)(x); z = _t1(simd_sub, Int)(z, x);
+  w = _t1(simd_add, Int)(w, y); w = _t1(simd_shr, Int)(w); y = _t1(simd_sub, Int)(y, w);
+  w = _t1(simd_add, Int)(w, _t1(simd_shr, Int)(y)); y = _t1(simd_sub, Int)(y, _t1(simd_shr, Int)(w));
+
+  v[0] = x;
+  v[1] = y;
+  v[2] = z;
+  v[3] = w;
+}
+
+/* forward transform of four contiguous 4-vectors laid out with stride s */
+_t1(simd_target, Int) inline_ void
+_t1(fwd_lift_rows_simd, Int)(Int* p, ptrdiff_t s)
+{
+  _t1(vec, Int) v[4];
+  uint i;
+  for (i = 0; i < 4; i++)
+    v[i] = _t1(simd_load, Int)(p + i * s);
+  _t1(fwd_lift_simd, Int)(v);
+  for (i = 0; i < 4; i++)
+    _t1(simd_store, Int)(p + i * s, v[i]);
+}
+
+/* forward transform along x and y of contiguous 4x4 slab */
+_t1(simd_target, Int) inline_ void
+_t1(fwd_lift_slab_simd, Int)(Int* p)
+{
+  _t1(vec, Int) v[4];
+  uint i;
+  for (i = 0; i < 4; i++)
+    v[i] = _t1(simd_load, Int)(p + 4 * i);
+  /* transform along x */
+  _t1(simd_transpose, Int)(v);
+  _t1(fwd_lift_simd, Int)(v);
+  _t1(simd_transpose, Int)(v);
+  /* transform along y */
+  _t1(fwd_lift_simd, Int)(v);
+  for (i = 0; i < 4; i++)
+    _t1(simd_store, Int)(p + 4 * i, v[i]);
+}
+#endif
+
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_FIRST
 /* bias values such that truncation is equivalent to round to nearest */
 static void
@@ -96,15 +149,28 @@ _t1(encode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxpr
   uint intprec = (uint)(CHAR_BIT * sizeof(UInt));
   uint kmin = intprec > maxprec ? intprec - maxprec : 0;
   uint bits = maxbits;
+  int transpose = with_transpose(size, intprec - kmin);
   uint i, k, m, n;
   uint64 x;
+  uint64 plane[64];
+
+  /* extract all bit planes at once */
+  if (transpose) {
+    for (i = 0; i < 64; i++)
+      plane[i] = data[i];
+    transpose_bits(plane);
+  }
 
   /* encode one bit plane at a time from MSB to LSB */
   for (k = intprec, n = 0; bits && k-- > kmin;) {
     /* step 1: extract bit plane #k to x */
-    x = 0;
-    for (i = 0; i < size; i++)
-      x += (uint64)((data[i] >> k) & 1u) << i;
+    if (transpose)
+      x = plane[k];
+    else {
+      x = 0;
+      for (i = 0; i < size; i++)
+        x += (uint64)((data[i] >> k) & 1u) << i;
+    }
     /* step 2: encode first n bits of bit plane */
     m = MIN(n, bits);
     bits -= m;
@@ -184,14 +250,26 @@ _t1(encode_few_ints_prec, UInt)(bitstream* restrict_ stream, uint maxprec, const
   bitstream_offset offset = stream_wtell(&s);
   uint intprec = (uint)(CHAR_BIT * sizeof(UInt));
   uint kmin = intprec > maxprec ? intprec - maxprec : 0;
+  int transpose = with_transpose(size, intprec - kmin);
   uint i, k, n;
+  uint64 plane[64];
+
+  /* extract all bit planes at once */
+  if (transpose) {
+    for (i = 0; i < 64; i++)
+      plane[i] = data[i];
+    transpose_bits(plane);
+  }
 
   /* encode one bit plane at a time from MSB to LSB */
   for (k = intprec, n = 0; k-- > kmin;) {
     /* step 1: extract bit plane #k to x */
     uint64 x = 0;
-    for (i = 0; i < size; i++)
-      x += (uint64)((data[i] >> k) & 1u) << i;
+    if (transpose)
+      x = plane[k];
+    else
+      for (i = 0; i < size; i++)
+        x += (uint64)((data[i] >> k) & 1u) << i;
     /* step 2: encode first n bits of bit plane */
     x = stream_write_bits(&s, x, n);
     /* step 3: unary run-length encode remainder of bit plane */
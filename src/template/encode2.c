@@ -24,11 +24,27 @@ _t2(gather_partial, Scalar, 2)(Scalar* q, const Scalar* p, size_t nx, size_t ny,
     _t1(pad_block, Scalar)(q + x, ny, 4);
 }
 
+#ifdef ZFP_SIMD
+/* forward decorrelating 2D transform using SIMD instructions */
+_t1(simd_target, Int) static void
+_t2(fwd_xform_simd, Int, 2)(Int* p)
+{
+  /* transform along x and y */
+  _t1(fwd_lift_slab_simd, Int)(p);
+}
+#endif
+
 /* forward decorrelating 2D transform */
 static void
 _t2(fwd_xform, Int, 2)(Int* p)
 {
   uint x, y;
+#ifdef ZFP_SIMD
+  if (_t1(simd_supported, Int)()) {
+    _t2(fwd_xform_simd, Int, 2)(p);
+    return;
+  }
+#endif
   /* transform along x */
   for (y = 0; y < 4; y++)
     _t1(fwd_lift, Int)(p + 4 * y, 1);
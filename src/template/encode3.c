@@ -30,11 +30,32 @@ _t2(gather_partial, Scalar, 3)(Scalar* q, const Scalar* p, size_t nx, size_t ny,
       _t1(pad_block, Scalar)(q + 4 * y + x, nz, 16);
 }
 
+#ifdef ZFP_SIMD
+/* forward decorrelating 3D transform using SIMD instructions */
+_t1(simd_target, Int) static void
+_t2(fwd_xform_simd, Int, 3)(Int* p)
+{
+  uint y, z;
+  /* transform along x and y */
+  for (z = 0; z < 4; z++)
+    _t1(fwd_lift_slab_simd, Int)(p + 16 * z);
+  /* transform along z */
+  for (y = 0; y < 4; y++)
+    _t1(fwd_lift_rows_simd, Int)(p + 4 * y, 16);
+}
+#endif
+
 /* forward decorrelating 3D transform */
 static void
 _t2(fwd_xform, Int, 3)(Int* p)
 {
   uint x, y, z;
+#ifdef ZFP_SIMD
+  if (_t1(simd_supported, Int)()) {
+    _t2(fwd_xform_simd, Int, 3)(p);
+    return;
+  }
+#endif
   /* transform along x */
   for (z = 0; z < 4; z++)
     for (y = 0; y < 4; y++)
@@ -37,11 +37,38 @@ _t2(gather_partial, Scalar, 4)(Scalar* q, const Scalar* p, size_t nx, size_t ny,
         _t1(pad_block, Scalar)(q + 16 * z + 4 * y + x, nw, 64);
 }
 
+#ifdef ZFP_SIMD
+/* forward decorrelating 4D transform using SIMD instructions */
+_t1(simd_target, Int) static void
+_t2(fwd_xform_simd, Int, 4)(Int* p)
+{
+  uint y, z, w;
+  /* transform along x and y */
+  for (w = 0; w < 4; w++)
+    for (z = 0; z < 4; z++)
+      _t1(fwd_lift_slab_simd, Int)(p + 16 * z + 64 * w);
+  /* transform along z */
+  for (w = 0; w < 4; w++)
+    for (y = 0; y < 4; y++)
+      _t1(fwd_lift_rows_simd, Int)(p + 4 * y + 64 * w, 16);
+  /* transform along w */
+  for (z = 0; z < 4; z++)
+    for (y = 0; y < 4; y++)
+      _t1(fwd_lift_rows_simd, Int)(p + 4 * y + 16 * z, 64);
+}
+#endif
+
 /* forward decorrelating 4D transform */
 static void
 _t2(fwd_xform, Int, 4)(Int* p)
 {
   uint x, y, z, w;
+#ifdef ZFP_SIMD
+  if (_t1(simd_supported, Int)()) {
+    _t2(fwd_xform_simd, Int, 4)(p);
+    return;
+  }
+#endif
   /* transform along x */
   for (w = 0; w < 4; w++)
     for (z = 0; z < 4; z++)
@@ -89,6 +89,27 @@ _t2(encode_block, Scalar, DIMS)(zfp_stream* zfp, const Scalar* fblock)
   return bits;
 }
 
+/* encode count contiguous blocks stored back to back at fblock or at block[i] */
+static size_t
+_t2(encode_blocks, Scalar, DIMS)(zfp_stream* zfp, const Scalar* fblock, const Scalar* const* block, size_t count)
+{
+  /* make a copy of stream to avoid aliasing and reloading its parameters */
+  bitstream s = *zfp->stream;
+  zfp_stream z = *zfp;
+  zfp_bool reversible = REVERSIBLE(zfp);
+  size_t bits = 0;
+  size_t i;
+
+  z.stream = &s;
+  for (i = 0; i < count; i++) {
+    const Scalar* p = block ? block[i] : fblock + BLOCK_SIZE * i;
+    bits += reversible ? _t2(rev_encode_block, Scalar, DIMS)(&z, p) : _t2(encode_block, Scalar, DIMS)(&z, p);
+  }
+
+  *zfp->stream = s;
+  return bits;
+}
+
 /* public functions -------------------------------------------------------- */
 
 /* encode contiguous floating-point block */
@@ -97,3 +118,17 @@ _t2(zfp_encode_block, Scalar, DIMS)(zfp_stream* zfp, const Scalar* fblock)
 {
   return REVERSIBLE(zfp) ? _t2(rev_encode_block, Scalar, DIMS)(zfp, fblock) : _t2(encode_block, Scalar, DIMS)(zfp, fblock);
 }
+
+/* encode count contiguous floating-point blocks stored back to back */
+size_t
+_t2(zfp_encode_blocks, Scalar, DIMS)(zfp_stream* zfp, const Scalar* fblock, size_t count)
+{
+  return _t2(encode_blocks, Scalar, DIMS)(zfp, fblock, NULL, count);
+}
+
+/* encode count contiguous floating-point blocks stored at block[0 ... count - 1] */
+size_t
+_t2(zfp_encode_blocks_indirect, Scalar, DIMS)(zfp_stream* zfp, const Scalar* const* block, size_t count)
+{
+  return _t2(encode_blocks, Scalar, DIMS)(zfp, NULL, block, count);
+}
@@ -1,5 +1,34 @@
 static uint _t2(rev_encode_block, Int, DIMS)(bitstream* stream, uint minbits, uint maxbits, uint maxprec, Int* iblock);
 
+/* private functions ------------------------------------------------------- */
+
+/* encode count contiguous blocks stored back to back at iblock or at block[i] */
+static size_t
+_t2(encode_blocks, Int, DIMS)(zfp_stream* zfp, const Int* iblock, const Int* const* block, size_t count)
+{
+  /* make a copy of bit stream to avoid aliasing */
+  bitstream s = *zfp->stream;
+  uint minbits = zfp->minbits;
+  uint maxbits = zfp->maxbits;
+  uint maxprec = zfp->maxprec;
+  zfp_bool reversible = REVERSIBLE(zfp);
+  size_t bits = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    cache_align_(Int b[BLOCK_SIZE]);
+    const Int* p = block ? block[i] : iblock + BLOCK_SIZE * i;
+    uint j;
+    /* copy block */
+    for (j = 0; j < BLOCK_SIZE; j++)
+      b[j] = p[j];
+    bits += reversible ? _t2(rev_encode_block, Int, DIMS)(&s, minbits, maxbits, maxprec, b) : _t2(encode_block, Int, DIMS)(&s, minbits, maxbits, maxprec, b);
+  }
+
+  *zfp->stream = s;
+  return bits;
+}
+
 /* public functions -------------------------------------------------------- */
 
 /* encode contiguous integer block */
@@ -13,3 +42,17 @@ _t2(zfp_encode_block, Int, DIMS)(zfp_stream* zfp, const Int* iblock)
     block[i] = iblock[i];
   return REVERSIBLE(zfp) ? _t2(rev_encode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, block) : _t2(encode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, block);
 }
+
+/* encode count contiguous integer blocks stored back to back */
+size_t
+_t2(zfp_encode_blocks, Int, DIMS)(zfp_stream* zfp, const Int* iblock, size_t count)
+{
+  return _t2(encode_blocks, Int, DIMS)(zfp, iblock, NULL, count);
+}
+
+/* encode count contiguous integer blocks stored at block[0 ... count - 1] */
+size_t
+_t2(zfp_encode_blocks_indirect, Int, DIMS)(zfp_stream* zfp, const Int* const* block, size_t count)
+{
+  return _t2(encode_blocks, Int, DIMS)(zfp, NULL, block, count);
+}
@@ -0,0 +1,52 @@
+#ifdef _OPENMP
+
+/* decompress 1d contiguous array in parallel */
+static void
+_t2(decompress_omp, Scalar, 1)(zfp_stream* stream, zfp_field* field)
+{
+  size_t blocks = (field->nx + 3) / 4;
+  decompress_chunks_omp(stream, field, blocks, _t2(decompress_chunk, Scalar, 1));
+}
+
+/* decompress 1d strided array in parallel */
+static void
+_t2(decompress_strided_omp, Scalar, 1)(zfp_stream* stream, zfp_field* field)
+{
+  size_t blocks = (field->nx + 3) / 4;
+  decompress_chunks_omp(stream, field, blocks, _t2(decompress_chunk_strided, Scalar, 1));
+}
+
+/* decompress 2d strided array in parallel */
+static void
+_t2(decompress_strided_omp, Scalar, 2)(zfp_stream* stream, zfp_field* field)
+{
+  size_t bx = (field->nx + 3) / 4;
+  size_t by = (field->ny + 3) / 4;
+  size_t blocks = bx * by;
+  decompress_chunks_omp(stream, field, blocks, _t2(decompress_chunk_strided, Scalar, 2));
+}
+
+/* decompress 3d strided array in parallel */
+static void
+_t2(decompress_strided_omp, Scalar, 3)(zfp_stream* stream, zfp_field* field)
+{
+  size_t bx = (field->nx + 3) / 4;
+  size_t by = (field->ny + 3) / 4;
+  size_t bz = (field->nz + 3) / 4;
+  size_t blocks = bx * by * bz;
+  decompress_chunks_omp(stream, field, blocks, _t2(decompress_chunk_strided, Scalar, 3));
+}
+
+/* decompress 4d strided array in parallel */
+static void
+_t2(decompress_strided_omp, Scalar, 4)(zfp_stream* stream, zfp_field* field)
+{
+  size_t bx = (field->nx + 3) / 4;
+  size_t by = (field->ny + 3) / 4;
+  size_t bz = (field->nz + 3) / 4;
+  size_t bw = (field->nw + 3) / 4;
+  size_t blocks = bx * by * bz * bw;
+  decompress_chunks_omp(stream, field, blocks, _t2(decompress_chunk_strided, Scalar, 4));
+}
+
+#endif
@@ -0,0 +1,148 @@
+/* decompress blocks bmin through bmax - 1 of 1d contiguous array */
+static void
+_t2(decompress_chunk, Scalar, 1)(zfp_stream* stream, zfp_field* field, size_t bmin, size_t bmax)
+{
+  /* array metadata */
+  Scalar* data = (Scalar*)field->data;
+  size_t nx = field->nx;
+  size_t block;
+
+  /* decompress sequence of blocks */
+  for (block = bmin; block < bmax; block++) {
+    /* determine block origin x within array */
+    Scalar* p = data;
+    size_t x = 4 * block;
+    p += x;
+    /* decompress partial or full block */
+    if (nx - x < 4u)
+      _t2(zfp_decode_partial_block_strided, Scalar, 1)(stream, p, nx - x, 1);
+    else
+      _t2(zfp_decode_block, Scalar, 1)(stream, p);
+  }
+}
+
+/* decompress blocks bmin through bmax - 1 of 1d strided array */
+static void
+_t2(decompress_chunk_strided, Scalar, 1)(zfp_stream* stream, zfp_field* field, size_t bmin, size_t bmax)
+{
+  /* array metadata */
+  Scalar* data = (Scalar*)field->data;
+  size_t nx = field->nx;
+  ptrdiff_t sx = field->sx ? field->sx : 1;
+  size_t block;
+
+  /* decompress sequence of blocks */
+  for (block = bmin; block < bmax; block++) {
+    /* determine block origin x within array */
+    Scalar* p = data;
+    size_t x = 4 * block;
+    p += sx * (ptrdiff_t)x;
+    /* decompress partial or full block */
+    if (nx - x < 4u)
+      _t2(zfp_decode_partial_block_strided, Scalar, 1)(stream, p, nx - x, sx);
+    else
+      _t2(zfp_decode_block_strided, Scalar, 1)(stream, p, sx);
+  }
+}
+
+/* decompress blocks bmin through bmax - 1 of 2d strided array */
+static void
+_t2(decompress_chunk_strided, Scalar, 2)(zfp_stream* stream, zfp_field* field, size_t bmin, size_t bmax)
+{
+  /* array metadata */
+  Scalar* data = (Scalar*)field->data;
+  size_t nx = field->nx;
+  size_t ny = field->ny;
+  ptrdiff_t sx = field->sx ? field->sx : 1;
+  ptrdiff_t sy = field->sy ? field->sy : (ptrdiff_t)nx;
+  size_t bx = (nx + 3) / 4;
+  size_t block;
+
+  /* decompress sequence of blocks */
+  for (block = bmin; block < bmax; block++) {
+    /* determine block origin (x, y) within array */
+    Scalar* p = data;
+    size_t b = block;
+    size_t x, y;
+    x = 4 * (b % bx); b /= bx;
+    y = 4 * b;
+    p += sx * (ptrdiff_t)x + sy * (ptrdiff_t)y;
+    /* decompress partial or full block */
+    if (nx - x < 4u || ny - y < 4u)
+      _t2(zfp_decode_partial_block_strided, Scalar, 2)(stream, p, MIN(nx - x, 4u), MIN(ny - y, 4u), sx, sy);
+    else
+      _t2(zfp_decode_block_strided, Scalar, 2)(stream, p, sx, sy);
+  }
+}
+
+/* decompress blocks bmin through bmax - 1 of 3d strided array */
+static void
+_t2(decompress_chunk_strided, Scalar, 3)(zfp_stream* stream, zfp_field* field, size_t bmin, size_t bmax)
+{
+  /* array metadata */
+  Scalar* data = (Scalar*)field->data;
+  size_t nx = field->nx;
+  size_t ny = field->ny;
+  size_t nz = field->nz;
+  ptrdiff_t sx = field->sx ? field->sx : 1;
+  ptrdiff_t sy = field->sy ? field->sy : (ptrdiff_t)nx;
+  ptrdiff_t sz = field->sz ? field->sz : (ptrdiff_t)(nx * ny);
+  size_t bx = (nx + 3) / 4;
+  size_t by = (ny + 3) / 4;
+  size_t block;
+
+  /* decompress sequence of blocks */
+  for (block = bmin; block < bmax; block++) {
+    /* determine block origin (x, y, z) within array */
+    Scalar* p = data;
+    size_t b = block;
+    size_t x, y, z;
+    x = 4 * (b % bx); b /= bx;
+    y = 4 * (b % by); b /= by;
+    z = 4 * b;
+    p += sx * (ptrdiff_t)x + sy * (ptrdiff_t)y + sz * (ptrdiff_t)z;
+    /* decompress partial or full block */
+    if (nx - x < 4u || ny - y < 4u || nz - z < 4u)
+      _t2(zfp_decode_partial_block_strided, Scalar, 3)(stream, p, MIN(nx - x, 4u), MIN(ny - y, 4u), MIN(nz - z, 4u), sx, sy, sz);
+    else
+      _t2(zfp_decode_block_strided, Scalar, 3)(stream, p, sx, sy, sz);
+  }
+}
+
+/* decompress blocks bmin through bmax - 1 of 4d strided array */
+static void
+_t2(decompress_chunk_strided, Scalar, 4)(zfp_stream* stream, zfp_field* field, size_t bmin, size_t bmax)
+{
+  /* array metadata */
+  Scalar* data = (Scalar*)field->data;
+  size_t nx = field->nx;
+  size_t ny = field->ny;
+  size_t nz = field->nz;
+  size_t nw = field->nw;
+  ptrdiff_t sx = field->sx ? field->sx : 1;
+  ptrdiff_t sy = field->sy ? field->sy : (ptrdiff_t)nx;
+  ptrdiff_t sz = field->sz ? field->sz : (ptrdiff_t)(nx * ny);
+  ptrdiff_t sw = field->sw ? field->sw : (ptrdiff_t)(nx * ny * nz);
+  size_t bx = (nx + 3) / 4;
+  size_t by = (ny + 3) / 4;
+  size_t bz = (nz + 3) / 4;
+  size_t block;
+
+  /* decompress sequence of blocks */
+  for (block = bmin; block < bmax; block++) {
+    /* determine block origin (x, y, z, w) within array */
+    Scalar* p = data;
+    size_t b = block;
+    size_t x, y, z, w;
+    x = 4 * (b % bx); b /= bx;
+    y = 4 * (b % by); b /= by;
+    z = 4 * (b % bz); b /= bz;
+    w = 4 * b;
+    p += sx * (ptrdiff_t)x + sy * (ptrdiff_t)y + sz * (ptrdiff_t)z + sw * (ptrdiff_t)w;
+    /* decompress partial or full block */
+    if (nx - x < 4u || ny - y < 4u || nz - z < 4u || nw - w < 4u)
+      _t2(zfp_decode_partial_block_strided, Scalar, 4)(stream, p, MIN(nx - x, 4u), MIN(ny - y, 4u), MIN(nz - z, 4u), MIN(nw - w, 4u), sx, sy, sz, sw);
+    else
+      _t2(zfp_decode_block_strided, Scalar, 4)(stream, p, sx, sy, sz, sw);
+  }
+}
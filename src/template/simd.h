@@ -0,0 +1,133 @@
+#ifndef ZFP_SIMD_H
+#define ZFP_SIMD_H
+
+/* SIMD transforms require x86 SSE2 and GNU C support for CPU dispatch */
+#if defined(ZFP_WITH_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+  #define ZFP_SIMD
+#endif
+
+#ifdef ZFP_SIMD
+
+#include <immintrin.h>
+#include "zfp/internal/zfp/inline.h"
+
+/* vector of four 32-bit integers (SSE2, always available) */
+typedef __m128i vec_int32;
+#define simd_target_int32
+
+/* vector of four 64-bit integers (AVX2, detected at run time) */
+typedef __m256i vec_int64;
+#define simd_target_int64 __attribute__((target("avx2")))
+
+/* whether the CPU supports SIMD transforms of 32-bit integers */
+inline_ int
+simd_supported_int32(void)
+{
+  return 1;
+}
+
+/* whether the CPU supports SIMD transforms of 64-bit integers */
+inline_ int
+simd_supported_int64(void)
+{
+  return __builtin_cpu_supports("avx2");
+}
+
+/* 32-bit integer primitives ----------------------------------------------- */
+
+inline_ vec_int32
+simd_load_int32(const int32* p)
+{
+  return _mm_loadu_si128((const __m128i*)p);
+}
+
+inline_ void
+simd_store_int32(int32* p, vec_int32 x)
+{
+  _mm_storeu_si128((__m128i*)p, x);
+}
+
+inline_ vec_int32
+simd_add_int32(vec_int32 x, vec_int32 y)
+{
+  return _mm_add_epi32(x, y);
+}
+
+inline_ vec_int32
+simd_sub_int32(vec_int32 x, vec_int32 y)
+{
+  return _mm_sub_epi32(x, y);
+}
+
+/* arithmetic shift right by one bit */
+inline_ vec_int32
+simd_shr_int32(vec_int32 x)
+{
+  return _mm_srai_epi32(x, 1);
+}
+
+/* transpose 4x4 matrix whose rows are v[0], ..., v[3] */
+inline_ void
+simd_transpose_int32(vec_int32* v)
+{
+  __m128i t0 = _mm_unpacklo_epi32(v[0], v[1]);
+  __m128i t1 = _mm_unpacklo_epi32(v[2], v[3]);
+  __m128i t2 = _mm_unpackhi_epi32(v[0], v[1]);
+  __m128i t3 = _mm_unpackhi_epi32(v[2], v[3]);
+  v[0] = _mm_unpacklo_epi64(t0, t1);
+  v[1] = _mm_unpackhi_epi64(t0, t1);
+  v[2] = _mm_unpacklo_epi64(t2, t3);
+  v[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/* 64-bit integer primitives ----------------------------------------------- */
+
+simd_target_int64 inline_ vec_int64
+simd_load_int64(const int64* p)
+{
+  return _mm256_loadu_si256((const __m256i*)p);
+}
+
+simd_target_int64 inline_ void
+simd_store_int64(int64* p, vec_int64 x)
+{
+  _mm256_storeu_si256((__m256i*)p, x);
+}
+
+simd_target_int64 inline_ vec_int64
+simd_add_int64(vec_int64 x, vec_int64 y)
+{
+  return _mm256_add_epi64(x, y);
+}
+
+simd_target_int64 inline_ vec_int64
+simd_sub_int64(vec_int64 x, vec_int64 y)
+{
+  return _mm256_sub_epi64(x, y);
+}
+
+/* arithmetic shift right by one bit (AVX2 lacks 64-bit arithmetic shifts) */
+simd_target_int64 inline_ vec_int64
+simd_shr_int64(vec_int64 x)
+{
+  __m256i sign = _mm256_slli_epi64(_mm256_set1_epi32(-1), 63);
+  return _mm256_or_si256(_mm256_srli_epi64(x, 1), _mm256_and_si256(x, sign));
+}
+
+/* transpose 4x4 matrix whose rows are v[0], ..., v[3] */
+simd_target_int64 inline_ void
+simd_transpose_int64(vec_int64* v)
+{
+  __m256i t0 = _mm256_unpacklo_epi64(v[0], v[1]);
+  __m256i t1 = _mm256_unpackhi_epi64(v[0], v[1]);
+  __m256i t2 = _mm256_unpacklo_epi64(v[2], v[3]);
+  __m256i t3 = _mm256_unpackhi_epi64(v[2], v[3]);
+  v[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+  v[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+  v[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+  v[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+#endif
+
+#endif
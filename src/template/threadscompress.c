@@ -0,0 +1,48 @@
+/* compress 1d contiguous array in parallel via thread pool */
+static void
+_t2(compress_threads, Scalar, 1)(zfp_stream* stream, const zfp_field* field)
+{
+  size_t blocks = (field->nx + 3) / 4;
+  compress_chunks_threads(stream, field, blocks, _t2(compress_chunk, Scalar, 1));
+}
+
+/* compress 1d strided array in parallel via thread pool */
+static void
+_t2(compress_strided_threads, Scalar, 1)(zfp_stream* stream, const zfp_field* field)
+{
+  size_t blocks = (field->nx + 3) / 4;
+  compress_chunks_threads(stream, field, blocks, _t2(compress_chunk_strided, Scalar, 1));
+}
+
+/* compress 2d strided array in parallel via thread pool */
+static void
+_t2(compress_strided_threads, Scalar, 2)(zfp_stream* stream, const zfp_field* field)
+{
+  size_t bx = (field->nx + 3) / 4;
+  size_t by = (field->ny + 3) / 4;
+  size_t blocks = bx * by;
+  compress_chunks_threads(stream, field, blocks, _t2(compress_chunk_strided, Scalar, 2));
+}
+
+/* compress 3d strided array in parallel via thread pool */
+static void
+_t2(compress_strided_threads, Scalar, 3)(zfp_stream* stream, const zfp_field* field)
+{
+  size_t bx = (field->nx + 3) / 4;
+  size_t by = (field->ny + 3) / 4;
+  size_t bz = (field->nz + 3) / 4;
+  size_t blocks = bx * by * bz;
+  compress_chunks_threads(stream, field, blocks, _t2(compress_chunk_strided, Scalar, 3));
+}
+
+/* compress 4d strided array in parallel via thread pool */
+static void
+_t2(compress_strided_threads, Scalar, 4)(zfp_stream* stream, const zfp_field* field)
+{
+  size_t bx = (field->nx + 3) / 4;
+  size_t by = (field->ny + 3) / 4;
+  size_t bz = (field->nz + 3) / 4;
+  size_t bw = (field->nw + 3) / 4;
+  size_t blocks = bx * by * bz * bw;
+  compress_chunks_threads(stream, field, blocks, _t2(compress_chunk_strided, Scalar, 4));
+}
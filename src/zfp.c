@@ -2,6 +2,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "zfp.h"
 #include "zfp/internal/zfp/macros.h"
 #include "zfp/version.h"
@@ -44,17 +45,63 @@ is_reversible(const zfp_stream* zfp)
   return zfp->minexp < ZFP_MIN_EXP;
 }
 
+/* extended header format */
+#define HEADER_EXT_VERSION     0x80u /* added to codec version in magic */
+#define HEADER_EXT_INFO        0x10u /* stride hints and index location follow */
+#define HEADER_EXT_CHUNK_INDEX 0x20u /* stream embeds chunk index */
+#define HEADER_CHECKSUM_INIT   0x811c9dc5u /* FNV-1a offset basis */
+
+/* update header checksum with 64-bit value */
+static uint32
+header_checksum(uint32 sum, uint64 value)
+{
+  sum = (sum ^ (uint32)value) * 0x01000193u;
+  sum = (sum ^ (uint32)(value >> 32)) * 0x01000193u;
+  return sum;
+}
+
+/* write n-bit header value and update checksum */
+static size_t
+write_header_value(bitstream* stream, uint64 value, uint n, uint32* sum)
+{
+  stream_write_bits(stream, value, n);
+  *sum = header_checksum(*sum, value);
+  return n;
+}
+
+/* read n-bit header value and update checksum */
+static size_t
+read_header_value(bitstream* stream, uint64* value, uint n, uint32* sum)
+{
+  *value = stream_read_bits(stream, n);
+  *sum = header_checksum(*sum, *value);
+  return n;
+}
+
 /* shared code across template instances ------------------------------------*/
 
 #include "share/parallel.c"
 #include "share/omp.c"
+#include "share/threads.c"
+#include "share/index.c"
+#include "share/slab.c"
+#include "share/blocks.c"
+#include "share/estimate.c"
 
 /* template instantiation of integer and float compressor -------------------*/
 
 #define Scalar int32
 #include "template/compress.c"
 #include "template/decompress.c"
+#include "template/parcompress.c"
+#include "template/pardecompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadscompress.c"
+#include "template/threadsdecompress.c"
+#include "template/compressblocks.c"
+#include "template/decompressblocks.c"
+#include "template/decompressbox.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
 #undef Scalar
@@ -62,7 +109,15 @@ is_reversible(const zfp_stream* zfp)
 #define Scalar int64
 #include "template/compress.c"
 #include "template/decompress.c"
+#include "template/parcompress.c"
+#include "template/pardecompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadscompress.c"
+#include "template/threadsdecompress.c"
+#include "template/compressblocks.c"
+#include "template/decompressblocks.c"
+#include "template/decompressbox.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
 #undef Scalar
@@ -70,7 +125,15 @@ is_reversible(const zfp_stream* zfp)
 #define Scalar float
 #include "template/compress.c"
 #include "template/decompress.c"
+#include "template/parcompress.c"
+#include "template/pardecompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadscompress.c"
+#include "template/threadsdecompress.c"
+#include "template/compressblocks.c"
+#include "template/decompressblocks.c"
+#include "template/decompressbox.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
 #undef Scalar
@@ -78,7 +141,15 @@ is_reversible(const zfp_stream* zfp)
 #define Scalar double
 #include "template/compress.c"
 #include "template/decompress.c"
+#include "template/parcompress.c"
+#include "template/pardecompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadscompress.c"
+#include "template/threadsdecompress.c"
+#include "template/compressblocks.c"
+#include "template/decompressblocks.c"
+#include "template/decompressbox.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
 #undef Scalar
@@ -545,6 +616,9 @@ zfp_stream_open(bitstream* stream)
     zfp->minexp = ZFP_MIN_EXP;
     zfp->exec.policy = zfp_exec_serial;
     zfp->exec.params = NULL;
+    zfp->chunk_index = zfp_false;
+    zfp->index = NULL;
+    zfp->slab = NULL;
   }
   return zfp;
 }
@@ -554,6 +628,7 @@ zfp_stream_close(zfp_stream* zfp)
 {
   if (zfp->exec.params != NULL)
     free(zfp->exec.params);
+  free(zfp->slab);
   free(zfp);
 }
 
@@ -716,6 +791,7 @@ zfp_stream_maximum_size(const zfp_stream* zfp, const zfp_field* field)
   size_t blocks = zfp_field_blocks(field);
   uint values = 1u << (2 * dims);
   uint maxbits = 0;
+  bitstream_size bits = 0;
 
   if (!dims)
     return 0;
@@ -738,7 +814,67 @@ zfp_stream_maximum_size(const zfp_stream* zfp, const zfp_field* field)
   maxbits += values - 1 + values * MIN(zfp->maxprec, zfp_field_precision(field));
   maxbits = MIN(maxbits, zfp->maxbits);
   maxbits = MAX(maxbits, zfp->minbits);
-  return ((ZFP_HEADER_MAX_BITS + blocks * maxbits + stream_word_bits - 1) & ~(stream_word_bits - 1)) / CHAR_BIT;
+  if (zfp->chunk_index) {
+    /* account for one index entry per chunk */
+    bits += chunk_index_bits(chunk_count(zfp, blocks));
+  }
+  bits += ZFP_HEADER_MAX_BITS + (bitstream_size)blocks * maxbits;
+  return (size_t)(((bits + stream_word_bits - 1) & ~(stream_word_bits - 1)) / CHAR_BIT);
+}
+
+size_t
+zfp_compressed_size_estimate(const zfp_stream* zfp, const zfp_field* field, double sample_fraction)
+{
+  /* function table [strided][dimensionality][scalar type] */
+  void (*ftable[2][4][4])(zfp_stream*, const zfp_field*, size_t, size_t) = {
+    {{ compress_chunk_int32_1,         compress_chunk_int64_1,         compress_chunk_float_1,         compress_chunk_double_1 },
+     { compress_chunk_strided_int32_2, compress_chunk_strided_int64_2, compress_chunk_strided_float_2, compress_chunk_strided_double_2 },
+     { compress_chunk_strided_int32_3, compress_chunk_strided_int64_3, compress_chunk_strided_float_3, compress_chunk_strided_double_3 },
+     { compress_chunk_strided_int32_4, compress_chunk_strided_int64_4, compress_chunk_strided_float_4, compress_chunk_strided_double_4 }},
+    {{ compress_chunk_strided_int32_1, compress_chunk_strided_int64_1, compress_chunk_strided_float_1, compress_chunk_strided_double_1 },
+     { compress_chunk_strided_int32_2, compress_chunk_strided_int64_2, compress_chunk_strided_float_2, compress_chunk_strided_double_2 },
+     { compress_chunk_strided_int32_3, compress_chunk_strided_int64_3, compress_chunk_strided_float_3, compress_chunk_strided_double_3 },
+     { compress_chunk_strided_int32_4, compress_chunk_strided_int64_4, compress_chunk_strided_float_4, compress_chunk_strided_double_4 }},
+  };
+  uint strided = (uint)zfp_field_stride(field, NULL);
+  uint dims = zfp_field_dimensionality(field);
+  uint type = field->type;
+  size_t blocks = zfp_field_blocks(field);
+  bitstream_size bits = 0;
+
+  switch (type) {
+    case zfp_type_int32:
+    case zfp_type_int64:
+    case zfp_type_float:
+    case zfp_type_double:
+      break;
+    default:
+      return 0;
+  }
+  if (!dims || !(sample_fraction > 0))
+    return 0;
+
+  if (zfp->minbits == zfp->maxbits) {
+    /* in fixed-rate mode, every block occupies maxbits bits */
+    bits = (bitstream_size)blocks * zfp->maxbits;
+  }
+  else {
+    /* encode all or a sample of the blocks without retaining output */
+    size_t samples = blocks;
+    if (sample_fraction < 1) {
+      samples = (size_t)(sample_fraction * (double)blocks + 0.5);
+      samples = MAX(samples, 1);
+      samples = MIN(samples, blocks);
+    }
+    if (!estimate_bits(zfp, field, samples, &bits, ftable[strided][dims - 1][type - zfp_type_int32]))
+      return 0;
+  }
+
+  /* account for chunk index, if any */
+  if (zfp->chunk_index)
+    bits += (bitstream_size)CHUNK_INDEX_BITS * (1 + chunk_count(zfp, blocks));
+
+  return (size_t)(((bits + stream_word_bits - 1) & ~(stream_word_bits - 1)) / CHAR_BIT);
 }
 
 void
@@ -914,6 +1050,38 @@ zfp_stream_omp_chunk_size(const zfp_stream* zfp)
   return 0u;
 }
 
+zfp_bool
+zfp_stream_omp_zero_copy(const zfp_stream* zfp)
+{
+  if (zfp->exec.policy == zfp_exec_omp)
+    return ((zfp_exec_params_omp*)zfp->exec.params)->zero_copy;
+  return zfp_false;
+}
+
+zfp_bool
+zfp_stream_omp_dynamic(const zfp_stream* zfp)
+{
+  if (zfp->exec.policy == zfp_exec_omp)
+    return ((zfp_exec_params_omp*)zfp->exec.params)->dynamic;
+  return zfp_false;
+}
+
+uint
+zfp_stream_thread_count(const zfp_stream* zfp)
+{
+  if (zfp->exec.policy == zfp_exec_threads)
+    return ((zfp_exec_params_threads*)zfp->exec.params)->threads;
+  return 0u;
+}
+
+uint
+zfp_stream_thread_chunk_size(const zfp_stream* zfp)
+{
+  if (zfp->exec.policy == zfp_exec_threads)
+    return ((zfp_exec_params_threads*)zfp->exec.params)->chunk_size;
+  return 0u;
+}
+
 zfp_bool
 zfp_stream_set_execution(zfp_stream* zfp, zfp_exec_policy policy)
 {
@@ -941,12 +1109,30 @@ zfp_stream_set_execution(zfp_stream* zfp, zfp_exec_policy policy)
         zfp_exec_params_omp* params = malloc(sizeof(zfp_exec_params_omp));
         params->threads = 0;
         params->chunk_size = 0;
+        params->zero_copy = zfp_false;
+        params->dynamic = zfp_false;
+        params->timings = NULL;
+        params->timing_count = 0;
         zfp->exec.params = params;
       }
       break;
 #else
       return zfp_false;
 #endif
+    case zfp_exec_threads:
+      if (zfp->exec.policy != policy) {
+        zfp_exec_params_threads* params = malloc(sizeof(zfp_exec_params_threads));
+        if (!params)
+          return zfp_false;
+        params->threads = 0;
+        params->chunk_size = 0;
+        params->parallel_for = NULL;
+        params->context = NULL;
+        if (zfp->exec.params != NULL)
+          free(zfp->exec.params);
+        zfp->exec.params = params;
+      }
+      break;
     default:
       return zfp_false;
   }
@@ -972,6 +1158,234 @@ zfp_stream_set_omp_chunk_size(zfp_stream* zfp, uint chunk_size)
   return zfp_true;
 }
 
+zfp_bool
+zfp_stream_set_omp_zero_copy(zfp_stream* zfp, zfp_bool zero_copy)
+{
+  if (!zfp_stream_set_execution(zfp, zfp_exec_omp))
+    return zfp_false;
+  ((zfp_exec_params_omp*)zfp->exec.params)->zero_copy = zero_copy;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_set_omp_dynamic(zfp_stream* zfp, zfp_bool dynamic)
+{
+  if (!zfp_stream_set_execution(zfp, zfp_exec_omp))
+    return zfp_false;
+  ((zfp_exec_params_omp*)zfp->exec.params)->dynamic = dynamic;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_set_omp_timings(zfp_stream* zfp, double* timings, size_t count)
+{
+  zfp_exec_params_omp* params;
+  if (!zfp_stream_set_execution(zfp, zfp_exec_omp))
+    return zfp_false;
+  params = (zfp_exec_params_omp*)zfp->exec.params;
+  params->timings = timings;
+  params->timing_count = timings ? count : 0;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_set_thread_count(zfp_stream* zfp, uint threads)
+{
+  if (!zfp_stream_set_execution(zfp, zfp_exec_threads))
+    return zfp_false;
+  ((zfp_exec_params_threads*)zfp->exec.params)->threads = threads;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_set_thread_chunk_size(zfp_stream* zfp, uint chunk_size)
+{
+  if (!zfp_stream_set_execution(zfp, zfp_exec_threads))
+    return zfp_false;
+  ((zfp_exec_params_threads*)zfp->exec.params)->chunk_size = chunk_size;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_set_thread_scheduler(zfp_stream* zfp, zfp_parallel_for parallel_for, void* context)
+{
+  zfp_exec_params_threads* params;
+  if (!zfp_stream_set_execution(zfp, zfp_exec_threads))
+    return zfp_false;
+  params = (zfp_exec_params_threads*)zfp->exec.params;
+  params->parallel_for = parallel_for;
+  params->context = context;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_chunk_index(const zfp_stream* zfp)
+{
+  return zfp->chunk_index;
+}
+
+void
+zfp_stream_set_chunk_index(zfp_stream* zfp, zfp_bool enable)
+{
+  zfp->chunk_index = enable;
+}
+
+zfp_index*
+zfp_stream_index(const zfp_stream* zfp)
+{
+  return zfp->index;
+}
+
+void
+zfp_stream_set_index(zfp_stream* zfp, zfp_index* index)
+{
+  zfp->index = index;
+}
+
+/* public functions: block index ------------------------------------------- */
+
+zfp_index*
+zfp_index_create(zfp_index_type type)
+{
+  zfp_index* index;
+
+  switch (type) {
+    case zfp_index_verbatim:
+    case zfp_index_hybrid4:
+    case zfp_index_hybrid8:
+      break;
+    default:
+      return NULL;
+  }
+
+  index = malloc(sizeof(zfp_index));
+  if (index) {
+    index->type = type;
+    index->nx = index->ny = index->nz = index->nw = 0;
+    index->blocks = 0;
+    index->end = 0;
+    index->data = NULL;
+    index->size = NULL;
+    index->compress = NULL;
+  }
+  return index;
+}
+
+void
+zfp_index_free(zfp_index* index)
+{
+  if (index) {
+    free(index->data);
+    free(index->size);
+    free(index);
+  }
+}
+
+size_t
+zfp_index_size(const zfp_index* index)
+{
+  bitstream_size bits;
+  if (!index->blocks)
+    return 0;
+  /* round up to whole number of words */
+  bits = INDEX_HEADER_BITS + index_data_bits(index->type, index->blocks);
+  bits = (bits + stream_word_bits - 1) / stream_word_bits * stream_word_bits;
+  return (size_t)(bits / CHAR_BIT);
+}
+
+size_t
+zfp_index_write(const zfp_index* index, void* buffer, size_t size)
+{
+  size_t bytes = zfp_index_size(index);
+  bitstream* stream;
+  size_t i, n;
+
+  if (!bytes || size < bytes)
+    return 0;
+  stream = stream_open(buffer, size);
+  if (!stream)
+    return 0;
+
+  /* header: magic and encoding, field dimensions, and range of offsets */
+  stream_write_bits(stream, (INDEX_MAGIC << 8) + (uint64)index->type, 64);
+  stream_write_bits(stream, index->nx, 64);
+  stream_write_bits(stream, index->ny, 64);
+  stream_write_bits(stream, index->nz, 64);
+  stream_write_bits(stream, index->nw, 64);
+  stream_write_bits(stream, index->end, 64);
+
+  /* encoded block offsets */
+  switch (index->type) {
+    case zfp_index_hybrid4:
+      n = (size_t)(index_data_bits(index->type, index->blocks) / 32);
+      for (i = 0; i < n; i++)
+        stream_write_bits(stream, ((const uint32*)index->data)[i], 32);
+      break;
+    default:
+      n = (size_t)(index_data_bits(index->type, index->blocks) / 64);
+      for (i = 0; i < n; i++)
+        stream_write_bits(stream, ((const uint64*)index->data)[i], 64);
+      break;
+  }
+
+  stream_flush(stream);
+  stream_close(stream);
+
+  return bytes;
+}
+
+zfp_index*
+zfp_index_read(const void* buffer, size_t size)
+{
+  zfp_index* index = NULL;
+  bitstream* stream;
+  uint64 magic;
+  size_t i, n;
+
+  if (size < INDEX_HEADER_BITS / CHAR_BIT)
+    return NULL;
+  stream = stream_open((void*)buffer, size);
+  if (!stream)
+    return NULL;
+
+  /* validate header and allocate index */
+  magic = stream_read_bits(stream, 64);
+  if ((magic >> 8) == INDEX_MAGIC)
+    index = zfp_index_create((zfp_index_type)(magic & 0xffu));
+  if (index) {
+    zfp_field field;
+    field.nx = index->nx = (size_t)stream_read_bits(stream, 64);
+    field.ny = index->ny = (size_t)stream_read_bits(stream, 64);
+    field.nz = index->nz = (size_t)stream_read_bits(stream, 64);
+    field.nw = index->nw = (size_t)stream_read_bits(stream, 64);
+    index->end = stream_read_bits(stream, 64);
+    index->blocks = zfp_field_blocks(&field);
+    if (!index->blocks || zfp_index_size(index) > size || !index_alloc(index)) {
+      zfp_index_free(index);
+      index = NULL;
+    }
+  }
+
+  /* encoded block offsets */
+  if (index)
+    switch (index->type) {
+      case zfp_index_hybrid4:
+        n = (size_t)(index_data_bits(index->type, index->blocks) / 32);
+        for (i = 0; i < n; i++)
+          ((uint32*)index->data)[i] = (uint32)stream_read_bits(stream, 32);
+        break;
+      default:
+        n = (size_t)(index_data_bits(index->type, index->blocks) / 64);
+        for (i = 0; i < n; i++)
+          ((uint64*)index->data)[i] = stream_read_bits(stream, 64);
+        break;
+    }
+
+  stream_close(stream);
+
+  return index;
+}
+
 /* public functions: utility functions --------------------------------------*/
 
 void
@@ -1052,7 +1466,7 @@ size_t
 zfp_compress(zfp_stream* zfp, const zfp_field* field)
 {
   /* function table [execution][strided][dimensionality][scalar type] */
-  void (*ftable[3][2][4][4])(zfp_stream*, const zfp_field*) = {
+  void (*ftable[4][2][4][4])(zfp_stream*, const zfp_field*) = {
     /* serial */
     {{{ compress_int32_1,         compress_int64_1,         compress_float_1,         compress_double_1 },
       { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2 },
@@ -1090,6 +1504,27 @@ zfp_compress(zfp_stream* zfp, const zfp_field* field)
 #else
     {{{ NULL }}},
 #endif
+
+    /* thread pool */
+    {{{ compress_threads_int32_1,         compress_threads_int64_1,         compress_threads_float_1,         compress_threads_double_1 },
+      { compress_strided_threads_int32_2, compress_strided_threads_int64_2, compress_strided_threads_float_2, compress_strided_threads_double_2 },
+      { compress_strided_threads_int32_3, compress_strided_threads_int64_3, compress_strided_threads_float_3, compress_strided_threads_double_3 },
+      { compress_strided_threads_int32_4, compress_strided_threads_int64_4, compress_strided_threads_float_4, compress_strided_threads_double_4 }},
+     {{ compress_strided_threads_int32_1, compress_strided_threads_int64_1, compress_strided_threads_float_1, compress_strided_threads_double_1 },
+      { compress_strided_threads_int32_2, compress_strided_threads_int64_2, compress_strided_threads_float_2, compress_strided_threads_double_2 },
+      { compress_strided_threads_int32_3, compress_strided_threads_int64_3, compress_strided_threads_float_3, compress_strided_threads_double_3 },
+      { compress_strided_threads_int32_4, compress_strided_threads_int64_4, compress_strided_threads_float_4, compress_strided_threads_double_4 }}},
+  };
+  /* function table for indexed compression [strided][dimensionality][scalar type] */
+  void (*ctable[2][4][4])(zfp_stream*, const zfp_field*, size_t, size_t) = {
+    {{ compress_chunk_int32_1,         compress_chunk_int64_1,         compress_chunk_float_1,         compress_chunk_double_1 },
+     { compress_chunk_strided_int32_2, compress_chunk_strided_int64_2, compress_chunk_strided_float_2, compress_chunk_strided_double_2 },
+     { compress_chunk_strided_int32_3, compress_chunk_strided_int64_3, compress_chunk_strided_float_3, compress_chunk_strided_double_3 },
+     { compress_chunk_strided_int32_4, compress_chunk_strided_int64_4, compress_chunk_strided_float_4, compress_chunk_strided_double_4 }},
+    {{ compress_chunk_strided_int32_1, compress_chunk_strided_int64_1, compress_chunk_strided_float_1, compress_chunk_strided_double_1 },
+     { compress_chunk_strided_int32_2, compress_chunk_strided_int64_2, compress_chunk_strided_float_2, compress_chunk_strided_double_2 },
+     { compress_chunk_strided_int32_3, compress_chunk_strided_int64_3, compress_chunk_strided_float_3, compress_chunk_strided_double_3 },
+     { compress_chunk_strided_int32_4, compress_chunk_strided_int64_4, compress_chunk_strided_float_4, compress_chunk_strided_double_4 }},
   };
   uint exec = zfp->exec.policy;
   uint strided = (uint)zfp_field_stride(field, NULL);
@@ -1112,8 +1547,40 @@ zfp_compress(zfp_stream* zfp, const zfp_field* field)
   if (!compress)
     return 0;
 
+  /* build block index, recording the size of each block as it is compressed */
+  if (zfp->index) {
+    if (exec == zfp_exec_cuda || !index_begin(zfp->index, field, ctable[strided][dims - 1][type - zfp_type_int32]))
+      return 0;
+    compress_blocks(zfp, field, zfp->index->blocks, index_compress_chunk);
+    stream_flush(zfp->stream);
+    return index_end(zfp->index) ? stream_size(zfp->stream) : 0;
+  }
+
   /* compress field and align bit stream on word boundary */
-  compress(zfp, field);
+  switch (exec) {
+    case zfp_exec_serial:
+      if (zfp->chunk_index) {
+        /* serial compression produces a single chunk */
+        bitstream_offset offset = chunk_index_reserve(zfp->stream, 1);
+        bitstream* index;
+        compress(zfp, field);
+        index = chunk_index_open(zfp->stream, offset, 1);
+        chunk_index_write(index, stream_wtell(zfp->stream) - offset);
+        chunk_index_close(index);
+      }
+      else
+        compress(zfp, field);
+      break;
+    case zfp_exec_cuda:
+      /* chunk index is not supported by CUDA */
+      if (zfp->chunk_index)
+        return 0;
+      compress(zfp, field);
+      break;
+    default:
+      compress(zfp, field);
+      break;
+  }
   stream_flush(zfp->stream);
 
   return stream_size(zfp->stream);
@@ -1123,7 +1590,7 @@ size_t
 zfp_decompress(zfp_stream* zfp, zfp_field* field)
 {
   /* function table [execution][strided][dimensionality][scalar type] */
-  void (*ftable[3][2][4][4])(zfp_stream*, zfp_field*) = {
+  void (*ftable[4][2][4][4])(zfp_stream*, zfp_field*) = {
     /* serial */
     {{{ decompress_int32_1,         decompress_int64_1,         decompress_float_1,         decompress_double_1 },
       { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2 },
@@ -1134,8 +1601,19 @@ zfp_decompress(zfp_stream* zfp, zfp_field* field)
       { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3 },
       { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4 }}},
 
-    /* OpenMP; not yet supported */
+    /* OpenMP */
+#ifdef _OPENMP
+    {{{ decompress_omp_int32_1,         decompress_omp_int64_1,         decompress_omp_float_1,         decompress_omp_double_1 },
+      { decompress_strided_omp_int32_2, decompress_strided_omp_int64_2, decompress_strided_omp_float_2, decompress_strided_omp_double_2 },
+      { decompress_strided_omp_int32_3, decompress_strided_omp_int64_3, decompress_strided_omp_float_3, decompress_strided_omp_double_3 },
+      { decompress_strided_omp_int32_4, decompress_strided_omp_int64_4, decompress_strided_omp_float_4, decompress_strided_omp_double_4 }},
+     {{ decompress_strided_omp_int32_1, decompress_strided_omp_int64_1, decompress_strided_omp_float_1, decompress_strided_omp_double_1 },
+      { decompress_strided_omp_int32_2, decompress_strided_omp_int64_2, decompress_strided_omp_float_2, decompress_strided_omp_double_2 },
+      { decompress_strided_omp_int32_3, decompress_strided_omp_int64_3, decompress_strided_omp_float_3, decompress_strided_omp_double_3 },
+      { decompress_strided_omp_int32_4, decompress_strided_omp_int64_4, decompress_strided_omp_float_4, decompress_strided_omp_double_4 }}},
+#else
     {{{ NULL }}},
+#endif
 
     /* CUDA */
 #ifdef ZFP_WITH_CUDA
@@ -1150,6 +1628,16 @@ zfp_decompress(zfp_stream* zfp, zfp_field* field)
 #else
     {{{ NULL }}},
 #endif
+
+    /* thread pool */
+    {{{ decompress_threads_int32_1,         decompress_threads_int64_1,         decompress_threads_float_1,         decompress_threads_double_1 },
+      { decompress_strided_threads_int32_2, decompress_strided_threads_int64_2, decompress_strided_threads_float_2, decompress_strided_threads_double_2 },
+      { decompress_strided_threads_int32_3, decompress_strided_threads_int64_3, decompress_strided_threads_float_3, decompress_strided_threads_double_3 },
+      { decompress_strided_threads_int32_4, decompress_strided_threads_int64_4, decompress_strided_threads_float_4, decompress_strided_threads_double_4 }},
+     {{ decompress_strided_threads_int32_1, decompress_strided_threads_int64_1, decompress_strided_threads_float_1, decompress_strided_threads_double_1 },
+      { decompress_strided_threads_int32_2, decompress_strided_threads_int64_2, decompress_strided_threads_float_2, decompress_strided_threads_double_2 },
+      { decompress_strided_threads_int32_3, decompress_strided_threads_int64_3, decompress_strided_threads_float_3, decompress_strided_threads_double_3 },
+      { decompress_strided_threads_int32_4, decompress_strided_threads_int64_4, decompress_strided_threads_float_4, decompress_strided_threads_double_4 }}},
   };
   uint exec = zfp->exec.policy;
   uint strided = (uint)zfp_field_stride(field, NULL);
@@ -1172,21 +1660,301 @@ zfp_decompress(zfp_stream* zfp, zfp_field* field)
   if (!decompress)
     return 0;
 
+  /* return 0 if chunk index is corrupt */
+  if (zfp->chunk_index && !chunk_index_valid(zfp->stream, zfp_field_blocks(field)))
+    return 0;
+
   /* decompress field and align bit stream on word boundary */
+  switch (exec) {
+    case zfp_exec_serial:
+      /* chunks are contiguous; skip index */
+      if (zfp->chunk_index)
+        chunk_index_skip(zfp->stream, zfp_field_blocks(field));
+      break;
+    case zfp_exec_cuda:
+      /* chunk index is not supported by CUDA */
+      if (zfp->chunk_index)
+        return 0;
+      break;
+    default:
+      break;
+  }
   decompress(zfp, field);
   stream_align(zfp->stream);
 
   return stream_size(zfp->stream);
 }
 
+zfp_bool
+zfp_stream_begin(zfp_stream* zfp, const zfp_field* field)
+{
+  /* function table [strided][dimensionality][scalar type] */
+  void (*ftable[2][4][4])(zfp_stream*, const zfp_field*, size_t, size_t) = {
+    {{ compress_chunk_int32_1,         compress_chunk_int64_1,         compress_chunk_float_1,         compress_chunk_double_1 },
+     { compress_chunk_strided_int32_2, compress_chunk_strided_int64_2, compress_chunk_strided_float_2, compress_chunk_strided_double_2 },
+     { compress_chunk_strided_int32_3, compress_chunk_strided_int64_3, compress_chunk_strided_float_3, compress_chunk_strided_double_3 },
+     { compress_chunk_strided_int32_4, compress_chunk_strided_int64_4, compress_chunk_strided_float_4, compress_chunk_strided_double_4 }},
+    {{ compress_chunk_strided_int32_1, compress_chunk_strided_int64_1, compress_chunk_strided_float_1, compress_chunk_strided_double_1 },
+     { compress_chunk_strided_int32_2, compress_chunk_strided_int64_2, compress_chunk_strided_float_2, compress_chunk_strided_double_2 },
+     { compress_chunk_strided_int32_3, compress_chunk_strided_int64_3, compress_chunk_strided_float_3, compress_chunk_strided_double_3 },
+     { compress_chunk_strided_int32_4, compress_chunk_strided_int64_4, compress_chunk_strided_float_4, compress_chunk_strided_double_4 }},
+  };
+  uint strided = (uint)zfp_field_stride(field, NULL);
+  uint dims = zfp_field_dimensionality(field);
+  uint type = field->type;
+  slab_state* state;
+
+  switch (type) {
+    case zfp_type_int32:
+    case zfp_type_int64:
+    case zfp_type_float:
+    case zfp_type_double:
+      break;
+    default:
+      return zfp_false;
+  }
+  if (!dims)
+    return zfp_false;
+
+  /* slabs are compressed in parallel only when no chunk index is embedded */
+  switch (zfp->exec.policy) {
+    case zfp_exec_serial:
+      break;
+#ifdef _OPENMP
+    case zfp_exec_omp:
+#endif
+    case zfp_exec_threads:
+      if (zfp->chunk_index)
+        return zfp_false;
+      break;
+    default:
+      return zfp_false;
+  }
+
+  /* block index is not supported */
+  if (zfp->index)
+    return zfp_false;
+
+  state = malloc(sizeof(slab_state));
+  if (!state)
+    return zfp_false;
+  state->field = *field;
+  state->field.data = NULL;
+  state->size = dims == 1 ? field->nx : dims == 2 ? field->ny : dims == 3 ? field->nz : field->nw;
+  state->next = 0;
+  state->compress = ftable[strided][dims - 1][type - zfp_type_int32];
+
+  /* serial compression produces a single chunk */
+  state->offset = zfp->chunk_index ? chunk_index_reserve(zfp->stream, 1) : stream_wtell(zfp->stream);
+
+  free(zfp->slab);
+  zfp->slab = state;
+
+  return zfp_true;
+}
+
+size_t
+zfp_stream_append_slab(zfp_stream* zfp, const void* data, size_t n)
+{
+  slab_state* state = (slab_state*)zfp->slab;
+  bitstream_offset offset;
+  zfp_field field;
+
+  /* slab must be nonempty, fit in field, and consist of whole blocks unless last */
+  if (!state || !n || n > state->size - state->next)
+    return 0;
+  if (n % 4 && state->next + n != state->size)
+    return 0;
+
+  /* compress slab */
+  offset = stream_wtell(zfp->stream);
+  slab_field(&field, state, data, n);
+  slab_compress(zfp, &field, state->compress);
+  state->next += n;
+
+  return (size_t)(stream_wtell(zfp->stream) - offset);
+}
+
+size_t
+zfp_stream_end(zfp_stream* zfp)
+{
+  slab_state* state = (slab_state*)zfp->slab;
+  zfp_bool complete;
+
+  if (!state)
+    return 0;
+
+  /* record size of single chunk */
+  complete = (state->next == state->size);
+  if (complete && zfp->chunk_index) {
+    bitstream* index = chunk_index_open(zfp->stream, state->offset, 1);
+    chunk_index_write(index, stream_wtell(zfp->stream) - state->offset);
+    chunk_index_close(index);
+  }
+
+  free(state);
+  zfp->slab = NULL;
+  if (!complete)
+    return 0;
+
+  /* align bit stream on word boundary */
+  stream_flush(zfp->stream);
+
+  return stream_size(zfp->stream);
+}
+
+size_t
+zfp_decompress_box(zfp_stream* zfp, const zfp_index* index, zfp_field* field, size_t x0, size_t y0, size_t z0, size_t w0)
+{
+  /* function table [scalar type] */
+  size_t (*ftable[4])(zfp_stream*, const zfp_index*, zfp_field*, const size_t*) = {
+    decompress_box_int32,
+    decompress_box_int64,
+    decompress_box_float,
+    decompress_box_double,
+  };
+  size_t origin[4];
+  bitstream_offset base;
+  size_t bits;
+
+  switch (field->type) {
+    case zfp_type_int32:
+    case zfp_type_int64:
+    case zfp_type_float:
+    case zfp_type_double:
+      break;
+    default:
+      return 0;
+  }
+
+  /* return 0 if box is not contained in indexed field */
+  if (!index_covers(index, field, x0, y0, z0, w0))
+    return 0;
+
+  /* blocks are located relative to first block following chunk index */
+  if (zfp->chunk_index && !chunk_index_skip(zfp->stream, index->blocks))
+    return 0;
+  base = stream_rtell(zfp->stream);
+
+  /* decompress overlapping blocks and advance stream past last block */
+  origin[0] = x0;
+  origin[1] = y0;
+  origin[2] = z0;
+  origin[3] = w0;
+  bits = ftable[field->type - zfp_type_int32](zfp, index, field, origin);
+  stream_rseek(zfp->stream, base + index->end);
+  stream_align(zfp->stream);
+
+  return bits;
+}
+
+size_t
+zfp_compress_blocks(zfp_stream* zfp, zfp_type type, uint dims, const void* blocks, size_t count)
+{
+  void (*ftable[4])(zfp_stream*, const zfp_field*, size_t, size_t) = {
+    compress_blocks_chunk_int32,
+    compress_blocks_chunk_int64,
+    compress_blocks_chunk_float,
+    compress_blocks_chunk_double,
+  };
+  zfp_field field;
+
+  if (!blocks_field(&field, type, dims, (void*)blocks, count))
+    return 0;
+
+  return compress_blocks(zfp, &field, count, ftable[type - zfp_type_int32]);
+}
+
+size_t
+zfp_compress_blocks_indirect(zfp_stream* zfp, zfp_type type, uint dims, const void* const* block, size_t count)
+{
+  void (*ftable[4])(zfp_stream*, const zfp_field*, size_t, size_t) = {
+    compress_blocks_indirect_chunk_int32,
+    compress_blocks_indirect_chunk_int64,
+    compress_blocks_indirect_chunk_float,
+    compress_blocks_indirect_chunk_double,
+  };
+  zfp_field field;
+
+  /* field data holds block addresses rather than values */
+  if (!blocks_field(&field, type, dims, (void*)block, count))
+    return 0;
+
+  return compress_blocks(zfp, &field, count, ftable[type - zfp_type_int32]);
+}
+
+size_t
+zfp_decompress_blocks(zfp_stream* zfp, zfp_type type, uint dims, void* blocks, size_t count)
+{
+  void (*ftable[4])(zfp_stream*, zfp_field*, size_t, size_t) = {
+    decompress_blocks_chunk_int32,
+    decompress_blocks_chunk_int64,
+    decompress_blocks_chunk_float,
+    decompress_blocks_chunk_double,
+  };
+  zfp_field field;
+
+  if (!blocks_field(&field, type, dims, blocks, count))
+    return 0;
+
+  return decompress_blocks(zfp, &field, count, ftable[type - zfp_type_int32]);
+}
+
+size_t
+zfp_decompress_blocks_indirect(zfp_stream* zfp, zfp_type type, uint dims, void* const* block, size_t count)
+{
+  void (*ftable[4])(zfp_stream*, zfp_field*, size_t, size_t) = {
+    decompress_blocks_indirect_chunk_int32,
+    decompress_blocks_indirect_chunk_int64,
+    decompress_blocks_indirect_chunk_float,
+    decompress_blocks_indirect_chunk_double,
+  };
+  zfp_field field;
+
+  /* field data holds block addresses rather than values */
+  if (!blocks_field(&field, type, dims, (void*)block, count))
+    return 0;
+
+  return decompress_blocks(zfp, &field, count, ftable[type - zfp_type_int32]);
+}
+
 size_t
 zfp_write_header(zfp_stream* zfp, const zfp_field* field, uint mask)
+{
+  return zfp_write_header_ext(zfp, field, mask, NULL);
+}
+
+size_t
+zfp_read_header(zfp_stream* zfp, zfp_field* field, uint mask)
+{
+  return zfp_read_header_ext(zfp, field, mask, NULL);
+}
+
+size_t
+zfp_write_header_ext(zfp_stream* zfp, const zfp_field* field, uint mask, const zfp_header_ext* ext)
 {
   size_t bits = 0;
   uint64 meta = 0;
+  uint32 sum = HEADER_CHECKSUM_INIT;
+  uint dims = 0;
 
   /* first make sure field dimensions fit in header */
-  if (mask & ZFP_HEADER_META) {
+  if (mask & ZFP_HEADER_EXTENDED) {
+    /* extended metadata replaces 52-bit field metadata */
+    dims = zfp_field_dimensionality(field);
+    if (!(mask & ZFP_HEADER_META) || !dims ||
+        field->type < zfp_type_int32 || field->type > zfp_type_double)
+      return 0;
+    /* 8-bit scalar type, dimensionality, and flags */
+    meta = (uint64)(field->type - 1) + ((uint64)(dims - 1) << 2);
+    if (ext)
+      meta += HEADER_EXT_INFO;
+    if (zfp->chunk_index)
+      meta += HEADER_EXT_CHUNK_INDEX;
+  }
+  else if (ext)
+    return 0;
+  else if (mask & ZFP_HEADER_META) {
     meta = zfp_field_metadata(field);
     if (meta == ZFP_META_NULL)
       return 0;
@@ -1194,14 +1962,36 @@ zfp_write_header(zfp_stream* zfp, const zfp_field* field, uint mask)
 
   /* 32-bit magic */
   if (mask & ZFP_HEADER_MAGIC) {
-    stream_write_bits(zfp->stream, 'z', 8);
-    stream_write_bits(zfp->stream, 'f', 8);
-    stream_write_bits(zfp->stream, 'p', 8);
-    stream_write_bits(zfp->stream, zfp_codec_version, 8);
+    uint version = zfp_codec_version + (mask & ZFP_HEADER_EXTENDED ? HEADER_EXT_VERSION : 0);
+    uint64 magic = (uint64)'z' + ((uint64)'f' << 8) + ((uint64)'p' << 16) + ((uint64)version << 24);
+    stream_write_bits(zfp->stream, magic, ZFP_MAGIC_BITS);
+    sum = header_checksum(sum, magic);
     bits += ZFP_MAGIC_BITS;
   }
-  /* 52-bit field metadata */
-  if (mask & ZFP_HEADER_META) {
+  /* 52-bit or extended field metadata */
+  if (mask & ZFP_HEADER_EXTENDED) {
+    size_t n[4];
+    ptrdiff_t stride[4];
+    uint i;
+    n[0] = field->nx;
+    n[1] = field->ny;
+    n[2] = field->nz;
+    n[3] = field->nw;
+    bits += write_header_value(zfp->stream, meta, ZFP_META_EXT_BITS, &sum);
+    for (i = 0; i < dims; i++)
+      bits += write_header_value(zfp->stream, (uint64)n[i], 64, &sum);
+    if (ext) {
+      stride[0] = ext->sx;
+      stride[1] = ext->sy;
+      stride[2] = ext->sz;
+      stride[3] = ext->sw;
+      for (i = 0; i < dims; i++)
+        bits += write_header_value(zfp->stream, (uint64)stride[i], 64, &sum);
+      bits += write_header_value(zfp->stream, ext->index_offset, 64, &sum);
+      bits += write_header_value(zfp->stream, ext->index_size, 64, &sum);
+    }
+  }
+  else if (mask & ZFP_HEADER_META) {
     stream_write_bits(zfp->stream, meta, ZFP_META_BITS);
     bits += ZFP_META_BITS;
   }
@@ -1209,41 +1999,136 @@ zfp_write_header(zfp_stream* zfp, const zfp_field* field, uint mask)
   if (mask & ZFP_HEADER_MODE) {
     uint64 mode = zfp_stream_mode(zfp);
     uint size = mode > ZFP_MODE_SHORT_MAX ? ZFP_MODE_LONG_BITS : ZFP_MODE_SHORT_BITS;
-    stream_write_bits(zfp->stream, mode, size);
-    bits += size;
+    bits += write_header_value(zfp->stream, mode, size, &sum);
+  }
+  /* 32-bit checksum and padding to a whole number of 64-bit words */
+  if (mask & ZFP_HEADER_EXTENDED) {
+    size_t pad;
+    stream_write_bits(zfp->stream, sum, ZFP_CHECKSUM_BITS);
+    bits += ZFP_CHECKSUM_BITS;
+    pad = (64 - bits % 64) % 64;
+    stream_pad(zfp->stream, pad);
+    bits += pad;
   }
 
   return bits;
 }
 
 size_t
-zfp_read_header(zfp_stream* zfp, zfp_field* field, uint mask)
+zfp_read_header_ext(zfp_stream* zfp, zfp_field* field, uint mask, zfp_header_ext* ext)
 {
   size_t bits = 0;
+  uint32 sum = HEADER_CHECKSUM_INIT;
+  uint64 meta = 0;
+  uint64 mode = 0;
+  uint64 n[4] = { 0, 0, 0, 0 };
+  uint64 stride[4] = { 0, 0, 0, 0 };
+  uint64 index[2] = { 0, 0 };
+
   if (mask & ZFP_HEADER_MAGIC) {
+    uint version;
     if (stream_read_bits(zfp->stream, 8) != 'z' ||
         stream_read_bits(zfp->stream, 8) != 'f' ||
-        stream_read_bits(zfp->stream, 8) != 'p' ||
-        stream_read_bits(zfp->stream, 8) != zfp_codec_version)
+        stream_read_bits(zfp->stream, 8) != 'p')
       return 0;
+    /* codec version determines whether header is extended */
+    version = (uint)stream_read_bits(zfp->stream, 8);
+    if (version == zfp_codec_version)
+      mask &= ~ZFP_HEADER_EXTENDED;
+    else if (version == zfp_codec_version + HEADER_EXT_VERSION)
+      mask |= ZFP_HEADER_EXTENDED;
+    else
+      return 0;
+    sum = header_checksum(sum, (uint64)'z' + ((uint64)'f' << 8) + ((uint64)'p' << 16) + ((uint64)version << 24));
     bits += ZFP_MAGIC_BITS;
   }
-  if (mask & ZFP_HEADER_META) {
-    uint64 meta = stream_read_bits(zfp->stream, ZFP_META_BITS);
-    if (!zfp_field_set_metadata(field, meta))
-      return 0;
-    bits += ZFP_META_BITS;
+
+  if (!(mask & ZFP_HEADER_EXTENDED)) {
+    /* short header */
+    if (mask & ZFP_HEADER_META) {
+      meta = stream_read_bits(zfp->stream, ZFP_META_BITS);
+      if (!zfp_field_set_metadata(field, meta))
+        return 0;
+      bits += ZFP_META_BITS;
+    }
+    if (mask & ZFP_HEADER_MODE) {
+      mode = stream_read_bits(zfp->stream, ZFP_MODE_SHORT_BITS);
+      bits += ZFP_MODE_SHORT_BITS;
+      if (mode > ZFP_MODE_SHORT_MAX) {
+        uint size = ZFP_MODE_LONG_BITS - ZFP_MODE_SHORT_BITS;
+        mode += stream_read_bits(zfp->stream, size) << ZFP_MODE_SHORT_BITS;
+        bits += size;
+      }
+      if (zfp_stream_set_mode(zfp, mode) == zfp_mode_null)
+        return 0;
+    }
+    if (ext)
+      memset(ext, 0, sizeof(*ext));
   }
-  if (mask & ZFP_HEADER_MODE) {
-    uint64 mode = stream_read_bits(zfp->stream, ZFP_MODE_SHORT_BITS);
-    bits += ZFP_MODE_SHORT_BITS;
-    if (mode > ZFP_MODE_SHORT_MAX) {
-      uint size = ZFP_MODE_LONG_BITS - ZFP_MODE_SHORT_BITS;
-      mode += stream_read_bits(zfp->stream, size) << ZFP_MODE_SHORT_BITS;
-      bits += size;
+  else {
+    /* extended header; validate all of it before updating field and stream */
+    uint dims, i;
+    size_t pad;
+    zfp_stream params = *zfp;
+    if (!(mask & ZFP_HEADER_META))
+      return 0;
+    bits += read_header_value(zfp->stream, &meta, ZFP_META_EXT_BITS, &sum);
+    if (meta & ~(uint64)(0xf + HEADER_EXT_INFO + HEADER_EXT_CHUNK_INDEX))
+      return 0;
+    dims = (uint)((meta >> 2) & 0x3u) + 1;
+    for (i = 0; i < dims; i++) {
+      bits += read_header_value(zfp->stream, &n[i], 64, &sum);
+      if (!n[i] || (uint64)(size_t)n[i] != n[i])
+        return 0;
+    }
+    if (meta & HEADER_EXT_INFO) {
+      for (i = 0; i < dims; i++)
+        bits += read_header_value(zfp->stream, &stride[i], 64, &sum);
+      bits += read_header_value(zfp->stream, &index[0], 64, &sum);
+      bits += read_header_value(zfp->stream, &index[1], 64, &sum);
+    }
+    if (mask & ZFP_HEADER_MODE) {
+      mode = stream_read_bits(zfp->stream, ZFP_MODE_SHORT_BITS);
+      bits += ZFP_MODE_SHORT_BITS;
+      if (mode > ZFP_MODE_SHORT_MAX) {
+        uint size = ZFP_MODE_LONG_BITS - ZFP_MODE_SHORT_BITS;
+        mode += stream_read_bits(zfp->stream, size) << ZFP_MODE_SHORT_BITS;
+        bits += size;
+      }
+      sum = header_checksum(sum, mode);
+      if (zfp_stream_set_mode(&params, mode) == zfp_mode_null)
+        return 0;
     }
-    if (zfp_stream_set_mode(zfp, mode) == zfp_mode_null)
+    if (stream_read_bits(zfp->stream, ZFP_CHECKSUM_BITS) != sum)
       return 0;
+    bits += ZFP_CHECKSUM_BITS;
+    pad = (64 - bits % 64) % 64;
+    stream_skip(zfp->stream, pad);
+    bits += pad;
+
+    /* header is valid */
+    field->type = (zfp_type)((meta & 0x3u) + 1);
+    field->nx = (size_t)n[0];
+    field->ny = (size_t)n[1];
+    field->nz = (size_t)n[2];
+    field->nw = (size_t)n[3];
+    field->sx = field->sy = field->sz = field->sw = 0;
+    if (mask & ZFP_HEADER_MODE) {
+      zfp->minbits = params.minbits;
+      zfp->maxbits = params.maxbits;
+      zfp->maxprec = params.maxprec;
+      zfp->minexp = params.minexp;
+    }
+    zfp->chunk_index = !!(meta & HEADER_EXT_CHUNK_INDEX);
+    if (ext) {
+      ext->sx = (ptrdiff_t)(int64)stride[0];
+      ext->sy = (ptrdiff_t)(int64)stride[1];
+      ext->sz = (ptrdiff_t)(int64)stride[2];
+      ext->sw = (ptrdiff_t)(int64)stride[3];
+      ext->index_offset = index[0];
+      ext->index_size = index[1];
+    }
   }
+
   return bits;
 }
@@ -909,3 +909,91 @@ TEST_P(TEST_FIXTURE, given_serializedCompressedArray_when_constructorFromSeriali
   // cache size not preserved
   CheckMemberVarsCopied(arr, arr2, false);
 }
+
+TEST_P(TEST_FIXTURE, given_callerManagedBuffer_when_set_then_compressedInPlaceAndReopenedWithoutCopy)
+{
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, getRate(), inputDataArr);
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, getRate(), inputDataArr);
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), inputDataArr);
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), inputDataArr);
+#endif
+
+  size_t bytes = arr.compressed_size();
+  uint64* buffer = new uint64[(bytes + sizeof(uint64) - 1) / sizeof(uint64)];
+  uint64 expectedChecksum = hashBitstream((uint64*)arr.compressed_data(), bytes);
+
+  // compress into caller-managed buffer
+  {
+#if DIMS == 1
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, getRate(), buffer, bytes, true);
+#elif DIMS == 2
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, true);
+#elif DIMS == 3
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, true);
+#elif DIMS == 4
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, true);
+#endif
+    EXPECT_EQ(0u, hashBitstream(buffer, bytes));
+    arr2.set(inputDataArr);
+    EXPECT_EQ((void*)buffer, arr2.compressed_data());
+    EXPECT_EQ(bytes, arr2.compressed_size());
+  }
+  EXPECT_PRED_FORMAT2(ExpectEqPrintHexPred, expectedChecksum, hashBitstream(buffer, bytes));
+
+  // reopen compressed data in place
+  {
+#if DIMS == 1
+    ZFP_ARRAY_TYPE arr3(inputDataSideLen, getRate(), buffer, bytes, false);
+#elif DIMS == 2
+    ZFP_ARRAY_TYPE arr3(inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, false);
+#elif DIMS == 3
+    ZFP_ARRAY_TYPE arr3(inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, false);
+#elif DIMS == 4
+    ZFP_ARRAY_TYPE arr3(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, false);
+#endif
+    EXPECT_EQ((void*)buffer, arr3.compressed_data());
+    EXPECT_PRED_FORMAT2(ExpectEqPrintHexPred, expectedChecksum, hashBitstream((uint64*)arr3.compressed_data(), arr3.compressed_size()));
+    EXPECT_EQ((SCALAR)arr[0], (SCALAR)arr3[0]);
+    EXPECT_EQ((SCALAR)arr[inputDataTotalLen - 1], (SCALAR)arr3[inputDataTotalLen - 1]);
+  }
+
+  delete[] buffer;
+}
+
+TEST_P(TEST_FIXTURE, given_undersizedCallerManagedBuffer_when_construct_then_exceptionThrown)
+{
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, getRate());
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, getRate());
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate());
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate());
+#endif
+
+  size_t bytes = arr.compressed_size() - 1;
+  uchar* buffer = new uchar[bytes];
+
+  try {
+#if DIMS == 1
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, getRate(), buffer, bytes, true);
+#elif DIMS == 2
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, true);
+#elif DIMS == 3
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, true);
+#elif DIMS == 4
+    ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, getRate(), buffer, bytes, true);
+#endif
+    FAIL() << "No exception was thrown when one was expected";
+  }
+  catch (zfp::exception const& e) {
+    EXPECT_EQ(e.what(), std::string("buffer size is smaller than required"));
+  }
+
+  delete[] buffer;
+}
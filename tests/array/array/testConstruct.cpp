@@ -133,6 +133,40 @@ TEST_F(TEST_FIXTURE, when_headerFrom3DArray_expect_MatchingMetadata)
   EXPECT_EQ(h.size_z(), arr.size_z());
 }
 
+TEST_F(TEST_FIXTURE, given_extendedHeaderForLargeArray_when_deserializeHeader_expect_MatchingMetadata)
+{
+  // dimensions too large for the short header
+  uint64 ext[ZFP_HEADER_EXT_MAX_BITS / 64];
+  bitstream* s = stream_open(ext, sizeof(ext));
+  zfp_stream* zfp = zfp_stream_open(s);
+  zfp_stream_set_rate(zfp, 8, zfp_type_double, 2, zfp_true);
+  zfp_field_set_type(field, zfp_type_double);
+  zfp_field_set_size_2d(field, (size_t)1 << 30, 3);
+  EXPECT_EQ(0u, zfp_write_header(zfp, field, ZFP_HEADER_FULL));
+  size_t bits = zfp_write_header(zfp, field, ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED);
+  EXPECT_EQ(256u, bits);
+  zfp_stream_flush(zfp);
+  zfp_stream_close(zfp);
+  stream_close(s);
+
+  zfp::array2d::header h(ext, bits / CHAR_BIT);
+  EXPECT_EQ(bits / CHAR_BIT, h.size_bytes());
+  EXPECT_EQ(zfp_type_double, h.scalar_type());
+  EXPECT_EQ(8, h.rate());
+  EXPECT_EQ(2u, h.dimensionality());
+  EXPECT_EQ((size_t)1 << 30, h.size_x());
+  EXPECT_EQ(3u, h.size_y());
+
+  try {
+    zfp::array2d::header h2(ext, ZFP_HEADER_SIZE_BITS / CHAR_BIT);
+    FailWhenNoExceptionThrown();
+  } catch (zfp::exception const & e) {
+    EXPECT_EQ(e.what(), std::string("zfp header length does not match expectations"));
+  } catch (std::exception const & e) {
+    FailAndPrintException(e);
+  }
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
@@ -240,3 +240,39 @@ TEST_P(TEST_FIXTURE, when_implicitIndexForNonRate_then_exceptionThrown)
   catch (zfp::exception const&) { /* hitting this block is test success so do nothing */ }
   catch (std::exception const& e) { FailAndPrintException(e); }
 }
+
+TEST_P(TEST_FIXTURE, given_callerManagedBuffer_when_set_then_compressedInPlace)
+{
+  zfp_config config = getConfig();
+
+  if (std::get<2>(GetParam()) != TEST_INDEX_HY4)
+    GTEST_SKIP();
+
+  ZFP_ARRAY_TYPE arr(_repeat_arg(inputDataSideLen, DIMS), config, inputDataArr);
+  uint64 expectedChecksum = hashBitstream((uint64*)arr.compressed_data(), arr.compressed_size());
+
+  // buffer must accommodate worst-case (uncompacted) compressed size
+  size_t bytes = 2 * inputDataTotalLen * sizeof(SCALAR) + ZFP_HEADER_MAX_BITS;
+  uint64* buffer = new uint64[(bytes + sizeof(uint64) - 1) / sizeof(uint64)];
+
+  ZFP_ARRAY_TYPE arr2(_repeat_arg(inputDataSideLen, DIMS), config, buffer, bytes, true);
+  arr2.set(inputDataArr);
+  EXPECT_EQ((void*)buffer, arr2.compressed_data());
+  EXPECT_EQ(arr.compressed_size(), arr2.compressed_size());
+  EXPECT_PRED_FORMAT2(ExpectEqPrintHexPred, expectedChecksum, hashBitstream((uint64*)arr2.compressed_data(), arr2.compressed_size()));
+
+  // only fixed-rate data can be reopened without its block index
+  try {
+    ZFP_ARRAY_TYPE arr3(_repeat_arg(inputDataSideLen, DIMS), config, buffer, bytes, false);
+    if (config.mode != zfp_mode_fixed_rate)
+      FailWhenNoExceptionThrown();
+    EXPECT_EQ((void*)buffer, arr3.compressed_data());
+    EXPECT_PRED_FORMAT2(ExpectEqPrintHexPred, expectedChecksum, hashBitstream((uint64*)arr3.compressed_data(), arr3.compressed_size()));
+  }
+  catch (zfp::exception const& e) {
+    if (config.mode == zfp_mode_fixed_rate)
+      FailAndPrintException(e);
+  }
+
+  delete[] buffer;
+}
@@ -0,0 +1,166 @@
+#include "zfp/array3.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <cmath>
+
+TestEnv* const testEnv = new TestEnv;
+
+class CachePolicyTest : public TestFixture {
+protected:
+  struct Line {
+    double a;
+  };
+
+  // access line x and return index of line it replaced (x on hit)
+  template <class Policy>
+  static size_t access(zfp::internal::Cache<Line, size_t, Policy>& cache, size_t x, bool write = false)
+  {
+    Line* p = 0;
+    return cache.access(p, x, write).index();
+  }
+
+  // fill array of small cache in transposed order and verify contents
+  template <class Policy>
+  static void round_trip()
+  {
+    const size_t nx = 32, ny = 32, nz = 32;
+    typedef zfp::array3<double, zfp::codec::zfp3<double>, zfp::index::implicit, Policy> array;
+    array a(nx, ny, nz, 64.0, 0, 64 * 4 * 4 * 4 * sizeof(double));
+    for (size_t i = 0; i < nx; i++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t k = 0; k < nz; k++)
+          a(i, j, k) = value(i, j, k);
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++)
+          a(i, j, k) += 1;
+
+    // copies share the same policy
+    array b = a;
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++) {
+          ASSERT_NEAR(value(i, j, k) + 1, a(i, j, k), 1e-9);
+          ASSERT_EQ(double(a(i, j, k)), double(b(i, j, k)));
+        }
+  }
+
+  // number of misses in 7-point stencil sweep over nx * nx * nx blocks
+  template <class Policy>
+  static size_t stencil_misses(size_t nx, uint lines)
+  {
+    zfp::internal::Cache<Line, size_t, Policy> cache(lines);
+    size_t misses = 0;
+    for (size_t k = 0; k < nx; k++)
+      for (size_t j = 0; j < nx; j++)
+        for (size_t i = 0; i < nx; i++) {
+          // line indices are offset by one, as line zero is reserved
+          size_t x = 1 + i + nx * (j + nx * k);
+          const size_t neighbor[] = {
+            k > 0 ? x - nx * nx : 0,
+            j > 0 ? x - nx : 0,
+            i > 0 ? x - 1 : 0,
+            i < nx - 1 ? x + 1 : 0,
+            j < nx - 1 ? x + nx : 0,
+            k < nx - 1 ? x + nx * nx : 0,
+          };
+          for (uint n = 0; n < 6; n++)
+            if (neighbor[n] && access(cache, neighbor[n]) != neighbor[n])
+              misses++;
+          if (access(cache, x, true) != x)
+            misses++;
+        }
+    return misses;
+  }
+
+  static double value(size_t i, size_t j, size_t k) { return std::sin(0.1 * double(i)) + std::cos(0.2 * double(j)) * double(k); }
+};
+
+#define TEST_FIXTURE CachePolicyTest
+
+TEST_F(TEST_FIXTURE, given_lruPolicy_when_setIsFull_expect_leastRecentlyUsedLineReplaced)
+{
+  // one set of two ways
+  zfp::internal::Cache<Line, size_t, zfp::cache_policy::lru<2> > cache(2);
+  EXPECT_EQ(0u, access(cache, 1));
+  EXPECT_EQ(0u, access(cache, 2));
+  EXPECT_EQ(1u, access(cache, 1));
+  EXPECT_EQ(2u, access(cache, 3));
+  EXPECT_EQ(1u, access(cache, 1));
+  EXPECT_EQ(3u, access(cache, 3));
+  EXPECT_EQ(1u, access(cache, 4));
+}
+
+TEST_F(TEST_FIXTURE, given_clockPolicy_when_setIsFull_expect_unreferencedLineReplaced)
+{
+  // one set of four ways
+  zfp::internal::Cache<Line, size_t, zfp::cache_policy::clock<4> > cache(4);
+  for (size_t x = 1; x <= 4; x++)
+    EXPECT_EQ(0u, access(cache, x));
+  // all lines referenced; hand sweeps once and replaces first line
+  EXPECT_EQ(1u, access(cache, 5));
+  // line 3 gets a second chance while unreferenced line 2 is replaced
+  EXPECT_EQ(3u, access(cache, 3));
+  EXPECT_EQ(2u, access(cache, 6));
+  EXPECT_EQ(4u, access(cache, 7));
+}
+
+TEST_F(TEST_FIXTURE, given_setAssociativePolicy_when_lineEvicted_expect_dirtyTagReturned)
+{
+  zfp::internal::Cache<Line, size_t, zfp::cache_policy::lru<4> > cache(4);
+  Line* p = 0;
+  cache.access(p, 1, true);
+  for (size_t x = 2; x <= 4; x++)
+    cache.access(p, x, false);
+  zfp::internal::Cache<Line, size_t, zfp::cache_policy::lru<4> >::Tag tag = cache.access(p, 5, false);
+  EXPECT_EQ(1u, tag.index());
+  EXPECT_TRUE(tag.dirty());
+}
+
+TEST_F(TEST_FIXTURE, given_setAssociativePolicy_when_cacheResized_expect_atLeastOneSet)
+{
+  zfp::internal::Cache<Line, size_t, zfp::cache_policy::lru<8> > cache(1);
+  EXPECT_EQ(8u, cache.size());
+  cache.resize(100);
+  EXPECT_EQ(128u, cache.size());
+}
+
+TEST_F(TEST_FIXTURE, given_setAssociativePolicy_when_stencilSweep_expect_noMoreMissesThanDirect)
+{
+  // 20^3 blocks; two planes of blocks fit in cache
+  const size_t nx = 20;
+  const uint lines = 1024;
+  size_t misses = stencil_misses<zfp::cache_policy::direct>(nx, lines);
+  EXPECT_EQ(nx * nx * nx, misses);
+  EXPECT_LE(stencil_misses<zfp::cache_policy::lru<2> >(nx, lines), misses);
+  EXPECT_LE(stencil_misses<zfp::cache_policy::lru<4> >(nx, lines), misses);
+  EXPECT_LE(stencil_misses<zfp::cache_policy::lru<8> >(nx, lines), misses);
+  EXPECT_LE(stencil_misses<zfp::cache_policy::clock<4> >(nx, lines), misses);
+  EXPECT_LE(stencil_misses<zfp::cache_policy::clock<8> >(nx, lines), misses);
+}
+
+TEST_F(TEST_FIXTURE, given_directPolicy_when_arrayAccessed_expect_valuesPreserved)
+{
+  round_trip<zfp::cache_policy::direct>();
+}
+
+TEST_F(TEST_FIXTURE, given_lruPolicy_when_arrayAccessed_expect_valuesPreserved)
+{
+  round_trip<zfp::cache_policy::lru<4> >();
+}
+
+TEST_F(TEST_FIXTURE, given_clockPolicy_when_arrayAccessed_expect_valuesPreserved)
+{
+  round_trip<zfp::cache_policy::clock<8> >();
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+#include "zfp/array3.hpp"
+#include "zfp/constarray3.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <cmath>
+#include <vector>
+
+TestEnv* const testEnv = new TestEnv;
+
+class CachePrefetchTest : public TestFixture {
+protected:
+  // 6 x 5 x 4 blocks, including partial blocks
+  CachePrefetchTest() : nx(23), ny(18), nz(15), cache_size(32 * 4 * 4 * 4 * sizeof(double)) {}
+
+  static double value(size_t i, size_t j, size_t k) { return std::sin(0.3 * double(i)) + std::cos(0.2 * double(j)) - 0.1 * double(k); }
+
+  const size_t nx, ny, nz;
+  const size_t cache_size;
+};
+
+#define TEST_FIXTURE CachePrefetchTest
+
+TEST_F(TEST_FIXTURE, when_setCachePrefetch_expect_prefetchClamped)
+{
+  array3d a(nx, ny, nz, 16.0);
+  EXPECT_EQ(0u, a.cache_prefetch());
+  a.set_cache_prefetch(8);
+  EXPECT_EQ(8u, a.cache_prefetch());
+  a.set_cache_prefetch(1000);
+  EXPECT_EQ(64u, a.cache_prefetch());
+
+  // copies inherit decode-ahead setting
+  array3d b = a;
+  EXPECT_EQ(64u, b.cache_prefetch());
+}
+
+TEST_F(TEST_FIXTURE, given_constArray_when_iteratedWithPrefetch_expect_sameValuesFewerMisses)
+{
+  std::vector<double> data(nx * ny * nz);
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        data[i + nx * (j + ny * k)] = value(i, j, k);
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-6), &data[0], cache_size);
+  const_array3d b(nx, ny, nz, zfp_config_accuracy(1e-6), &data[0], cache_size);
+  b.set_cache_prefetch(7);
+
+  const_array3d::const_iterator p = a.cbegin();
+  for (const_array3d::const_iterator q = b.cbegin(); q != b.cend(); p++, q++)
+    ASSERT_EQ(double(*p), double(*q));
+
+  // one miss per batch of 1 + 7 blocks
+  size_t blocks = 6 * 5 * 4;
+  EXPECT_EQ(blocks, a.cache_stats().misses);
+  EXPECT_EQ(blocks / 8, b.cache_stats().misses);
+  EXPECT_EQ(nx * ny * nz, b.cache_stats().hits + b.cache_stats().misses);
+}
+
+TEST_F(TEST_FIXTURE, given_smallCache_when_writtenWithPrefetch_expect_modifiedBlocksPreserved)
+{
+  // cache of 4 lines is smaller than the decode-ahead depth
+  array3d a(nx, ny, nz, 32.0, 0, 4 * 4 * 4 * 4 * sizeof(double));
+  a.set_cache_prefetch(16);
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        a(i, j, k) = value(i, j, k);
+  // update in transposed order so that prefetched lines evict modified ones
+  for (size_t i = 0; i < nx; i++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t k = 0; k < nz; k++)
+        a(i, j, k) += 1;
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        ASSERT_NEAR(value(i, j, k) + 1, a(i, j, k), 1e-6);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
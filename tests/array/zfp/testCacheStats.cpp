@@ -0,0 +1,98 @@
+#include "zfp/array2.hpp"
+#include "zfp/constarray2.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <vector>
+
+TestEnv* const testEnv = new TestEnv;
+
+class CacheStatsTest : public TestFixture {
+protected:
+  // cache holds two of the 8 x 8 blocks of 4 x 4 values
+  CacheStatsTest() : nx(32), ny(32), cache_size(2 * 4 * 4 * sizeof(double)) {}
+
+  const size_t nx, ny;
+  const size_t cache_size;
+};
+
+#define TEST_FIXTURE CacheStatsTest
+
+TEST_F(TEST_FIXTURE, when_arrayConstructed_expect_zeroCacheStats)
+{
+  array2d a(nx, ny, 16.0, 0, cache_size);
+  cache_statistics stats = a.cache_stats();
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.writebacks);
+  EXPECT_EQ(0.0, stats.decode_time);
+  EXPECT_EQ(0.0, stats.encode_time);
+}
+
+TEST_F(TEST_FIXTURE, when_elementsAccessed_expect_hitsAndMissesCounted)
+{
+  array2d a(nx, ny, 16.0, 0, cache_size);
+  // row-by-row sweep misses once per block and row of blocks
+  for (size_t j = 0; j < ny; j++)
+    for (size_t i = 0; i < nx; i++)
+      a(i, j) = double(i + j);
+  cache_statistics stats = a.cache_stats();
+  EXPECT_EQ(nx * ny, stats.hits + stats.misses);
+  EXPECT_EQ(ny * (nx / 4), stats.misses);
+  // each block is evicted 4 times, all but the last two times before flush
+  EXPECT_EQ(ny * (nx / 4) - 2, stats.writebacks);
+  EXPECT_LE(0.0, stats.decode_time);
+  EXPECT_LE(0.0, stats.encode_time);
+
+  a.flush_cache();
+  EXPECT_EQ(ny * (nx / 4), a.cache_stats().writebacks);
+}
+
+TEST_F(TEST_FIXTURE, when_blocksAccessedInBulk_expect_uncachedBlocksCountedAsMisses)
+{
+  array2d a(nx, ny, 16.0, 0, cache_size);
+  std::vector<double> data(nx * ny, 1.0);
+  a.set(&data[0]);
+  a.reset_cache_stats();
+  // bulk get bypasses cache and decodes every block
+  a.get(&data[0]);
+  cache_statistics stats = a.cache_stats();
+  EXPECT_EQ((nx / 4) * (ny / 4), stats.misses);
+  EXPECT_EQ(0u, stats.writebacks);
+}
+
+TEST_F(TEST_FIXTURE, when_resetCacheStats_expect_zeroCacheStats)
+{
+  array2d a(nx, ny, 16.0, 0, cache_size);
+  for (size_t i = 0; i < nx * ny; i++)
+    a[i] = 1.0;
+  a.flush_cache();
+  a.reset_cache_stats();
+  cache_statistics stats = a.cache_stats();
+  EXPECT_EQ(0u, stats.hits + stats.misses + stats.writebacks);
+  EXPECT_EQ(0.0, stats.decode_time + stats.encode_time);
+}
+
+TEST_F(TEST_FIXTURE, given_constArray_when_elementsRead_expect_hitsAndMissesCounted)
+{
+  const_array2d a(nx, ny, zfp_config_rate(16.0, true), 0, cache_size);
+  std::vector<double> data(nx * ny, 1.0);
+  a.set(&data[0]);
+  for (size_t j = 0; j < ny; j++)
+    for (size_t i = 0; i < nx; i++)
+      EXPECT_EQ(1.0, a(i, j));
+  cache_statistics stats = a.cache_stats();
+  EXPECT_EQ(ny * (nx / 4), stats.misses);
+  EXPECT_EQ(nx * ny - stats.misses, stats.hits);
+  EXPECT_EQ(0u, stats.writebacks);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
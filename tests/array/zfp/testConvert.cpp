@@ -0,0 +1,132 @@
+#include "zfp/array1.hpp"
+#include "zfp/array2.hpp"
+#include "zfp/array3.hpp"
+#include "zfp/array4.hpp"
+#include "zfp/constarray1.hpp"
+#include "zfp/constarray3.hpp"
+#include "zfp/codec/gencodec.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+TestEnv* const testEnv = new TestEnv;
+
+class ConvertTest : public TestFixture {
+protected:
+  // partial blocks along every dimension
+  ConvertTest() : nx(27), ny(22), nz(13), data(nx * ny * nz)
+  {
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++)
+          data[i + nx * (j + ny * k)] = std::sin(0.3 * double(i)) * std::cos(0.2 * double(j)) - 0.05 * double(k);
+  }
+
+  const size_t nx, ny, nz;
+  std::vector<double> data;
+};
+
+#define TEST_FIXTURE ConvertTest
+
+TEST_F(TEST_FIXTURE, given_array_when_convertedToConstArray_expect_sameStreamAsSetFromDecompressedValues)
+{
+  array3d a(nx, ny, nz, 32.0, &data[0]);
+  std::vector<double> f(data.size());
+  a.get(&f[0]);
+  const_array3d b(nx, ny, nz, zfp_config_accuracy(1e-3));
+  const_array3d c(nx, ny, nz, zfp_config_accuracy(1e-3));
+  b.convert(a);
+  c.set(&f[0]);
+  ASSERT_EQ(c.compressed_size(), b.compressed_size());
+  EXPECT_EQ(0, std::memcmp(c.compressed_data(), b.compressed_data(), c.compressed_size()));
+}
+
+TEST_F(TEST_FIXTURE, given_constArray_when_convertedToArray_expect_sameStreamAsSetFromDecompressedValues)
+{
+  const_array3d a(nx, ny, nz, zfp_config_reversible(), &data[0]);
+  array3d b(nx, ny, nz, 16.0);
+  array3d c(nx, ny, nz, 16.0, &data[0]);
+  b(1, 2, 3) = 1;
+  b.convert(a);
+  ASSERT_EQ(c.compressed_size(), b.compressed_size());
+  EXPECT_EQ(0, std::memcmp(c.compressed_data(), b.compressed_data(), c.compressed_size()));
+}
+
+TEST_F(TEST_FIXTURE, given_arrayWithModifiedCachedBlocks_when_convertedToOtherScalarType_expect_modificationsIncluded)
+{
+  array3d a(nx, ny, nz, 64.0, &data[0]);
+  a(4, 5, 6) = 100;
+  array3f b(nx, ny, nz, 32.0);
+  a.reset_cache_stats();
+  b.convert(a);
+  // source blocks are not brought into its cache
+  EXPECT_EQ(0u, a.cache_stats().misses);
+  EXPECT_EQ(100, b(4, 5, 6));
+  EXPECT_NEAR(float(a(26, 21, 12)), b(26, 21, 12), 1e-5);
+}
+
+TEST_F(TEST_FIXTURE, given_array_when_convertedToGenericCodecArray_expect_valuesRoundedToStorageType)
+{
+  typedef array3<double, zfp::codec::generic3<double, float> > array3g;
+  array3d a(nx, ny, nz, 64.0, &data[0]);
+  array3g b(nx, ny, nz, 32.0);
+  b.convert(a);
+  std::vector<double> f(data.size());
+  std::vector<double> g(data.size());
+  a.get(&f[0]);
+  b.get(&g[0]);
+  for (size_t n = 0; n < f.size(); n++)
+    ASSERT_EQ(double(float(f[n])), g[n]);
+  // and back
+  array3d c(nx, ny, nz, 64.0);
+  c.convert(b);
+  for (size_t n = 0; n < f.size(); n += 37)
+    EXPECT_NEAR(g[n], c[n], 1e-12);
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfDifferentDimensions_when_converted_expect_exception)
+{
+  array3d a(nx, ny, nz, 16.0);
+  const_array3d b(nx, ny + 1, nz, zfp_config_rate(16, false));
+  EXPECT_THROW(b.convert(a), zfp::exception);
+  EXPECT_THROW(a.convert(b), zfp::exception);
+}
+
+TEST_F(TEST_FIXTURE, given_arrayConvertedToItself_when_converted_expect_unchanged)
+{
+  array3d a(nx, ny, nz, 16.0, &data[0]);
+  a(0, 0, 0) = 7;
+  a.convert(a);
+  EXPECT_EQ(7, a(0, 0, 0));
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfOtherDimensionality_when_converted_expect_decompressedValues)
+{
+  array1d a1(data.size(), 64.0, &data[0]);
+  const_array1f c1(data.size(), zfp_config_precision(24));
+  c1.convert(a1);
+  EXPECT_NEAR(data[1000], c1[1000], 1e-5);
+
+  array2d a2(nx, ny * nz, 64.0, &data[0]);
+  array2f b2(nx, ny * nz, 32.0);
+  b2.convert(a2);
+  EXPECT_NEAR(data[77], b2[77], 1e-5);
+
+  array4d a4(3, 5, 7, 9, 64.0, &data[0]);
+  array4d b4(3, 5, 7, 9, 64.0);
+  b4.convert(a4);
+  EXPECT_EQ(a4(2, 4, 6, 8), b4(2, 4, 6, 8));
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+#include "zfp/array3.hpp"
+#include "zfp/constarray1.hpp"
+#include "zfp/constarray3.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+
+TestEnv* const testEnv = new TestEnv;
+
+class ParallelBulkTest : public TestFixture {
+protected:
+  // partial blocks along every dimension
+  ParallelBulkTest() : nx(61), ny(38), nz(27), data(nx * ny * nz)
+  {
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++)
+          data[i + nx * (j + ny * k)] = std::sin(0.1 * double(i)) * std::cos(0.2 * double(j)) + 0.01 * double(k * k);
+  }
+
+  // compressed data of arrays a and b is identical
+  template <class Array>
+  static void expect_same_compressed_data(const Array& a, const Array& b)
+  {
+    ASSERT_EQ(a.compressed_size(), b.compressed_size());
+    EXPECT_EQ(0, std::memcmp(a.compressed_data(), b.compressed_data(), a.compressed_size()));
+  }
+
+  const size_t nx, ny, nz;
+  std::vector<double> data;
+};
+
+#define TEST_FIXTURE ParallelBulkTest
+
+INSTANTIATE_TEST_SUITE_P(TestManyThreadCounts, TEST_FIXTURE, ::testing::Values(2, 3, 8));
+
+TEST_P(TEST_FIXTURE, given_fixedRateArray_when_setInParallel_expect_serialCompressedData)
+{
+  array3d serial(nx, ny, nz, 12.0);
+  array3d parallel(nx, ny, nz, 12.0);
+  omp_set_num_threads(1);
+  serial.set(&data[0]);
+  omp_set_num_threads(GetParam());
+  parallel.set(&data[0]);
+  expect_same_compressed_data(serial, parallel);
+
+  // decompress in parallel
+  std::vector<double> expected(nx * ny * nz);
+  std::vector<double> actual(nx * ny * nz);
+  omp_set_num_threads(1);
+  serial.get(&expected[0]);
+  omp_set_num_threads(GetParam());
+  parallel.get(&actual[0]);
+  EXPECT_TRUE(expected == actual);
+}
+
+TEST_P(TEST_FIXTURE, given_cachedModifiedBlocks_when_getInParallel_expect_modifiedValues)
+{
+  array3d a(nx, ny, nz, 16.0);
+  omp_set_num_threads(GetParam());
+  a.set(&data[0]);
+  a(0, 0, 0) = 100;
+  a(nx - 1, ny - 1, nz - 1) = -100;
+  std::vector<double> actual(nx * ny * nz);
+  a.get(&actual[0]);
+  EXPECT_EQ(100, actual.front());
+  EXPECT_EQ(-100, actual.back());
+  EXPECT_EQ(a(nx / 2, ny / 2, nz / 2), actual[nx / 2 + nx * (ny / 2 + ny * (nz / 2))]);
+}
+
+TEST_P(TEST_FIXTURE, given_variableRateConstArray_when_setInParallel_expect_serialCompressedData)
+{
+  const_array3d serial(nx, ny, nz, zfp_config_accuracy(1e-3));
+  const_array3d parallel(nx, ny, nz, zfp_config_accuracy(1e-3));
+  omp_set_num_threads(1);
+  serial.set(&data[0]);
+  omp_set_num_threads(GetParam());
+  parallel.set(&data[0]);
+  expect_same_compressed_data(serial, parallel);
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        ASSERT_EQ(serial(i, j, k), parallel(i, j, k));
+}
+
+TEST_P(TEST_FIXTURE, given_reversibleConstArrayWithVerbatimIndex_when_setInParallel_expect_losslessRoundTrip)
+{
+  typedef const_array3<double, zfp::codec::zfp3<double>, zfp::index::verbatim> array;
+  array serial(nx, ny, nz, zfp_config_reversible());
+  array parallel(nx, ny, nz, zfp_config_reversible());
+  omp_set_num_threads(1);
+  serial.set(&data[0]);
+  omp_set_num_threads(GetParam());
+  parallel.set(&data[0]);
+  expect_same_compressed_data(serial, parallel);
+  std::vector<double> actual(nx * ny * nz);
+  parallel.get(&actual[0]);
+  EXPECT_TRUE(data == actual);
+}
+
+TEST_P(TEST_FIXTURE, given_unalignedFixedRateBlocks_when_setInParallel_expect_serialCompressedData)
+{
+  // 12-bit blocks share stream words
+  typedef const_array1<double, zfp::codec::zfp1<double>, zfp::index::implicit> array;
+  array serial(data.size(), zfp_config_rate(3.0, false));
+  array parallel(data.size(), zfp_config_rate(3.0, false));
+  omp_set_num_threads(1);
+  serial.set(&data[0]);
+  omp_set_num_threads(GetParam());
+  parallel.set(&data[0]);
+  expect_same_compressed_data(serial, parallel);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+#include "zfp/array1.hpp"
+#include "zfp/array3.hpp"
+#include "zfp/array4.hpp"
+#include "zfp/constarray2.hpp"
+#include "zfp/constarray3.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TestEnv* const testEnv = new TestEnv;
+
+class ReduceTest : public TestFixture {
+protected:
+  // partial blocks along every dimension
+  ReduceTest() : nx(27), ny(22), nz(13), data(nx * ny * nz)
+  {
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++)
+          data[index(i, j, k)] = std::sin(0.3 * double(i)) * std::cos(0.2 * double(j)) - 0.05 * double(k);
+  }
+
+  size_t index(size_t i, size_t j, size_t k) const { return i + nx * (j + ny * k); }
+
+  // verify reductions over box against those over decompressed values
+  template <class Array>
+  void expect_box_reductions(const Array& a, const Array& b, size_t x, size_t y, size_t z, size_t mx, size_t my, size_t mz) const
+  {
+    std::vector<double> u(nx * ny * nz);
+    std::vector<double> v(nx * ny * nz);
+    a.get(&u[0]);
+    b.get(&v[0]);
+    double sum = 0;
+    double dot = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    for (size_t k = z; k < z + mz; k++)
+      for (size_t j = y; j < y + my; j++)
+        for (size_t i = x; i < x + mx; i++) {
+          double f = u[index(i, j, k)];
+          sum += f;
+          dot += f * v[index(i, j, k)];
+          min = std::min(min, f);
+          max = std::max(max, f);
+        }
+    EXPECT_NEAR(sum, a.sum(x, y, z, mx, my, mz), 1e-10);
+    EXPECT_NEAR(dot, a.dot(b, x, y, z, mx, my, mz), 1e-10);
+    EXPECT_EQ(min, a.minimum(x, y, z, mx, my, mz));
+    EXPECT_EQ(max, a.maximum(x, y, z, mx, my, mz));
+  }
+
+  const size_t nx, ny, nz;
+  std::vector<double> data;
+};
+
+#define TEST_FIXTURE ReduceTest
+
+TEST_F(TEST_FIXTURE, given_constArray_when_reducedOverArray_expect_reductionsOfDecompressedValues)
+{
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-4));
+  const_array3d b(nx, ny, nz, zfp_config_precision(20));
+  a.set(&data[0]);
+  b.set(&data[0]);
+  expect_box_reductions(a, b, 0, 0, 0, nx, ny, nz);
+  EXPECT_EQ(a.sum(0, 0, 0, nx, ny, nz), a.sum());
+  EXPECT_EQ(a.dot(b, 0, 0, 0, nx, ny, nz), a.dot(b));
+}
+
+TEST_F(TEST_FIXTURE, given_constArray_when_reducedOverUnalignedBox_expect_onlyBoxElementsReduced)
+{
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-4));
+  const_array3d b(nx, ny, nz, zfp_config_rate(12, false));
+  a.set(&data[0]);
+  b.set(&data[0]);
+  expect_box_reductions(a, b, 3, 5, 2, 17, 1, 11);
+  expect_box_reductions(a, b, 9, 0, 4, 2, 22, 1);
+}
+
+TEST_F(TEST_FIXTURE, given_modifiedCachedBlocks_when_reduced_expect_modifiedValuesReduced)
+{
+  array3d a(nx, ny, nz, 24.0);
+  array3d b(nx, ny, nz, 16.0);
+  a.set(&data[0]);
+  b.set(&data[0]);
+  a(5, 6, 7) = 100;
+  a(nx - 1, ny - 1, nz - 1) = -100;
+  EXPECT_EQ(100, a.maximum());
+  EXPECT_EQ(-100, a.minimum());
+  expect_box_reductions(a, b, 1, 2, 3, 20, 19, 10);
+  expect_box_reductions(a, a, 0, 0, 0, nx, ny, nz);
+}
+
+TEST_F(TEST_FIXTURE, given_reversibleArray_when_reduced_expect_exactExtrema)
+{
+  const_array3d a(nx, ny, nz, zfp_config_reversible());
+  a.set(&data[0]);
+  EXPECT_EQ(*std::min_element(data.begin(), data.end()), a.minimum());
+  EXPECT_EQ(*std::max_element(data.begin(), data.end()), a.maximum());
+}
+
+TEST_F(TEST_FIXTURE, given_blocksBoundedByCurrentExtremum_when_reduced_expect_blocksNotDecoded)
+{
+  // all blocks but the first hold values of magnitude less than one
+  std::vector<double> f(nx * ny * nz, 0.25);
+  f[0] = 1000;
+  f[1] = -1000;
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-6));
+  a.set(&f[0]);
+  // blocks that follow the first one (on the same thread) are skipped
+  const size_t blocks = ((nx + 3) / 4) * ((ny + 3) / 4) * ((nz + 3) / 4);
+  a.reset_cache_stats();
+  EXPECT_NEAR(1000, a.maximum(), 1e-3);
+  EXPECT_LT(a.cache_stats().misses, blocks);
+  a.reset_cache_stats();
+  EXPECT_NEAR(-1000, a.minimum(), 1e-3);
+  EXPECT_LT(a.cache_stats().misses, blocks);
+}
+
+TEST_F(TEST_FIXTURE, given_allZeroBlocks_when_summed_expect_blocksNotDecoded)
+{
+  std::vector<double> f(nx * ny * nz, 0.0);
+  f[index(nx - 1, ny - 1, nz - 1)] = 2;
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-6));
+  a.set(&f[0]);
+  a.reset_cache_stats();
+  EXPECT_NEAR(2, a.sum(), 1e-5);
+  EXPECT_EQ(1u, a.cache_stats().misses);
+  // a zero block bounds the minimum of a nonnegative array
+  EXPECT_EQ(0, a.minimum());
+}
+
+TEST_F(TEST_FIXTURE, given_emptyBox_when_reduced_expect_identity)
+{
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-4));
+  a.set(&data[0]);
+  EXPECT_EQ(0, a.sum(1, 1, 1, 0, 4, 4));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), a.minimum(1, 1, 1, 4, 0, 4));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), a.maximum(1, 1, 1, 4, 4, 0));
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfDifferentDimensions_when_dotProduct_expect_exception)
+{
+  const_array3d a(nx, ny, nz, zfp_config_accuracy(1e-4));
+  const_array3d b(nx, ny, nz + 1, zfp_config_accuracy(1e-4));
+  EXPECT_THROW(a.dot(b), zfp::exception);
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfOtherDimensionality_when_reduced_expect_reductionsOfDecompressedValues)
+{
+  array1d a1(data.size(), 32.0, &data[0]);
+  std::vector<double> f(data.size());
+  a1.get(&f[0]);
+  double sum = 0;
+  for (size_t i = 5; i < 77; i++)
+    sum += f[i];
+  EXPECT_NEAR(sum, a1.sum(5, 72), 1e-10);
+
+  const_array2d a2(nx, ny * nz, zfp_config_accuracy(1e-4));
+  a2.set(&data[0]);
+  a2.get(&f[0]);
+  EXPECT_EQ(*std::max_element(f.begin(), f.end()), a2.maximum());
+
+  array4d a4(3, 5, 7, 9, 24.0);
+  a4.set(&data[0]);
+  a4.get(&f[0]);
+  EXPECT_EQ(*std::min_element(f.begin(), f.begin() + a4.size()), a4.minimum());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,111 @@
+#ifndef ZFP_WITH_CACHE_SHARED
+  #define ZFP_WITH_CACHE_SHARED
+#endif
+#include "zfp/array3.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <vector>
+#include <omp.h>
+
+TestEnv* const testEnv = new TestEnv;
+
+class SharedCacheTest : public TestFixture {
+protected:
+  // small cache relative to array size to force evictions during access
+  SharedCacheTest() : nx(32), ny(32), nz(32), rate(24), cache_size(16 * 4 * 4 * 4 * sizeof(double)) {}
+
+  static double value(size_t i, size_t j, size_t k) { return 0.5 * double(i) + 0.25 * double(j) - 0.125 * double(k); }
+
+  const size_t nx, ny, nz;
+  const double rate;
+  const size_t cache_size;
+};
+
+#define TEST_FIXTURE SharedCacheTest
+
+INSTANTIATE_TEST_SUITE_P(TestManyThreadCounts, TEST_FIXTURE, ::testing::Values(1, 2, 4, 8));
+
+TEST_P(TEST_FIXTURE, when_threadsWriteSharedCache_expect_serialResult)
+{
+  int threads = GetParam();
+  array3d serial(nx, ny, nz, rate, 0, cache_size);
+  array3d shared(nx, ny, nz, rate, 0, cache_size);
+
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++) {
+        serial(i, j, k) = value(i, j, k);
+        serial(i, j, k) *= 2;
+      }
+
+  // interleave elements among threads so that blocks are shared
+  #pragma omp parallel for num_threads(threads)
+  for (int n = 0; n < int(nx * ny * nz); n++) {
+    size_t i = size_t(n) % nx;
+    size_t j = (size_t(n) / nx) % ny;
+    size_t k = size_t(n) / (nx * ny);
+    shared(i, j, k) = value(i, j, k);
+    shared(i, j, k) *= 2;
+  }
+
+  // blocks may be evicted in different order, so compare within tolerance
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        ASSERT_NEAR(serial(i, j, k), shared(i, j, k), 1e-4);
+}
+
+TEST_P(TEST_FIXTURE, when_threadsAccumulateSharedCache_expect_allUpdatesApplied)
+{
+  int threads = GetParam();
+  const int passes = 8;
+  array3d a(nx, ny, nz, rate, 0, cache_size);
+  a.set(0);
+
+  // every thread increments every element of a slab; exact in 24-bit fixed rate
+  #pragma omp parallel num_threads(threads)
+  for (int p = 0; p < passes; p++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        a(i, j, 0) += 1;
+
+  for (size_t j = 0; j < ny; j++)
+    for (size_t i = 0; i < nx; i++)
+      ASSERT_EQ(double(threads * passes), a(i, j, 0));
+}
+
+TEST_P(TEST_FIXTURE, when_threadsReadSharedCache_expect_serialValues)
+{
+  int threads = GetParam();
+  array3d a(nx, ny, nz, rate, 0, cache_size);
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++)
+        a(i, j, k) = value(i, j, k);
+  a.flush_cache();
+
+  // decompress serially for reference
+  std::vector<double> expected(nx * ny * nz);
+  a.get(&expected[0]);
+
+  int mismatches = 0;
+  #pragma omp parallel for num_threads(threads) reduction(+:mismatches)
+  for (int n = 0; n < int(nx * ny * nz); n++) {
+    // traverse array in different order on each thread
+    size_t m = (size_t(n) * 7919) % (nx * ny * nz);
+    if (a[m] != expected[m])
+      mismatches++;
+  }
+  EXPECT_EQ(0, mismatches);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
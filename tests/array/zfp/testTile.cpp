@@ -0,0 +1,165 @@
+#include "zfp/array1.hpp"
+#include "zfp/array3.hpp"
+#include "zfp/array4.hpp"
+#include "zfp/constarray2.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <vector>
+
+TestEnv* const testEnv = new TestEnv;
+
+class TileTest : public TestFixture {
+protected:
+  // partial blocks along every dimension
+  TileTest() : nx(14), ny(9), nz(7), bx(4), by(3), bz(2) {}
+
+  static double value(size_t i, size_t j, size_t k) { return double(i) + 16 * double(j) + 256 * double(k); }
+
+  void fill(array3d& a) const
+  {
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++)
+          a(i, j, k) = value(i, j, k);
+  }
+
+  const size_t nx, ny, nz;
+  const size_t bx, by, bz;
+};
+
+#define TEST_FIXTURE TileTest
+
+TEST_F(TEST_FIXTURE, given_constTile_when_accessed_expect_blockValuesAndBounds)
+{
+  array3d a(nx, ny, nz, 64.0);
+  fill(a);
+  // last block is partial along every dimension
+  array3d::const_tile t(&a, bx * by * bz - 1);
+  EXPECT_EQ(2u, t.size_x());
+  EXPECT_EQ(1u, t.size_y());
+  EXPECT_EQ(3u, t.size_z());
+  EXPECT_EQ(6u, t.size());
+  EXPECT_EQ(12u, t.global_x(0));
+  EXPECT_EQ(8u, t.global_y(0));
+  EXPECT_EQ(4u, t.global_z(0));
+  for (size_t k = 0; k < t.size_z(); k++)
+    for (size_t j = 0; j < t.size_y(); j++)
+      for (size_t i = 0; i < t.size_x(); i++) {
+        EXPECT_EQ(value(t.global_x(i), t.global_y(j), t.global_z(k)), t(i, j, k));
+        EXPECT_EQ(t(i, j, k), t.data()[i + 4 * j + 16 * k]);
+      }
+}
+
+TEST_F(TEST_FIXTURE, given_mutableTile_when_destroyed_expect_modificationsCommitted)
+{
+  array3d a(nx, ny, nz, 64.0);
+  fill(a);
+  {
+    array3d::tile t(&a, 1);
+    double* p = t.data();
+    for (size_t n = 0; n < 4 * 4 * 4; n++)
+      p[n] = -p[n];
+    // array is not updated until tile is committed
+    EXPECT_EQ(value(4, 0, 0), a(4, 0, 0));
+  }
+  EXPECT_EQ(-value(4, 0, 0), a(4, 0, 0));
+  EXPECT_EQ(-value(7, 3, 3), a(7, 3, 3));
+  EXPECT_EQ(value(8, 0, 0), a(8, 0, 0));
+}
+
+TEST_F(TEST_FIXTURE, given_unmodifiedMutableTile_when_destroyed_expect_noWriteBack)
+{
+  array3d a(nx, ny, nz, 64.0);
+  fill(a);
+  a.flush_cache();
+  a.reset_cache_stats();
+  {
+    array3d::tile t(&a, 2);
+    const array3d::tile& c = t;
+    EXPECT_EQ(value(8, 0, 0), c(0, 0, 0));
+  }
+  a.flush_cache();
+  EXPECT_EQ(0u, a.cache_stats().writebacks);
+}
+
+TEST_F(TEST_FIXTURE, given_uncachedBlock_when_tileCommitted_expect_valuesReplaced)
+{
+  array3d a(nx, ny, nz, 64.0);
+  fill(a);
+  a.flush_cache();
+  a.clear_cache();
+  array3d::tile t(&a, 0);
+  a.clear_cache();
+  for (size_t k = 0; k < 4; k++)
+    for (size_t j = 0; j < 4; j++)
+      for (size_t i = 0; i < 4; i++)
+        t(i, j, k) = 1;
+  t.commit();
+  EXPECT_EQ(1, a(3, 3, 3));
+  EXPECT_EQ(value(4, 0, 0), a(4, 0, 0));
+}
+
+TEST_F(TEST_FIXTURE, given_smallCache_when_stencilAppliedToTiles_expect_elementwiseResult)
+{
+  // one-line cache; neighboring tiles evict each other's cache lines
+  array3d a(nx, ny, nz, 64.0, 0, 1);
+  array3d b(nx, ny, nz, 64.0, 0, 1);
+  array3d c(nx, ny, nz, 64.0);
+  fill(a);
+  fill(c);
+  ASSERT_EQ(bx * by * bz, a.blocks());
+  // double each element and add its +x neighbor within the same block
+  for (size_t n = 0; n < a.blocks(); n++) {
+    array3d::const_tile s(&a, n);
+    array3d::tile t(&b, n);
+    for (size_t k = 0; k < s.size_z(); k++)
+      for (size_t j = 0; j < s.size_y(); j++)
+        for (size_t i = 0; i < s.size_x(); i++)
+          t(i, j, k) = 2 * s(i, j, k) + (i + 1 < s.size_x() ? s(i + 1, j, k) : 0);
+  }
+  for (size_t k = 0; k < nz; k++)
+    for (size_t j = 0; j < ny; j++)
+      for (size_t i = 0; i < nx; i++) {
+        double f = 2 * c(i, j, k) + ((i + 1) % 4 && i + 1 < nx ? c(i + 1, j, k) : 0);
+        ASSERT_EQ(f, b(i, j, k));
+      }
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfOtherDimensionality_when_tilesAccessed_expect_blockValues)
+{
+  array1d a1(10, 64.0);
+  for (size_t i = 0; i < 10; i++)
+    a1(i) = double(i);
+  array1d::const_tile t1(&a1, 2);
+  EXPECT_EQ(2u, t1.size_x());
+  EXPECT_EQ(9, t1(1));
+
+  std::vector<double> f(6 * 5);
+  for (size_t n = 0; n < f.size(); n++)
+    f[n] = double(n);
+  const_array2d a2(6, 5, zfp_config_reversible(), &f[0]);
+  const_array2d::const_tile t2(&a2, 3);
+  EXPECT_EQ(2u, t2.size_x());
+  EXPECT_EQ(1u, t2.size_y());
+  EXPECT_EQ(f[4 + 6 * 4], t2(0, 0));
+
+  array4d a4(5, 5, 5, 5, 64.0);
+  a4(4, 4, 4, 4) = 3;
+  {
+    array4d::tile t4(&a4, 15);
+    EXPECT_EQ(1u, t4.size());
+    t4(0, 0, 0, 0) += 1;
+  }
+  EXPECT_EQ(4, a4(4, 4, 4, 4));
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+#include "zfp/array1.hpp"
+#include "zfp/array2.hpp"
+#include "zfp/array3.hpp"
+#include "zfp/array4.hpp"
+using namespace zfp;
+
+#include "gtest/gtest.h"
+#include "../utils/gtestTestEnv.h"
+#include "../utils/gtestSingleFixture.h"
+#include "../utils/predicates.h"
+
+#include <cmath>
+#include <vector>
+
+TestEnv* const testEnv = new TestEnv;
+
+class TransformTest : public TestFixture {
+protected:
+  // partial blocks along every dimension
+  TransformTest() : nx(27), ny(22), nz(13), u(nx * ny * nz), v(nx * ny * nz)
+  {
+    for (size_t k = 0; k < nz; k++)
+      for (size_t j = 0; j < ny; j++)
+        for (size_t i = 0; i < nx; i++) {
+          u[index(i, j, k)] = std::sin(0.3 * double(i)) * std::cos(0.2 * double(j)) - 0.05 * double(k);
+          v[index(i, j, k)] = std::cos(0.1 * double(i + j)) + 0.01 * double(k * k);
+        }
+  }
+
+  size_t index(size_t i, size_t j, size_t k) const { return i + nx * (j + ny * k); }
+
+  // verify that array a holds values f compressed at the same rate
+  static void expect_values(const array3d& a, const std::vector<double>& f)
+  {
+    array3d b(a.size_x(), a.size_y(), a.size_z(), a.rate(), &f[0]);
+    std::vector<double> g(f.size());
+    std::vector<double> h(f.size());
+    a.get(&g[0]);
+    b.get(&h[0]);
+    for (size_t n = 0; n < f.size(); n++)
+      ASSERT_NEAR(h[n], g[n], 1e-12 * (1 + std::fabs(h[n])));
+  }
+
+  const size_t nx, ny, nz;
+  std::vector<double> u, v;
+};
+
+#define TEST_FIXTURE TransformTest
+
+TEST_F(TEST_FIXTURE, given_twoArrays_when_axpy_expect_blockwiseCombinationOfDecompressedValues)
+{
+  array3d a(nx, ny, nz, 24.0, &u[0]);
+  array3d x(nx, ny, nz, 16.0, &v[0]);
+  std::vector<double> f(u.size());
+  std::vector<double> g(v.size());
+  a.get(&f[0]);
+  x.get(&g[0]);
+  for (size_t n = 0; n < f.size(); n++)
+    f[n] += 0.25 * g[n];
+  a.axpy(0.25, x);
+  expect_values(a, f);
+}
+
+TEST_F(TEST_FIXTURE, given_twoArrays_when_addedScaledAndInterpolated_expect_elementwiseResults)
+{
+  array3d a(nx, ny, nz, 32.0, &u[0]);
+  array3d x(nx, ny, nz, 32.0, &v[0]);
+  std::vector<double> f(u.size());
+  std::vector<double> g(v.size());
+  x.get(&g[0]);
+
+  a.get(&f[0]);
+  for (size_t n = 0; n < f.size(); n++)
+    f[n] += g[n];
+  a.add(x);
+  expect_values(a, f);
+
+  a.get(&f[0]);
+  for (size_t n = 0; n < f.size(); n++)
+    f[n] *= -3;
+  a.scale(-3);
+  expect_values(a, f);
+
+  a.get(&f[0]);
+  for (size_t n = 0; n < f.size(); n++)
+    f[n] += 0.75 * (g[n] - f[n]);
+  a.lerp(x, 0.75);
+  expect_values(a, f);
+}
+
+TEST_F(TEST_FIXTURE, given_modifiedCachedBlocks_when_axpy_expect_modificationsIncluded)
+{
+  array3d a(nx, ny, nz, 64.0, &u[0]);
+  array3d x(nx, ny, nz, 64.0, &v[0]);
+  a(1, 2, 3) = 100;
+  x(1, 2, 3) = 10;
+  x(nx - 1, ny - 1, nz - 1) = -10;
+  a.axpy(2, x);
+  EXPECT_NEAR(120, a(1, 2, 3), 1e-10);
+  EXPECT_NEAR(u[index(nx - 1, ny - 1, nz - 1)] - 20, a(nx - 1, ny - 1, nz - 1), 1e-10);
+  // x is left unchanged
+  EXPECT_EQ(10, x(1, 2, 3));
+}
+
+TEST_F(TEST_FIXTURE, given_arrayCombinedWithItself_when_transformed_expect_aliasingHandled)
+{
+  array3d a(nx, ny, nz, 64.0, &u[0]);
+  std::vector<double> f(u.size());
+  a.get(&f[0]);
+  a(0, 0, 0) = 1;
+  f[0] = 1;
+  a.add(a);
+  for (size_t n = 0; n < f.size(); n++)
+    f[n] *= 2;
+  expect_values(a, f);
+  a.get(&f[0]);
+  a.lerp(a, 0.5);
+  expect_values(a, f);
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfDifferentDimensions_when_combined_expect_exception)
+{
+  array3d a(nx, ny, nz, 16.0);
+  array3d b(nx + 1, ny, nz, 16.0);
+  EXPECT_THROW(a.add(b), zfp::exception);
+  EXPECT_THROW(a.axpy(1, b), zfp::exception);
+  EXPECT_THROW(a.lerp(b, 0.5), zfp::exception);
+}
+
+TEST_F(TEST_FIXTURE, given_arraysOfOtherDimensionality_when_axpy_expect_elementwiseResults)
+{
+  array1f a1(u.size(), 32.0, 0);
+  array1f x1(u.size(), 32.0, 0);
+  for (size_t i = 0; i < a1.size(); i++) {
+    a1(i) = float(i);
+    x1(i) = 1;
+  }
+  a1.axpy(2, x1);
+  EXPECT_EQ(102, a1(100));
+
+  array2d a2(nx, ny * nz, 64.0, &u[0]);
+  array2d x2(nx, ny * nz, 64.0, &v[0]);
+  a2.axpy(-1, x2);
+  EXPECT_NEAR(u[77] - v[77], a2[77], 1e-10);
+
+  array4d a4(3, 5, 7, 9, 64.0, &u[0]);
+  a4.scale(0.5);
+  EXPECT_NEAR(0.5 * u[a4.size() - 1], a4(2, 4, 6, 8), 1e-10);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  static_cast<void>(::testing::AddGlobalTestEnvironment(testEnv));
+  return RUN_ALL_TESTS();
+}
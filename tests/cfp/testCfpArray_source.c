@@ -468,6 +468,32 @@ _catFunc3(given_, CFP_ARRAY_TYPE, _when_clearCache_expect_cacheCleared)(void **s
   assert_true(CFP_NAMESPACE.SUB_NAMESPACE.get_flat(cfpArr, 0) == prevVal);
 }
 
+static void
+_catFunc3(given_, CFP_ARRAY_TYPE, _when_cacheAccessed_expect_cacheStatsUpdated)(void **state)
+{
+  struct setupVars *bundle = *state;
+  CFP_ARRAY_TYPE cfpArr = bundle->cfpArr;
+  cfp_cache_stats stats;
+
+  CFP_NAMESPACE.SUB_NAMESPACE.clear_cache(cfpArr);
+  CFP_NAMESPACE.SUB_NAMESPACE.reset_cache_stats(cfpArr);
+
+  // first access misses, second hits
+  CFP_NAMESPACE.SUB_NAMESPACE.get_flat(cfpArr, 0);
+  CFP_NAMESPACE.SUB_NAMESPACE.set_flat(cfpArr, 0, (SCALAR)VAL);
+  CFP_NAMESPACE.SUB_NAMESPACE.flush_cache(cfpArr);
+
+  stats = CFP_NAMESPACE.SUB_NAMESPACE.cache_stats(cfpArr);
+  assert_int_equal(stats.hits, 1);
+  assert_int_equal(stats.misses, 1);
+  assert_int_equal(stats.writebacks, 1);
+
+  CFP_NAMESPACE.SUB_NAMESPACE.reset_cache_stats(cfpArr);
+  stats = CFP_NAMESPACE.SUB_NAMESPACE.cache_stats(cfpArr);
+  assert_int_equal(stats.hits + stats.misses + stats.writebacks, 0);
+  assert_true(stats.decode_time == 0 && stats.encode_time == 0);
+}
+
 static void
 _catFunc3(given_, CFP_ARRAY_TYPE, _when_setFlat_expect_entryWrittenToCacheOnly)(void **state)
 {
@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+
+"""
+Measure how zfpy compression and decompression scale with the number of
+OpenMP threads.  This is a benchmark, not a test, and is not run by ctest.
+"""
+
+import argparse
+import os
+import time
+
+import numpy as np
+import zfpy
+
+
+def smooth_field(n):
+    x = np.linspace(0, 4 * np.pi, n)
+    return (np.sin(x)[:, None, None] *
+            np.cos(x)[None, :, None] *
+            np.sin(0.5 * x)[None, None, :])
+
+
+def best_time(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", type=int, default=256,
+                        help="array size along each of three dimensions")
+    parser.add_argument("-t", "--threads", type=int, nargs="+",
+                        default=[1, 2, 4, 8, os.cpu_count() or 1],
+                        help="thread counts to benchmark")
+    parser.add_argument("-c", "--chunk-size", type=int, default=0,
+                        help="blocks per chunk (0 for default)")
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+                        help="number of timed runs per thread count")
+    mode = parser.add_mutually_exclusive_group()
+    mode.add_argument("--rate", type=float, default=-1)
+    mode.add_argument("--tolerance", type=float, default=-1)
+    mode.add_argument("--precision", type=int, default=-1)
+    args = parser.parse_args()
+
+    field = smooth_field(args.n)
+    mode = {"rate": args.rate, "tolerance": args.tolerance,
+            "precision": args.precision}
+    # variable-rate streams need a chunk index to decompress in parallel
+    chunk_index = args.rate < 0
+
+    serial = zfpy.compress_numpy(field, chunk_index=chunk_index, **mode)
+    print("{} MB in, {} MB out, chunk index {}".format(
+        field.nbytes >> 20, len(serial) >> 20, "on" if chunk_index else "off"))
+    print("{:>8} {:>12} {:>8} {:>12} {:>8}".format(
+        "threads", "compress", "speedup", "decompress", "speedup"))
+
+    exec_serial = {"execution": "serial", "chunk_index": chunk_index}
+    base_c = best_time(
+        lambda: zfpy.compress_numpy(field, **mode, **exec_serial), args.repeat)
+    base_d = best_time(
+        lambda: zfpy.decompress_numpy(serial, **exec_serial), args.repeat)
+    print("{:>8} {:>11.3f}s {:>7.2f}x {:>11.3f}s {:>7.2f}x".format(
+        "serial", base_c, 1.0, base_d, 1.0))
+
+    for threads in sorted(set(args.threads)):
+        exec_omp = {"threads": threads, "chunk_size": args.chunk_size,
+                    "chunk_index": chunk_index}
+        try:
+            compressed = zfpy.compress_numpy(field, **mode, **exec_omp)
+        except RuntimeError:
+            print("zfp was built without OpenMP support")
+            return
+        t_c = best_time(
+            lambda: zfpy.compress_numpy(field, **mode, **exec_omp), args.repeat)
+        t_d = best_time(
+            lambda: zfpy.decompress_numpy(compressed, **exec_omp), args.repeat)
+        print("{:>8} {:>11.3f}s {:>7.2f}x {:>11.3f}s {:>7.2f}x".format(
+            threads, t_c, base_c / t_c, t_d, base_d / t_d))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,6 @@
 #!/usr/bin/env python
 
+import mmap
 import unittest
 
 import zfpy
@@ -146,6 +147,193 @@ class TestNumpy(unittest.TestCase):
             )
             self.assertIsNone(np.testing.assert_array_equal(decompressed_array, random_array))
 
+    def test_parallel_execution(self):
+        random_array = np.random.rand(37, 21, 19)
+        try:
+            zfpy.compress_numpy(random_array, threads=2)
+        except RuntimeError:
+            self.skipTest("zfp was built without OpenMP support")
+
+        for mode_kwargs in [{}, {"tolerance": 1e-4}, {"rate": 12}, {"precision": 20}]:
+            serial = zfpy.compress_numpy(random_array, **mode_kwargs)
+            for exec_kwargs in [
+                {"threads": 2},
+                {"threads": 3, "chunk_size": 5},
+                {"execution": "omp"},
+                {"execution": zfpy.exec_omp, "chunk_size": 1},
+            ]:
+                # parallel compression produces the serial stream
+                parallel = zfpy.compress_numpy(random_array, **mode_kwargs, **exec_kwargs)
+                self.assertEqual(serial, parallel)
+                self.assertIsNone(np.testing.assert_array_equal(
+                    zfpy.decompress_numpy(serial),
+                    zfpy.decompress_numpy(parallel, **exec_kwargs),
+                ))
+
+            # streams with a chunk index round trip through either policy
+            indexed = zfpy.compress_numpy(
+                random_array, threads=2, chunk_size=7, chunk_index=True, **mode_kwargs
+            )
+            expected = zfpy.decompress_numpy(serial)
+            for exec_kwargs in [{"execution": "serial"}, {"threads": 2}, {"threads": 4, "chunk_size": 7}]:
+                self.assertIsNone(np.testing.assert_array_equal(
+                    expected,
+                    zfpy.decompress_numpy(indexed, chunk_index=True, **exec_kwargs),
+                ))
+
+            decompressed_array = np.empty_like(random_array)
+            zfpy._decompress(
+                zfpy.compress_numpy(random_array, write_header=False, threads=2, **mode_kwargs),
+                zfpy.dtype_to_ztype(random_array.dtype),
+                random_array.shape,
+                out=decompressed_array,
+                threads=2,
+                **mode_kwargs
+            )
+            self.assertIsNone(np.testing.assert_array_equal(expected, decompressed_array))
+
+    def test_extended_header(self):
+        # 3D arrays with more than 2**16 elements along x need an extended header
+        c_array = np.random.rand(2, 1, 2**16 + 3)
+        compressed = zfpy.compress_numpy(c_array)
+        self.assertEqual(b"zfp", compressed[:3])
+        self.assertEqual(0x80, compressed[3] & 0x80)
+        self.assertEqual(2**16 + 3, zfpy.header(compressed)["nx"])
+        self.lossless_round_trip(c_array)
+
+        # smaller arrays keep the short header
+        compressed = zfpy.compress_numpy(c_array[:, :, :100])
+        self.assertEqual(0, compressed[3] & 0x80)
+
+        # the extended header records the chunk index, so decompression
+        # need not be told about it
+        indexed = zfpy.compress_numpy(c_array, tolerance=1e-3, chunk_index=True)
+        self.assertEqual(0x80, indexed[3] & 0x80)
+        expected = zfpy.decompress_numpy(zfpy.compress_numpy(c_array, tolerance=1e-3))
+        self.assertIsNone(np.testing.assert_array_equal(expected, zfpy.decompress_numpy(indexed)))
+        self.assertIsNone(np.testing.assert_array_equal(
+            expected, zfpy.decompress_numpy(indexed, chunk_index=True)
+        ))
+
+    def test_compress_into_buffer(self):
+        random_array = np.random.rand(23, 17, 9)
+        for mode_kwargs in [{}, {"tolerance": 1e-4}, {"rate": 12}, {"precision": 20}]:
+            expected = zfpy.compress_numpy(random_array, **mode_kwargs)
+            maxsize = zfpy.maximum_size(random_array, **mode_kwargs)
+            self.assertGreaterEqual(maxsize, len(expected))
+
+            buffers = [
+                bytearray(maxsize),
+                np.zeros(maxsize, dtype=np.uint8),
+                np.zeros(maxsize // 8 + 1, dtype=np.float64),
+                mmap.mmap(-1, maxsize),
+            ]
+            for out in buffers:
+                size = zfpy.compress_into(random_array, out, **mode_kwargs)
+                self.assertEqual(len(expected), size)
+                self.assertEqual(expected, memoryview(out).cast("B")[:size].tobytes())
+
+            # views share memory with the output buffer
+            out = bytearray(maxsize)
+            view = zfpy.compress_view(random_array, out, **mode_kwargs)
+            self.assertIs(out, view.obj)
+            self.assertEqual(expected, view.tobytes())
+            view = zfpy.compress_view(random_array, **mode_kwargs)
+            self.assertEqual(expected, view.tobytes())
+            self.assertIsNone(np.testing.assert_array_equal(
+                zfpy.decompress_numpy(expected),
+                zfpy.decompress_numpy(view),
+            ))
+
+        headerless = zfpy.compress_numpy(random_array, write_header=False)
+        view = zfpy.compress_view(random_array, write_header=False)
+        self.assertEqual(headerless, view.tobytes())
+
+    def test_compress_into_invalid_buffer(self):
+        random_array = np.random.rand(8, 8)
+        maxsize = zfpy.maximum_size(random_array)
+        with self.assertRaises(ValueError):
+            zfpy.compress_into(random_array, bytearray(maxsize - 1))
+        with self.assertRaises((BufferError, ValueError)):
+            zfpy.compress_into(random_array, bytes(maxsize))
+        with self.assertRaises(TypeError):
+            zfpy.compress_into(random_array, None)
+
+    def test_tiled_array(self):
+        random_array = np.random.rand(21, 14, 10)
+        for mode_kwargs in [{}, {"tolerance": 1e-4}, {"rate": 12}, {"precision": 20}]:
+            for threads in [0, 1, 3]:
+                tiled_array = zfpy.ZfpTiledArray(
+                    random_array, tile_shape=(8, 4, 12), threads=threads, **mode_kwargs
+                )
+                self.assertEqual(random_array.shape, tiled_array.shape)
+                self.assertEqual(random_array.dtype, tiled_array.dtype)
+                self.assertEqual((3, 4, 1), tiled_array.tiles)
+                self.assertEqual(len(tiled_array.compressed_data), tiled_array.offsets[-1])
+
+                # each tile is a headerless stream of the corresponding subarray
+                tile = random_array[8:16, 4:8, :]
+                offsets = tiled_array.offsets
+                self.assertEqual(
+                    zfpy.compress_numpy(tile, write_header=False, **mode_kwargs),
+                    tiled_array.compressed_data[offsets[5]:offsets[6]],
+                )
+
+                decompressed_array = np.asarray(tiled_array)
+                if not mode_kwargs:
+                    self.assertIsNone(np.testing.assert_array_equal(random_array, decompressed_array))
+                for key in [
+                    np.s_[3:17, 5, ::3],
+                    np.s_[::-2, 1:13:5, -1],
+                    np.s_[..., 4],
+                    np.s_[7],
+                    np.s_[8:16, 4:8],
+                    np.s_[10:10],
+                    np.s_[-3:, ::-1, 2:9:4],
+                    np.s_[2, 3, 4],
+                ]:
+                    self.assertIsNone(np.testing.assert_array_equal(
+                        decompressed_array[key], tiled_array[key]
+                    ))
+
+    def test_tiled_array_dimensions_and_types(self):
+        for dimensions in range(1, 5):
+            shape = range(6, 6 + dimensions)
+            for dtype in [np.int32, np.int64, np.float32, np.float64]:
+                random_array = (np.random.rand(*shape) * 1000).astype(dtype)
+                tiled_array = zfpy.ZfpTiledArray(random_array, tile_shape=[4] * dimensions)
+                self.assertIsNone(np.testing.assert_array_equal(random_array, tiled_array[...]))
+                key = (slice(1, None, 2),) * dimensions
+                self.assertIsNone(np.testing.assert_array_equal(random_array[key], tiled_array[key]))
+
+    def test_tiled_array_invalid_arguments(self):
+        random_array = np.random.rand(8, 8)
+        with self.assertRaises(ValueError):
+            zfpy.ZfpTiledArray(random_array, tile_shape=(6, 8))
+        with self.assertRaises(ValueError):
+            zfpy.ZfpTiledArray(random_array, tile_shape=(8,))
+        with self.assertRaises(ValueError):
+            zfpy.ZfpTiledArray(random_array, rate=8, tolerance=1e-3)
+        tiled_array = zfpy.ZfpTiledArray(random_array)
+        with self.assertRaises(IndexError):
+            tiled_array[8]
+        with self.assertRaises(IndexError):
+            tiled_array[1, 2, 3]
+        with self.assertRaises(IndexError):
+            tiled_array[[1, 2]]
+
+    def test_invalid_execution(self):
+        random_array = np.random.rand(8, 8)
+        with self.assertRaises(ValueError):
+            zfpy.compress_numpy(random_array, execution="gpu")
+        with self.assertRaises(ValueError):
+            zfpy.compress_numpy(random_array, threads=-1)
+        with self.assertRaises(ValueError):
+            zfpy.compress_numpy(random_array, execution="serial", threads=2)
+        compressed_array = zfpy.compress_numpy(random_array)
+        with self.assertRaises(ValueError):
+            zfpy.decompress_numpy(compressed_array, chunk_size=-4)
+
     def test_utils(self):
         for ndims in range(1, 5):
             for ztype, ztype_str in [
@@ -91,7 +91,7 @@ setThreadCount(struct setupVars *bundle, int param)
 }
 
 // OpenMP endtoend entry functions
-// pass doDecompress=0 because decompression not yet supported
+// variable-rate streams lack a chunk index and are decompressed serially
 // loop across 3 compression parameters
 
 // returns 0 on success, 1 on test failure
@@ -123,8 +123,19 @@ runCompressAcrossThreadsChunks(void **state, zfp_mode mode)
         printf("\t\t\tChunk size: %u blocks\n", chunkSize);
       }
 
-      int numCompressParams = (mode == zfp_mode_reversible) ? 1 : 3;
-      failures += runCompressDecompressAcrossParamsGivenMode(state, 0, mode, numCompressParams);
+      if (mode == zfp_mode_reversible) {
+        // reversible output is verified bit for bit rather than by checksum
+        if (setupCompressParam(bundle, mode, 0) == 1) {
+          failures++;
+          continue;
+        }
+        runCompressDecompressReversible(bundle, 1);
+
+        zfp_stream_rewind(bundle->stream);
+        memset(bundle->buffer, 0, bundle->bufsizeBytes);
+      } else {
+        failures += runCompressDecompressAcrossParamsGivenMode(state, 1, mode, 3);
+      }
     }
   }
 
@@ -139,12 +139,130 @@ given_withOpenMP_serialExec_when_setOmpChunkSize_expect_setToExecOmp(void **stat
 }
 
 static void
-given_withOpenMP_whenDecompressOmpPolicy_expect_noop(void **state)
+given_withOpenMP_when_setOmpZeroCopy_expect_set(void **state)
 {
   struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  assert_int_equal(zfp_stream_omp_zero_copy(stream), zfp_false);
 
-  assert_int_equal(zfp_decompress(bundle->stream, bundle->field), 0);
-  assert_int_equal(stream_size(bundle->bs), bundle->streamSize);
+  assert_int_equal(zfp_stream_set_omp_zero_copy(stream, zfp_true), 1);
+  assert_int_equal(zfp_stream_omp_zero_copy(stream), zfp_true);
+  assert_int_equal(zfp_stream_execution(stream), zfp_exec_omp);
+}
+
+static void
+given_withOpenMP_when_setOmpDynamic_expect_set(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  assert_int_equal(zfp_stream_omp_dynamic(stream), zfp_false);
+
+  assert_int_equal(zfp_stream_set_omp_dynamic(stream, zfp_true), 1);
+  assert_int_equal(zfp_stream_omp_dynamic(stream), zfp_true);
+  assert_int_equal(zfp_stream_execution(stream), zfp_exec_omp);
+}
+
+static void
+given_withOpenMP_when_compressWithTimings_expect_timingsRecorded(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  double timings[4] = { -1, -1, -1, -1 };
+  int32 data[9] = { 0 };
+  zfp_field* field = zfp_field_1d(data, zfp_type_int32, 9);
+  size_t bufferSize = zfp_stream_maximum_size(stream, field);
+  void* buffer = malloc(bufferSize);
+  bitstream* bs = stream_open(buffer, bufferSize);
+  size_t chunk;
+
+  zfp_stream_set_bit_stream(stream, bs);
+  assert_int_equal(zfp_stream_set_omp_chunk_size(stream, 1), 1);
+  assert_int_equal(zfp_stream_set_omp_dynamic(stream, zfp_true), 1);
+  assert_int_equal(zfp_stream_set_omp_timings(stream, timings, 4), 1);
+
+  assert_int_not_equal(zfp_compress(stream, field), 0);
+
+  /* 9 values form 3 single-block chunks; remaining entry is zeroed */
+  for (chunk = 0; chunk < 3; chunk++)
+    assert_true(timings[chunk] >= 0);
+  assert_true(timings[3] == 0);
+
+  zfp_field_free(field);
+  stream_close(bs);
+  free(buffer);
+}
+
+static void
+given_withOpenMP_when_setChunkIndex_expect_set(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  assert_int_equal(zfp_stream_chunk_index(stream), zfp_false);
+
+  zfp_stream_set_chunk_index(stream, zfp_true);
+  assert_int_equal(zfp_stream_chunk_index(stream), zfp_true);
+
+  assert_int_equal(zfp_stream_set_execution(stream, zfp_exec_omp), 1);
+  assert_int_equal(zfp_stream_chunk_index(stream), zfp_true);
+}
+
+/* overwrite number of chunks recorded at start of chunk index */
+static void
+setChunkCount(void* buffer, size_t bufferSize, uint64 chunks)
+{
+  bitstream* bs = stream_open(buffer, bufferSize);
+  stream_write_bits(bs, chunks, 64);
+  stream_flush(bs);
+  stream_close(bs);
+}
+
+static void
+given_withOpenMP_corruptChunkCount_when_decompress_expect_failure(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  int32 data[64];
+  zfp_field* field = zfp_field_1d(data, zfp_type_int32, 64);
+  size_t bufferSize;
+  void* buffer;
+  bitstream* bs;
+  size_t i;
+
+  for (i = 0; i < 64; i++)
+    data[i] = (int32)(i * i);
+  zfp_stream_set_reversible(stream);
+  zfp_stream_set_chunk_index(stream, zfp_true);
+  assert_int_equal(zfp_stream_set_omp_chunk_size(stream, 1), 1);
+  bufferSize = zfp_stream_maximum_size(stream, field);
+  buffer = malloc(bufferSize);
+  bs = stream_open(buffer, bufferSize);
+  zfp_stream_set_bit_stream(stream, bs);
+  assert_int_not_equal(zfp_compress(stream, field), 0);
+
+  /* 64 values form 16 single-block chunks */
+  zfp_stream_rewind(stream);
+  assert_int_not_equal(zfp_decompress(stream, field), 0);
+  assert_int_equal(data[63], 63 * 63);
+
+  /* no chunks, more chunks than blocks, and a count that would overflow */
+  setChunkCount(buffer, bufferSize, 0);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, field), 0);
+  setChunkCount(buffer, bufferSize, 17);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, field), 0);
+  setChunkCount(buffer, bufferSize, ~(uint64)0);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, field), 0);
+
+  /* serial decompression rejects corrupt index too */
+  assert_int_equal(zfp_stream_set_execution(stream, zfp_exec_serial), 1);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, field), 0);
+
+  zfp_field_free(field);
+  stream_close(bs);
+  free(buffer);
 }
 
 #else
@@ -166,6 +284,7 @@ given_withoutOpenMP_when_setOmpParams_expect_unableTo(void **state)
 
   assert_int_equal(zfp_stream_set_omp_threads(stream, 5), 0);
   assert_int_equal(zfp_stream_set_omp_chunk_size(stream, 0x200u), 0);
+  assert_int_equal(zfp_stream_set_omp_dynamic(stream, zfp_true), 0);
 
   assert_int_equal(zfp_stream_execution(stream), zfp_exec_serial);
 }
@@ -199,8 +318,11 @@ int main()
     cmocka_unit_test_setup_teardown(given_withOpenMP_serialExec_when_setOmpThreads_expect_setToExecOmp, setup, teardown),
     cmocka_unit_test_setup_teardown(given_withOpenMP_when_setOmpChunkSize_expect_set, setup, teardown),
     cmocka_unit_test_setup_teardown(given_withOpenMP_serialExec_when_setOmpChunkSize_expect_setToExecOmp, setup, teardown),
-
-    cmocka_unit_test_setup_teardown(given_withOpenMP_whenDecompressOmpPolicy_expect_noop, setupForCompress, teardownForCompress),
+    cmocka_unit_test_setup_teardown(given_withOpenMP_when_setOmpZeroCopy_expect_set, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_withOpenMP_when_setOmpDynamic_expect_set, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_withOpenMP_when_compressWithTimings_expect_timingsRecorded, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_withOpenMP_when_setChunkIndex_expect_set, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_withOpenMP_corruptChunkCount_when_decompress_expect_failure, setup, teardown),
 #else
     cmocka_unit_test_setup_teardown(given_withoutOpenMP_when_setExecutionOmp_expect_unableTo, setup, teardown),
     cmocka_unit_test_setup_teardown(given_withoutOpenMP_when_setOmpParams_expect_unableTo, setup, teardown),
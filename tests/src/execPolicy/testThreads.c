@@ -0,0 +1,172 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 1003
+
+struct setupVars {
+  zfp_stream* stream;
+  zfp_field* field;
+  bitstream* bs;
+  void* buffer;
+  size_t bufferSize;
+  double* data;
+  double* result;
+};
+
+/* scheduler that runs tasks in reverse order to expose ordering dependencies */
+static void
+reverseParallelFor(void* context, size_t count, zfp_task task, void* data)
+{
+  size_t* calls = context;
+  size_t i;
+
+  (*calls)++;
+  for (i = count; i-- > 0;)
+    task(data, i);
+}
+
+static int
+setup(void **state)
+{
+  struct setupVars *bundle = malloc(sizeof(struct setupVars));
+  assert_non_null(bundle);
+
+  bundle->stream = zfp_stream_open(NULL);
+  *state = bundle;
+
+  return 0;
+}
+
+static int
+teardown(void **state)
+{
+  struct setupVars *bundle = *state;
+
+  zfp_stream_close(bundle->stream);
+  free(bundle);
+
+  return 0;
+}
+
+static int
+setupForCompress(void **state)
+{
+  if (setup(state))
+    return 1;
+
+  struct setupVars *bundle = *state;
+  size_t i;
+
+  bundle->data = malloc(NX * sizeof(double));
+  bundle->result = malloc(NX * sizeof(double));
+  assert_non_null(bundle->data);
+  assert_non_null(bundle->result);
+  for (i = 0; i < NX; i++)
+    bundle->data[i] = (double)(i % 17) - 0.25 * (double)(i % 5);
+
+  bundle->field = zfp_field_1d(bundle->data, zfp_type_double, NX);
+  assert_non_null(bundle->field);
+
+  zfp_stream_set_accuracy(bundle->stream, 1e-3);
+  bundle->bufferSize = 2 * zfp_stream_maximum_size(bundle->stream, bundle->field);
+  bundle->buffer = calloc(bundle->bufferSize, 1);
+  assert_non_null(bundle->buffer);
+  bundle->bs = stream_open(bundle->buffer, bundle->bufferSize);
+  zfp_stream_set_bit_stream(bundle->stream, bundle->bs);
+
+  return 0;
+}
+
+static int
+teardownForCompress(void **state)
+{
+  struct setupVars *bundle = *state;
+
+  zfp_field_free(bundle->field);
+  stream_close(bundle->bs);
+  free(bundle->buffer);
+  free(bundle->data);
+  free(bundle->result);
+
+  return teardown(state);
+}
+
+static void
+when_setExecutionThreads_expect_set(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  assert_int_equal(zfp_stream_set_execution(stream, zfp_exec_threads), 1);
+  assert_int_equal(zfp_stream_execution(stream), zfp_exec_threads);
+  assert_int_equal(zfp_stream_thread_count(stream), 0);
+  assert_int_equal(zfp_stream_thread_chunk_size(stream), 0);
+}
+
+static void
+given_serialExec_when_setThreadParams_expect_setToExecThreads(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  assert_int_equal(zfp_stream_execution(stream), zfp_exec_serial);
+
+  assert_int_equal(zfp_stream_set_thread_count(stream, 6), 1);
+  assert_int_equal(zfp_stream_execution(stream), zfp_exec_threads);
+  assert_int_equal(zfp_stream_set_thread_chunk_size(stream, 0x200u), 1);
+  assert_int_equal(zfp_stream_set_thread_scheduler(stream, NULL, NULL), 1);
+
+  assert_int_equal(zfp_stream_thread_count(stream), 6);
+  assert_int_equal(zfp_stream_thread_chunk_size(stream), 0x200u);
+}
+
+static void
+given_serialCompressed_when_decompressWithScheduler_expect_sameResult(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  size_t calls = 0;
+  size_t size;
+  double* expected = malloc(NX * sizeof(double));
+  assert_non_null(expected);
+
+  /* serial reference with chunk index */
+  zfp_stream_set_chunk_index(stream, zfp_true);
+  size = zfp_compress(stream, bundle->field);
+  assert_int_not_equal(size, 0);
+  zfp_stream_rewind(stream);
+  zfp_field_set_pointer(bundle->field, expected);
+  assert_int_equal(zfp_decompress(stream, bundle->field), size);
+
+  /* compress and decompress via scheduler */
+  zfp_stream_set_thread_count(stream, 4);
+  zfp_stream_set_thread_chunk_size(stream, 7);
+  zfp_stream_set_thread_scheduler(stream, reverseParallelFor, &calls);
+  zfp_stream_rewind(stream);
+  zfp_field_set_pointer(bundle->field, bundle->data);
+  size = zfp_compress(stream, bundle->field);
+  assert_int_not_equal(size, 0);
+  zfp_stream_rewind(stream);
+  zfp_field_set_pointer(bundle->field, bundle->result);
+  assert_int_equal(zfp_decompress(stream, bundle->field), size);
+
+  assert_int_equal(calls, 2);
+  assert_memory_equal(bundle->result, expected, NX * sizeof(double));
+  free(expected);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(when_setExecutionThreads_expect_set, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_serialExec_when_setThreadParams_expect_setToExecThreads, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_serialCompressed_when_decompressWithScheduler_expect_sameResult, setupForCompress, teardownForCompress),
+  };
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
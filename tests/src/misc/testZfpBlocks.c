@@ -0,0 +1,184 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCKS 37
+#define BLOCK_SIZE 64
+
+struct setupVars {
+  zfp_stream* stream;
+  bitstream* bs;
+  void* buffer;
+  size_t bufferSize;
+  float* data;
+  float* result;
+};
+
+static int
+setup(void **state)
+{
+  struct setupVars *bundle = malloc(sizeof(struct setupVars));
+  size_t i;
+  assert_non_null(bundle);
+
+  bundle->data = malloc(BLOCKS * BLOCK_SIZE * sizeof(float));
+  bundle->result = malloc(BLOCKS * BLOCK_SIZE * sizeof(float));
+  assert_non_null(bundle->data);
+  assert_non_null(bundle->result);
+  for (i = 0; i < BLOCKS * BLOCK_SIZE; i++)
+    bundle->data[i] = (float)(i % 13) - 0.125f * (float)(i % 7);
+
+  bundle->stream = zfp_stream_open(NULL);
+  zfp_stream_set_precision(bundle->stream, 20);
+  bundle->bufferSize = 2 * BLOCKS * BLOCK_SIZE * sizeof(float) + 0x100;
+  bundle->buffer = calloc(bundle->bufferSize, 1);
+  assert_non_null(bundle->buffer);
+  bundle->bs = stream_open(bundle->buffer, bundle->bufferSize);
+  zfp_stream_set_bit_stream(bundle->stream, bundle->bs);
+
+  *state = bundle;
+
+  return 0;
+}
+
+static int
+teardown(void **state)
+{
+  struct setupVars *bundle = *state;
+
+  zfp_stream_close(bundle->stream);
+  stream_close(bundle->bs);
+  free(bundle->buffer);
+  free(bundle->data);
+  free(bundle->result);
+  free(bundle);
+
+  return 0;
+}
+
+static void
+when_encodeBlocks_expect_sameBitsAsEncodeBlock(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  unsigned char* expected = calloc(bundle->bufferSize, 1);
+  const float* block[BLOCKS];
+  size_t bits = 0;
+  size_t i;
+  assert_non_null(expected);
+
+  /* reference: one block at a time */
+  for (i = 0; i < BLOCKS; i++)
+    bits += zfp_encode_block_float_3(stream, bundle->data + BLOCK_SIZE * i);
+  zfp_stream_flush(stream);
+  memcpy(expected, bundle->buffer, bundle->bufferSize);
+
+  /* contiguous blocks */
+  memset(bundle->buffer, 0, bundle->bufferSize);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_encode_blocks_float_3(stream, bundle->data, BLOCKS), bits);
+  zfp_stream_flush(stream);
+  assert_memory_equal(bundle->buffer, expected, bundle->bufferSize);
+
+  /* blocks via indirection */
+  for (i = 0; i < BLOCKS; i++)
+    block[i] = bundle->data + BLOCK_SIZE * i;
+  memset(bundle->buffer, 0, bundle->bufferSize);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_encode_blocks_indirect_float_3(stream, block, BLOCKS), bits);
+  zfp_stream_flush(stream);
+  assert_memory_equal(bundle->buffer, expected, bundle->bufferSize);
+
+  free(expected);
+}
+
+static void
+when_decodeBlocks_expect_sameValuesAsDecodeBlock(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  float* expected = malloc(BLOCKS * BLOCK_SIZE * sizeof(float));
+  float* block[BLOCKS];
+  size_t bits;
+  size_t i;
+  assert_non_null(expected);
+
+  bits = zfp_encode_blocks_float_3(stream, bundle->data, BLOCKS);
+  zfp_stream_flush(stream);
+
+  zfp_stream_rewind(stream);
+  for (i = 0; i < BLOCKS; i++)
+    zfp_decode_block_float_3(stream, expected + BLOCK_SIZE * i);
+
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decode_blocks_float_3(stream, bundle->result, BLOCKS), bits);
+  assert_memory_equal(bundle->result, expected, BLOCKS * BLOCK_SIZE * sizeof(float));
+
+  for (i = 0; i < BLOCKS; i++)
+    block[i] = bundle->result + BLOCK_SIZE * i;
+  memset(bundle->result, 0, BLOCKS * BLOCK_SIZE * sizeof(float));
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decode_blocks_indirect_float_3(stream, block, BLOCKS), bits);
+  assert_memory_equal(bundle->result, expected, BLOCKS * BLOCK_SIZE * sizeof(float));
+
+  free(expected);
+}
+
+static void
+given_threadsExec_when_compressBlocks_expect_sameValuesAsSerial(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  float* expected = malloc(BLOCKS * BLOCK_SIZE * sizeof(float));
+  size_t bits;
+  assert_non_null(expected);
+
+  /* serial reference */
+  bits = zfp_compress_blocks(stream, zfp_type_float, 3, bundle->data, BLOCKS);
+  assert_int_not_equal(bits, 0);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress_blocks(stream, zfp_type_float, 3, expected, BLOCKS), bits);
+
+  /* chunked compression under thread pool policy */
+  zfp_stream_set_thread_chunk_size(stream, 5);
+  zfp_stream_set_chunk_index(stream, zfp_true);
+  zfp_stream_rewind(stream);
+  bits = zfp_compress_blocks(stream, zfp_type_float, 3, bundle->data, BLOCKS);
+  assert_int_not_equal(bits, 0);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress_blocks(stream, zfp_type_float, 3, bundle->result, BLOCKS), bits);
+
+  assert_memory_equal(bundle->result, expected, BLOCKS * BLOCK_SIZE * sizeof(float));
+  free(expected);
+}
+
+static void
+when_compressBlocksInvalidArgs_expect_zero(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  assert_int_equal(zfp_compress_blocks(stream, zfp_type_float, 0, bundle->data, BLOCKS), 0);
+  assert_int_equal(zfp_compress_blocks(stream, zfp_type_float, 5, bundle->data, BLOCKS), 0);
+  assert_int_equal(zfp_compress_blocks(stream, zfp_type_none, 3, bundle->data, BLOCKS), 0);
+  assert_int_equal(zfp_compress_blocks(stream, zfp_type_float, 3, bundle->data, 0), 0);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(when_encodeBlocks_expect_sameBitsAsEncodeBlock, setup, teardown),
+    cmocka_unit_test_setup_teardown(when_decodeBlocks_expect_sameValuesAsDecodeBlock, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_threadsExec_when_compressBlocks_expect_sameValuesAsSerial, setup, teardown),
+    cmocka_unit_test_setup_teardown(when_compressBlocksInvalidArgs_expect_zero, setup, teardown),
+  };
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,154 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#define NX 45
+#define NY 38
+#define NZ 33
+
+struct setupVars {
+  zfp_stream* stream;
+  zfp_field* field;
+  void* buffer;
+  size_t bufferSize;
+  double* data;
+};
+
+static int
+setup(void **state)
+{
+  struct setupVars *bundle = malloc(sizeof(struct setupVars));
+  size_t x, y, z;
+  assert_non_null(bundle);
+
+  bundle->data = malloc(NX * NY * NZ * sizeof(double));
+  assert_non_null(bundle->data);
+  for (z = 0; z < NZ; z++)
+    for (y = 0; y < NY; y++)
+      for (x = 0; x < NX; x++)
+        bundle->data[x + NX * (y + NY * z)] = sin(0.3 * (double)x) * cos(0.2 * (double)y) + 0.01 * (double)(x * z % 17);
+
+  bundle->field = zfp_field_3d(bundle->data, zfp_type_double, NX, NY, NZ);
+  bundle->stream = zfp_stream_open(NULL);
+  zfp_stream_set_accuracy(bundle->stream, 1e-6);
+  bundle->bufferSize = zfp_stream_maximum_size(bundle->stream, bundle->field);
+  bundle->buffer = malloc(bundle->bufferSize);
+  assert_non_null(bundle->buffer);
+
+  *state = bundle;
+
+  return 0;
+}
+
+static int
+teardown(void **state)
+{
+  struct setupVars *bundle = *state;
+
+  zfp_stream_close(bundle->stream);
+  zfp_field_free(bundle->field);
+  free(bundle->buffer);
+  free(bundle->data);
+  free(bundle);
+
+  return 0;
+}
+
+/* byte size of stream produced by zfp_compress() */
+static size_t
+compressedSize(struct setupVars *bundle)
+{
+  bitstream* s = stream_open(bundle->buffer, bundle->bufferSize);
+  size_t size;
+  zfp_stream_set_bit_stream(bundle->stream, s);
+  zfp_stream_rewind(bundle->stream);
+  size = zfp_compress(bundle->stream, bundle->field);
+  zfp_stream_set_bit_stream(bundle->stream, NULL);
+  stream_close(s);
+  return size;
+}
+
+static void
+given_allBlocksSampled_when_estimateSize_expect_compressedSize(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  /* variable-rate modes */
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), compressedSize(bundle));
+  zfp_stream_set_precision(stream, 21);
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), compressedSize(bundle));
+  zfp_stream_set_reversible(stream);
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), compressedSize(bundle));
+
+  /* fixed-rate mode requires no encoding */
+  zfp_stream_set_rate(stream, 11, zfp_type_double, 3, zfp_false);
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 0.01), compressedSize(bundle));
+
+  /* strided field traversed in reverse along x */
+  zfp_field_set_pointer(bundle->field, bundle->data + NX - 1);
+  zfp_field_set_stride_3d(bundle->field, -1, NX, NX * NY);
+  zfp_stream_set_accuracy(stream, 1e-3);
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), compressedSize(bundle));
+}
+
+static void
+given_chunkIndex_when_estimateSize_expect_compressedSize(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  zfp_stream_set_chunk_index(stream, zfp_true);
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), compressedSize(bundle));
+
+  /* parallel estimate matches parallel compression */
+  if (zfp_stream_set_execution(stream, zfp_exec_omp)) {
+    assert_true(zfp_stream_set_omp_threads(stream, 3));
+    assert_true(zfp_stream_set_omp_chunk_size(stream, 7));
+    assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), compressedSize(bundle));
+  }
+}
+
+static void
+given_sampledBlocks_when_estimateSize_expect_closeToCompressedSize(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  double size = (double)compressedSize(bundle);
+  size_t estimate = zfp_compressed_size_estimate(stream, bundle->field, 0.25);
+
+  assert_true(fabs((double)estimate - size) < 0.1 * size);
+  /* sampling is reproducible */
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 0.25), estimate);
+  /* at least one block is sampled */
+  assert_int_not_equal(zfp_compressed_size_estimate(stream, bundle->field, 1e-9), 0);
+}
+
+static void
+given_invalidArguments_when_estimateSize_expect_zero(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 0), 0);
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, -0.5), 0);
+  bundle->field->type = zfp_type_none;
+  assert_int_equal(zfp_compressed_size_estimate(stream, bundle->field, 1), 0);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(given_allBlocksSampled_when_estimateSize_expect_compressedSize, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_chunkIndex_when_estimateSize_expect_compressedSize, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_sampledBlocks_when_estimateSize_expect_closeToCompressedSize, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_invalidArguments_when_estimateSize_expect_zero, setup, teardown),
+  };
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
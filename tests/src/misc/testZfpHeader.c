@@ -451,6 +451,112 @@ given_invalidCompressParamsInHeader_when_zfpReadHeaderMode_expect_streamParamsNo
   assertCompressParamsBehaviorWhenReadHeader(state, ZFP_MODE_LONG_BITS, 0);
 }
 
+static void
+given_largeField_when_zfpWriteHeaderExtended_expect_roundTripOfSizesAndParams(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  zfp_field* field = bundle->field;
+
+  // dimensions too large for 52-bit metadata
+  zfp_field_set_size_2d(field, (size_t)1 << 30, 3);
+  assert_int_equal(zfp_write_header(stream, field, ZFP_HEADER_FULL), 0);
+
+  // magic + metadata + 2 x 64-bit sizes + mode + checksum, padded to 64 bits
+  size_t bits = zfp_write_header(stream, field, ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED);
+  assert_int_equal(bits, 256);
+  assert_true(bits <= ZFP_HEADER_EXT_MAX_BITS);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+
+  uint64 mode = zfp_stream_mode(stream);
+  zfp_field* readField = zfp_field_alloc();
+  assert_int_equal(zfp_stream_set_params(stream, ZFP_MIN_BITS, ZFP_MAX_BITS, ZFP_MAX_PREC, ZFP_MIN_EXP), 1);
+  assert_int_equal(zfp_read_header(stream, readField, ZFP_HEADER_FULL), bits);
+  assert_int_equal(zfp_stream_mode(stream), mode);
+  assert_int_equal(readField->type, ZFP_TYPE);
+  assert_int_equal(zfp_field_dimensionality(readField), 2);
+  assert_int_equal(readField->nx, (size_t)1 << 30);
+  assert_int_equal(readField->ny, 3);
+  zfp_field_free(readField);
+}
+
+static void
+given_extendedHeaderInfo_when_zfpReadHeaderExt_expect_stridesAndIndexSet(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  zfp_field* field = bundle->field;
+
+  zfp_header_ext ext = { 0 };
+  ext.sx = -1;
+  ext.sy = FIELD_X_LEN;
+  ext.index_offset = 4096;
+  ext.index_size = 800;
+
+  // info requires extended header
+  assert_int_equal(zfp_write_header_ext(stream, field, ZFP_HEADER_FULL, &ext), 0);
+  size_t bits = zfp_write_header_ext(stream, field, ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED, &ext);
+  // 2 sizes, 2 strides, and index offset and size add 6 x 64 bits
+  assert_int_equal(bits, 512);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+
+  zfp_header_ext readExt;
+  zfp_field* readField = zfp_field_alloc();
+  assert_int_equal(zfp_read_header_ext(stream, readField, ZFP_HEADER_FULL, &readExt), bits);
+  assert_int_equal(readField->nx, FIELD_X_LEN);
+  assert_int_equal(readField->ny, FIELD_Y_LEN);
+  assert_int_equal(readExt.sx, -1);
+  assert_int_equal(readExt.sy, FIELD_X_LEN);
+  assert_int_equal(readExt.sz, 0);
+  assert_int_equal(readExt.index_offset, 4096);
+  assert_int_equal(readExt.index_size, 800);
+  zfp_field_free(readField);
+}
+
+static void
+given_corruptExtendedHeader_when_zfpReadHeader_expect_returnsZeroAndFieldNotSet(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  zfp_field* field = bundle->field;
+
+  size_t bits = zfp_write_header(stream, field, ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED);
+  assert_int_not_equal(bits, 0);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+
+  // flip one bit of the x dimension
+  ((uchar*)bundle->buffer)[6] ^= 0x10u;
+
+  zfp_field* readField = zfp_field_alloc();
+  assert_int_equal(zfp_read_header(stream, readField, ZFP_HEADER_FULL), 0);
+  assert_int_equal(readField->nx, 0);
+  zfp_field_free(readField);
+}
+
+static void
+given_shortHeader_when_zfpReadHeaderExt_expect_shortHeaderReadAndExtCleared(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  zfp_field* field = bundle->field;
+
+  assert_int_equal(zfp_write_header(stream, field, ZFP_HEADER_FULL), ZFP_MAGIC_BITS + ZFP_META_BITS + ZFP_MODE_SHORT_BITS);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+
+  zfp_header_ext ext;
+  ext.index_size = 1;
+  zfp_field* readField = zfp_field_alloc();
+  // magic overrides requested header variant
+  assert_int_equal(zfp_read_header_ext(stream, readField, ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED, &ext), ZFP_MAGIC_BITS + ZFP_META_BITS + ZFP_MODE_SHORT_BITS);
+  assert_int_equal(readField->nx, FIELD_X_LEN);
+  assert_int_equal(ext.index_size, 0);
+  zfp_field_free(readField);
+}
+
 int main()
 {
   const struct CMUnitTest tests[] = {
@@ -492,6 +598,12 @@ int main()
     cmocka_unit_test_setup_teardown(given_customCompressParamsAndProperHeader_when_zfpReadHeaderMode_expect_streamParamsSet, setup, teardown),
     cmocka_unit_test_setup_teardown(given_invalidCompressParamsInHeader_when_zfpReadHeaderMode_expect_properNumBitsRead, setup, teardown),
     cmocka_unit_test_setup_teardown(given_invalidCompressParamsInHeader_when_zfpReadHeaderMode_expect_streamParamsNotSet, setup, teardown),
+
+    // extended header
+    cmocka_unit_test_setup_teardown(given_largeField_when_zfpWriteHeaderExtended_expect_roundTripOfSizesAndParams, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_extendedHeaderInfo_when_zfpReadHeaderExt_expect_stridesAndIndexSet, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_corruptExtendedHeader_when_zfpReadHeader_expect_returnsZeroAndFieldNotSet, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_shortHeader_when_zfpReadHeaderExt_expect_shortHeaderReadAndExtCleared, setup, teardown),
   };
   return cmocka_run_group_tests(tests, NULL, NULL);
 }
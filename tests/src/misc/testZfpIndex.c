@@ -0,0 +1,181 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 23
+#define NY 18
+#define NZ 13
+
+struct setupVars {
+  zfp_stream* stream;
+  zfp_field* field;
+  bitstream* bs;
+  void* buffer;
+  size_t bufferSize;
+  double* data;
+  double* result;
+  size_t compressedSize;
+};
+
+static int
+setupIndex(void **state, zfp_index_type type)
+{
+  struct setupVars *bundle = malloc(sizeof(struct setupVars));
+  size_t i;
+  assert_non_null(bundle);
+
+  bundle->data = malloc(NX * NY * NZ * sizeof(double));
+  bundle->result = malloc(NX * NY * NZ * sizeof(double));
+  assert_non_null(bundle->data);
+  assert_non_null(bundle->result);
+  for (i = 0; i < NX * NY * NZ; i++)
+    bundle->data[i] = (double)(i % 29) - 0.375 * (double)(i % 11);
+
+  bundle->field = zfp_field_3d(bundle->data, zfp_type_double, NX, NY, NZ);
+  bundle->stream = zfp_stream_open(NULL);
+  zfp_stream_set_accuracy(bundle->stream, 1e-3);
+  bundle->bufferSize = zfp_stream_maximum_size(bundle->stream, bundle->field);
+  bundle->buffer = calloc(bundle->bufferSize, 1);
+  assert_non_null(bundle->buffer);
+  bundle->bs = stream_open(bundle->buffer, bundle->bufferSize);
+  zfp_stream_set_bit_stream(bundle->stream, bundle->bs);
+
+  /* compress with index and decompress whole field for reference */
+  zfp_stream_set_index(bundle->stream, zfp_index_create(type));
+  assert_non_null(zfp_stream_index(bundle->stream));
+  bundle->compressedSize = zfp_compress(bundle->stream, bundle->field);
+  assert_int_not_equal(bundle->compressedSize, 0);
+  zfp_stream_rewind(bundle->stream);
+  zfp_field_set_pointer(bundle->field, bundle->result);
+  assert_int_equal(zfp_decompress(bundle->stream, bundle->field), bundle->compressedSize);
+
+  *state = bundle;
+
+  return 0;
+}
+
+static int
+setupVerbatim(void **state)
+{
+  return setupIndex(state, zfp_index_verbatim);
+}
+
+static int
+setupHybrid4(void **state)
+{
+  return setupIndex(state, zfp_index_hybrid4);
+}
+
+static int
+setupHybrid8(void **state)
+{
+  return setupIndex(state, zfp_index_hybrid8);
+}
+
+static int
+teardown(void **state)
+{
+  struct setupVars *bundle = *state;
+
+  zfp_index_free(zfp_stream_index(bundle->stream));
+  zfp_stream_close(bundle->stream);
+  zfp_field_free(bundle->field);
+  stream_close(bundle->bs);
+  free(bundle->buffer);
+  free(bundle->data);
+  free(bundle->result);
+  free(bundle);
+
+  return 0;
+}
+
+/* decompress box with given origin and sizes and compare with reference */
+static void
+assertBoxMatches(struct setupVars *bundle, const zfp_index* index, size_t x0, size_t y0, size_t z0, size_t nx, size_t ny, size_t nz)
+{
+  double* box = malloc(nx * ny * nz * sizeof(double));
+  zfp_field* field = zfp_field_3d(box, zfp_type_double, nx, ny, nz);
+  size_t x, y, z;
+  assert_non_null(box);
+
+  zfp_stream_rewind(bundle->stream);
+  assert_int_not_equal(zfp_decompress_box(bundle->stream, index, field, x0, y0, z0, 0), 0);
+  assert_int_equal(zfp_stream_compressed_size(bundle->stream), bundle->compressedSize);
+
+  for (z = 0; z < nz; z++)
+    for (y = 0; y < ny; y++)
+      for (x = 0; x < nx; x++)
+        assert_true(box[x + nx * (y + ny * z)] == bundle->result[(x0 + x) + NX * ((y0 + y) + NY * (z0 + z))]);
+
+  zfp_field_free(field);
+  free(box);
+}
+
+static void
+given_index_when_decompressBox_expect_valuesMatchDecompress(void **state)
+{
+  struct setupVars *bundle = *state;
+  const zfp_index* index = zfp_stream_index(bundle->stream);
+
+  assertBoxMatches(bundle, index, 0, 0, 0, NX, NY, NZ);
+  assertBoxMatches(bundle, index, 4, 8, 4, 8, 4, 4);
+  assertBoxMatches(bundle, index, 5, 3, 2, 17, 9, 11);
+  assertBoxMatches(bundle, index, 22, 17, 12, 1, 1, 1);
+}
+
+static void
+given_serializedIndex_when_decompressBox_expect_valuesMatchDecompress(void **state)
+{
+  struct setupVars *bundle = *state;
+  const zfp_index* index = zfp_stream_index(bundle->stream);
+  size_t size = zfp_index_size(index);
+  void* buffer = malloc(size);
+  zfp_index* copy;
+  assert_int_not_equal(size, 0);
+  assert_non_null(buffer);
+
+  assert_int_equal(zfp_index_write(index, buffer, size - 1), 0);
+  assert_int_equal(zfp_index_write(index, buffer, size), size);
+  copy = zfp_index_read(buffer, size);
+  assert_non_null(copy);
+
+  assertBoxMatches(bundle, copy, 3, 1, 6, 19, 15, 7);
+
+  zfp_index_free(copy);
+  free(buffer);
+}
+
+static void
+given_index_when_decompressBoxOutOfBounds_expect_zero(void **state)
+{
+  struct setupVars *bundle = *state;
+  const zfp_index* index = zfp_stream_index(bundle->stream);
+  zfp_field* field = zfp_field_3d(bundle->result, zfp_type_double, 8, 8, 8);
+  zfp_field* field2d = zfp_field_2d(bundle->result, zfp_type_double, 8, 8);
+
+  zfp_stream_rewind(bundle->stream);
+  assert_int_equal(zfp_decompress_box(bundle->stream, index, field, 16, 0, 0, 0), 0);
+  assert_int_equal(zfp_decompress_box(bundle->stream, index, field, 0, 0, 6, 0), 0);
+  assert_int_equal(zfp_decompress_box(bundle->stream, index, field2d, 0, 0, 0, 0), 0);
+
+  zfp_field_free(field2d);
+  zfp_field_free(field);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(given_index_when_decompressBox_expect_valuesMatchDecompress, setupVerbatim, teardown),
+    cmocka_unit_test_setup_teardown(given_index_when_decompressBox_expect_valuesMatchDecompress, setupHybrid4, teardown),
+    cmocka_unit_test_setup_teardown(given_index_when_decompressBox_expect_valuesMatchDecompress, setupHybrid8, teardown),
+    cmocka_unit_test_setup_teardown(given_serializedIndex_when_decompressBox_expect_valuesMatchDecompress, setupHybrid4, teardown),
+    cmocka_unit_test_setup_teardown(given_index_when_decompressBoxOutOfBounds_expect_zero, setupVerbatim, teardown),
+  };
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,122 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 21
+#define NY 14
+#define NZ 19
+
+struct setupVars {
+  zfp_stream* stream;
+  zfp_field* field;
+  bitstream* bs;
+  void* buffer;
+  void* expected;
+  size_t bufferSize;
+  size_t expectedSize;
+  float* data;
+};
+
+static int
+setup(void **state)
+{
+  struct setupVars *bundle = malloc(sizeof(struct setupVars));
+  size_t i;
+  assert_non_null(bundle);
+
+  bundle->data = malloc(NX * NY * NZ * sizeof(float));
+  assert_non_null(bundle->data);
+  for (i = 0; i < NX * NY * NZ; i++)
+    bundle->data[i] = (float)(i % 31) - 0.625f * (float)(i % 13);
+
+  bundle->field = zfp_field_3d(bundle->data, zfp_type_float, NX, NY, NZ);
+  bundle->stream = zfp_stream_open(NULL);
+  zfp_stream_set_accuracy(bundle->stream, 1e-2);
+  bundle->bufferSize = zfp_stream_maximum_size(bundle->stream, bundle->field);
+  bundle->buffer = calloc(bundle->bufferSize, 1);
+  bundle->expected = calloc(bundle->bufferSize, 1);
+  assert_non_null(bundle->buffer);
+  assert_non_null(bundle->expected);
+
+  /* reference stream compressed in one call */
+  bundle->bs = stream_open(bundle->expected, bundle->bufferSize);
+  zfp_stream_set_bit_stream(bundle->stream, bundle->bs);
+  bundle->expectedSize = zfp_compress(bundle->stream, bundle->field);
+  assert_int_not_equal(bundle->expectedSize, 0);
+  stream_close(bundle->bs);
+
+  bundle->bs = stream_open(bundle->buffer, bundle->bufferSize);
+  zfp_stream_set_bit_stream(bundle->stream, bundle->bs);
+
+  *state = bundle;
+
+  return 0;
+}
+
+static int
+teardown(void **state)
+{
+  struct setupVars *bundle = *state;
+
+  zfp_stream_close(bundle->stream);
+  zfp_field_free(bundle->field);
+  stream_close(bundle->bs);
+  free(bundle->buffer);
+  free(bundle->expected);
+  free(bundle->data);
+  free(bundle);
+
+  return 0;
+}
+
+static void
+when_appendSlabs_expect_sameStreamAsCompress(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  size_t z;
+
+  assert_true(zfp_stream_begin(stream, bundle->field));
+  /* slabs of 8, 4, and 4 planes followed by final partial slab of 3 planes */
+  assert_int_not_equal(zfp_stream_append_slab(stream, bundle->data, 8), 0);
+  for (z = 8; z < 16; z += 4)
+    assert_int_not_equal(zfp_stream_append_slab(stream, bundle->data + NX * NY * z, 4), 0);
+  assert_int_not_equal(zfp_stream_append_slab(stream, bundle->data + NX * NY * z, NZ - z), 0);
+  assert_int_equal(zfp_stream_end(stream), bundle->expectedSize);
+
+  assert_memory_equal(bundle->buffer, bundle->expected, bundle->expectedSize);
+}
+
+static void
+when_appendInvalidSlab_expect_zero(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  /* no slab may be appended before zfp_stream_begin() */
+  assert_int_equal(zfp_stream_append_slab(stream, bundle->data, 4), 0);
+
+  assert_true(zfp_stream_begin(stream, bundle->field));
+  /* slab not a multiple of four planes */
+  assert_int_equal(zfp_stream_append_slab(stream, bundle->data, 6), 0);
+  /* slab extends past field */
+  assert_int_equal(zfp_stream_append_slab(stream, bundle->data, NZ + 1), 0);
+  /* incomplete field */
+  assert_int_not_equal(zfp_stream_append_slab(stream, bundle->data, 4), 0);
+  assert_int_equal(zfp_stream_end(stream), 0);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(when_appendSlabs_expect_sameStreamAsCompress, setup, teardown),
+    cmocka_unit_test_setup_teardown(when_appendInvalidSlab_expect_zero, setup, teardown),
+  };
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
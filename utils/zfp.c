@@ -136,7 +136,7 @@ usage(void)
   fprintf(stderr, "      minexp : min bit plane # coded (-1074 for all bit planes)\n");
   fprintf(stderr, "Execution parameters:\n");
   fprintf(stderr, "  -x serial : serial compression (default)\n");
-  fprintf(stderr, "  -x omp[=threads[,chunk_size]] : OpenMP parallel compression\n");
+  fprintf(stderr, "  -x omp[=threads[,chunk_size]] : OpenMP parallel compression/decompression\n");
   fprintf(stderr, "  -x cuda : CUDA fixed rate parallel compression/decompression\n");
   fprintf(stderr, "Examples:\n");
   fprintf(stderr, "  -i file : read uncompressed file and compress to memory\n");
@@ -529,6 +529,9 @@ int main(int argc, char* argv[])
       fprintf(stderr, "invalid compression parameters\n");
       return EXIT_FAILURE;
     }
+    /* make room for extended header */
+    if (header)
+      bufsize += (ZFP_HEADER_EXT_MAX_BITS - ZFP_HEADER_MAX_BITS + 63) / 64 * 8;
     buffer = malloc(bufsize);
     if (!buffer) {
       fprintf(stderr, "cannot allocate memory\n");
@@ -543,8 +546,9 @@ int main(int argc, char* argv[])
     }
     zfp_stream_set_bit_stream(zfp, stream);
 
-    /* optionally write header */
-    if (header && !zfp_write_header(zfp, field, ZFP_HEADER_FULL)) {
+    /* optionally write header; use extended header for large arrays */
+    if (header && !zfp_write_header(zfp, field, ZFP_HEADER_FULL) &&
+                  !zfp_write_header(zfp, field, ZFP_HEADER_FULL | ZFP_HEADER_EXTENDED)) {
       fprintf(stderr, "cannot write header\n");
       return EXIT_FAILURE;
     }